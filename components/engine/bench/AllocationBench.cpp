@@ -0,0 +1,204 @@
+// bench/AllocationBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "results/ResultsStore.h"
+#include "risk/PortfolioRiskManager.h"
+#include "signals/SignalAggregation.h"
+#include "signals/SignalMatrix.h"
+#include "signals/WireProtocol.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+// --- Allocation counting ---
+// Replaces the global allocation functions of engine_bench. Counts are per
+// thread, so the logger's and the results store's threads do not show up in
+// the engine thread's count.
+namespace {
+    thread_local std::uint64_t t_allocations = 0;
+
+    void* counted_allocation(std::size_t size) {
+        ++t_allocations;
+        if (void* p = std::malloc(size == 0 ? 1 : size)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* counted_aligned_allocation(std::size_t size, std::align_val_t alignment) {
+        ++t_allocations;
+        const auto align = static_cast<std::size_t>(alignment);
+        if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return counted_allocation(size); }
+void* operator new[](std::size_t size) { return counted_allocation(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return counted_aligned_allocation(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return counted_aligned_allocation(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Serves the bars and notes the engine thread's allocation count once the
+    // loop is warm (`warmup` bars in) and again when the stream ends.
+    class AllocationProbe : public IDataProvider {
+    public:
+        AllocationProbe(SharedBarStore bars, std::size_t warmup) : m_inner(std::move(bars)), m_warmup(warmup) {}
+
+        std::optional<DataBar> get_next_bar() override {
+            if (m_served == m_warmup) {
+                m_at_warm = t_allocations;
+            }
+            auto bar = m_inner.get_next_bar();
+            if (bar) {
+                ++m_served;
+            } else {
+                m_at_end = t_allocations;
+            }
+            return bar;
+        }
+
+        // Allocations while the bars after the warm-up went through the loop.
+        std::uint64_t steady_state_allocations() const { return m_at_end - m_at_warm; }
+        std::size_t steady_state_bars() const { return m_served - m_warmup; }
+
+    private:
+        InMemoryBarProvider m_inner;
+        std::size_t m_warmup;
+        std::size_t m_served = 0;
+        std::uint64_t m_at_warm = 0;
+        std::uint64_t m_at_end = 0;
+    };
+
+    void expect_no_allocations(const std::string& label, std::uint64_t allocations, std::size_t bars) {
+        std::printf("%-60s %12zu bars %10llu allocations\n", label.c_str(), bars,
+                    static_cast<unsigned long long>(allocations));
+        if (allocations != 0) {
+            throw std::runtime_error(label + " allocated " + std::to_string(allocations) + " times in " +
+                                     std::to_string(bars) + " steady-state bars");
+        }
+    }
+
+    // A full backtest, optionally recording into a ResultsStore.
+    void check_backtest(const char* label, const SharedBarStore& bars, const SyntheticData& data,
+                        ResultsStore* results) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        auto probe = std::make_unique<AllocationProbe>(bars, bars->size() / 10);
+        const AllocationProbe& counts = *probe;
+        EventLoop event_loop(
+            std::move(probe),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+        if (results) {
+            event_loop.set_results_recorder(results->begin_run(label));
+        }
+        event_loop.run_backtest();
+
+        expect_no_allocations(std::string("EventLoop::run_backtest (") + label + ")",
+                              counts.steady_state_allocations(), counts.steady_state_bars());
+        const nlohmann::json bar_total = event_loop.get_metrics().to_json()["histograms"]["bar_total"];
+        std::printf("%-60s %10.2f us p50 %10.2f us p99 %10.2f us p99.9\n", "  bar_total",
+                    bar_total["p50_ns"].get<double>() / 1e3, bar_total["p99_ns"].get<double>() / 1e3,
+                    bar_total["p999_ns"].get<double>() / 1e3);
+    }
+
+    // What an IPC source does with the replies of one bar once they are off the
+    // socket: store every model's binary reply in a reused buffer, decode them
+    // into the signal matrix and aggregate it.
+    void check_signal_decoding(const SyntheticData& data, const DataBar& first_bar, std::size_t models,
+                               std::size_t bars) {
+        const SymbolRegistry& registry = *data.registry();
+        std::vector<std::string> replies(models);
+        for (std::size_t model = 0; model < models; ++model) {
+            std::vector<SignalPacket> packets;
+            for (std::size_t i = model; i < data.symbols().size(); i += 2) {
+                packets.emplace_back(data.symbols()[i], SignalType::Long, 0.05 + 0.01 * model, 0.5);
+            }
+            wire::encode_signals(packets, replies[model], wire::kFlagCausal);
+        }
+
+        ModelReplies stored(models);
+        SignalMatrix matrix;
+        WeightVector weights;
+        WeightedMeanAggregator mean;
+        MedianAggregator median;
+        TrimmedMeanAggregator trimmed(0.1);
+        DataBar bar = first_bar;
+        std::string binary_request;
+        std::string json_request;
+
+        std::uint64_t at_warm = 0;
+        for (std::size_t i = 0; i < bars; ++i) {
+            if (i == bars / 10) {
+                at_warm = t_allocations;
+            }
+            bar.close += 0.01;
+            wire::encode_market_data(bar, binary_request);
+            wire::encode_json_market_data(bar, json_request);
+            for (std::size_t model = 0; model < models; ++model) {
+                wire::store_reply(replies[model].data(), replies[model].size(), stored[model]);
+            }
+            matrix.load(stored, registry);
+            mean.aggregate(matrix, weights);
+            median.aggregate(matrix, weights);
+            trimmed.aggregate(matrix, weights);
+        }
+        expect_no_allocations("Request encoding, reply decoding, aggregation (" + std::to_string(models) + " models)",
+                              t_allocations - at_warm, bars - bars / 10);
+    }
+}
+
+// Steady-state heap allocations of the per-bar hot path, which must be zero, and its tail latency.
+void run_allocation_benchmarks(const BenchOptions& options) {
+    SyntheticSpec spec;
+    spec.bars_per_symbol = std::max<std::size_t>(20, options.bars / 10 / spec.symbols);
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+
+    check_backtest("no results store", bars, data, nullptr);
+    {
+        const fs::path database = fs::temp_directory_path() / "engine_bench_alloc.db";
+        fs::remove(database);
+        ResultsStore results(database.string());
+        check_backtest("results store", bars, data, &results);
+        results.flush();
+        fs::remove(database);
+    }
+    check_signal_decoding(data, bars->front(), options.models, 20000);
+
+    logger.flush();
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+}
@@ -0,0 +1,53 @@
+// bench/BenchHarness.h
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Options shared by every benchmark suite, parsed from the command line.
+ */
+struct BenchOptions {
+    std::size_t bars = 2'000'000;   // Bars per synthetic data set
+    std::size_t repetitions = 3;    // Best-of-N timing
+    std::vector<std::size_t> universe_sizes = {10, 100, 1000, 5000}; // Symbols, for the component suite
+    std::size_t models = 4;         // Fake models replying per bar
+};
+
+/**
+ * @brief Prevents the optimizer from discarding a computed value.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    volatile T sink = value;
+    (void)sink;
+}
+
+/**
+ * @brief Times `fn` `repetitions` times and prints the best items/sec.
+ * @param name Label printed in the result table.
+ * @param items Number of logical items (bars, orders, ...) processed per call.
+ * @param fn The workload. Called once per repetition.
+ * @return The best wall time in seconds.
+ */
+template <typename Fn>
+double run_bench(const std::string& name, std::size_t items, std::size_t repetitions, Fn&& fn) {
+    double best_seconds = 1e300;
+    for (std::size_t i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best_seconds) {
+            best_seconds = elapsed.count();
+        }
+    }
+
+    double items_per_sec = best_seconds > 0 ? items / best_seconds : 0.0;
+    std::printf("%-60s %12zu items %10.3f ms %14.0f items/s\n",
+                name.c_str(), items, best_seconds * 1e3, items_per_sec);
+    return best_seconds;
+}
@@ -0,0 +1,83 @@
+// bench/BenchMain.cpp
+
+#include "BenchHarness.h"
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Suites are defined in their own translation units.
+void run_data_reader_benchmarks(const BenchOptions& options);
+void run_wire_protocol_benchmarks(const BenchOptions& options);
+void run_portfolio_benchmarks(const BenchOptions& options);
+void run_logging_benchmarks(const BenchOptions& options);
+void run_component_benchmarks(const BenchOptions& options);
+void run_order_book_benchmarks(const BenchOptions& options);
+void run_results_benchmarks(const BenchOptions& options);
+void run_checkpoint_benchmarks(const BenchOptions& options);
+void run_live_benchmarks(const BenchOptions& options);
+void run_pipeline_benchmarks(const BenchOptions& options);
+void run_dispatch_benchmarks(const BenchOptions& options);
+void run_allocation_benchmarks(const BenchOptions& options);
+void run_signal_cache_benchmarks(const BenchOptions& options);
+
+namespace {
+    struct BenchSuite {
+        const char* name;
+        void (*run)(const BenchOptions&);
+    };
+
+    const BenchSuite kSuites[] = {
+        {"data", run_data_reader_benchmarks},
+        {"wire", run_wire_protocol_benchmarks},
+        {"portfolio", run_portfolio_benchmarks},
+        {"logging", run_logging_benchmarks},
+        {"components", run_component_benchmarks},
+        {"book", run_order_book_benchmarks},
+        {"results", run_results_benchmarks},
+        {"checkpoint", run_checkpoint_benchmarks},
+        {"live", run_live_benchmarks},
+        {"pipeline", run_pipeline_benchmarks},
+        {"dispatch", run_dispatch_benchmarks},
+        {"alloc", run_allocation_benchmarks},
+        {"cache", run_signal_cache_benchmarks},
+    };
+}
+
+// Usage: engine_bench [suite] [--bars N] [--reps N] [--symbols N[,N...]] [--models K]
+int main(int argc, char** argv) {
+    BenchOptions options;
+    std::string filter;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bars") == 0 && i + 1 < argc) {
+            options.bars = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            options.repetitions = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--symbols") == 0 && i + 1 < argc) {
+            options.universe_sizes.clear();
+            std::stringstream sizes(argv[++i]);
+            for (std::string size; std::getline(sizes, size, ',');) {
+                options.universe_sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+            }
+        } else if (std::strcmp(argv[i], "--models") == 0 && i + 1 < argc) {
+            options.models = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    try {
+        for (const auto& suite : kSuites) {
+            if (filter.empty() || filter == suite.name) {
+                std::cout << "=== " << suite.name << " ===" << std::endl;
+                suite.run(options);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// bench/CheckpointBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "data/MergedBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "risk/PortfolioRiskManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    using ProviderFactory = std::function<std::unique_ptr<IDataProvider>()>;
+
+    // Every stateful component: rotating targets, volatility rules on the covariance.
+    std::unique_ptr<EventLoop> make_event_loop(std::unique_ptr<IDataProvider> provider, const SyntheticData& data) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        return std::make_unique<EventLoop>(
+            std::move(provider),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+}
+
+// Capture cost, checkpointing overhead on the bar loop, and restart time.
+// tests/CheckpointTest.cpp checks that a resumed run ends exactly where an uninterrupted one does.
+void run_checkpoint_benchmarks(const BenchOptions& options) {
+    const fs::path directory = fs::temp_directory_path() / "engine_bench_checkpoint";
+    const fs::path checkpoint_path = fs::temp_directory_path() / "engine_bench.ckpt";
+
+    SyntheticSpec spec;
+    spec.bars_per_symbol = std::max<std::size_t>(2, options.bars / 10 / spec.symbols);
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+    data.write_symbol_files(directory, *bars);
+
+    const ProviderFactory in_memory = [&] { return std::make_unique<InMemoryBarProvider>(bars); };
+    const ProviderFactory merged = [&] {
+        return std::make_unique<MergedBarProvider>(directory.string(), 4096, data.registry());
+    };
+
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+
+    const std::uint64_t every = 10000;
+    run_bench("EventLoop::run_backtest (no checkpoints)", bars->size(), options.repetitions, [&] {
+        make_event_loop(in_memory(), data)->run_backtest();
+    });
+    run_bench("EventLoop::run_backtest (checkpoint every " + std::to_string(every) + " bars)", bars->size(),
+              options.repetitions, [&] {
+        auto event_loop = make_event_loop(in_memory(), data);
+        event_loop->enable_checkpoints(checkpoint_path.string(), every);
+        event_loop->run_backtest();
+    });
+
+    // The part the bar loop pays for: serializing into the reused buffer
+    auto finished = make_event_loop(in_memory(), data);
+    finished->run_backtest();
+    std::vector<std::uint8_t> snapshot;
+    const std::size_t captures = 1000;
+    run_bench("EventLoop::save_state (in-memory capture)", captures, options.repetitions, [&] {
+        for (std::size_t i = 0; i < captures; ++i) {
+            snapshot.clear();
+            finished->save_state(snapshot);
+        }
+    });
+    std::printf("%-60s %12zu bytes per snapshot\n", "", snapshot.size());
+
+    // A checkpoint part way through the files, to restart from
+    auto checkpointed = make_event_loop(merged(), data);
+    checkpointed->enable_checkpoints(checkpoint_path.string(), std::max<std::uint64_t>(1, bars->size() / 2));
+    checkpointed->run_backtest();
+
+    run_bench("EventLoop::restore_checkpoint (files reopened, seek)", 1, options.repetitions, [&] {
+        make_event_loop(merged(), data)->restore_checkpoint(checkpoint_path.string());
+    });
+
+    logger.flush();
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+
+    fs::remove(checkpoint_path);
+    fs::remove_all(directory);
+}
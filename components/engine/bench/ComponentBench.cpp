@@ -0,0 +1,437 @@
+// bench/ComponentBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "core/Portfolio.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "risk/EwmaCovariance.h"
+#include "risk/PortfolioRiskManager.h"
+#include "signals/SignalAggregation.h"
+#include "signals/WireProtocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    // Drives random ticks and fills through a portfolio that never revalues on
+    // its own, then checks its incrementally kept value against a full re-sum.
+    void check_incremental_valuation(SyntheticData& data) {
+        const std::size_t symbols = data.symbols().size();
+        Portfolio portfolio(1e6, data.registry());
+        portfolio.set_revalue_interval(0);
+
+        PriceVector prices = data.prices();
+        std::mt19937_64 rng(7);
+        std::normal_distribution<double> price_step(0.0, 0.01);
+        std::uniform_int_distribution<long long> fill_size(-500, 500);
+
+        constexpr std::size_t kEvents = 200'000;
+        for (std::size_t i = 0; i < kEvents; ++i) {
+            const auto id = static_cast<SymbolId>(rng() % symbols);
+            if (i % 4 == 0) {
+                const long long shares = fill_size(rng);
+                portfolio.update_holding(id, shares);
+                portfolio.update_cash(-static_cast<double>(shares) * prices[id]);
+            } else {
+                prices[id] *= 1.0 + price_step(rng);
+                portfolio.mark_price(id, prices[id]);
+            }
+        }
+
+        const double incremental = portfolio.get_total_value();
+        portfolio.recalculate_total_value(prices);
+        const double full = portfolio.get_total_value();
+        const double relative_error = std::abs(incremental - full) / std::max(1.0, std::abs(full));
+
+        std::printf("%-60s %12zu events  relative error %.3g\n",
+                    ("Incremental vs full valuation, N=" + std::to_string(symbols)).c_str(),
+                    kEvents, relative_error);
+        if (relative_error > 1e-9) {
+            throw std::runtime_error("Incremental mark-to-market drifted from the full recompute");
+        }
+    }
+
+    // The matrix loaded from binary replies must equal the one loaded from packets, cell for cell.
+    void check_wire_load(const ModelSignals& signals, const ModelReplies& replies, const SymbolRegistry& registry) {
+        SignalMatrix from_packets;
+        SignalMatrix from_wire;
+        from_packets.load(signals, registry);
+        from_wire.load(replies, registry);
+        for (std::size_t model = 0; model < signals.size(); ++model) {
+            if (!std::equal(from_packets.weights(model), from_packets.weights(model) + registry.size(), from_wire.weights(model)) ||
+                !std::equal(from_packets.confidences(model), from_packets.confidences(model) + registry.size(),
+                            from_wire.confidences(model))) {
+                throw std::runtime_error("SignalMatrix loaded from binary replies differs from the packet load");
+            }
+        }
+    }
+
+    // Checks the matrix aggregators against straightforward per-symbol
+    // implementations: the map-based mean and a full sort for the median.
+    void check_aggregation(const ModelSignals& signals, const SymbolRegistry& registry) {
+        std::vector<SignalPacket> packets;
+        for (const auto& model_packets : signals) {
+            packets.insert(packets.end(), model_packets.begin(), model_packets.end());
+        }
+        const auto reference_mean = aggregate_signals(packets);
+
+        SignalMatrix matrix;
+        matrix.load(signals, registry);
+        WeightedMeanAggregator mean;
+        MedianAggregator median;
+        WeightVector mean_weights;
+        WeightVector median_weights;
+        mean.aggregate(matrix, mean_weights);
+        median.aggregate(matrix, median_weights);
+
+        std::vector<std::vector<double>> columns(registry.size());
+        for (const auto& packet : packets) {
+            if (packet.confidence > 0.0) {
+                columns[registry.find(packet.symbol)].push_back(packet.target_weight);
+            }
+        }
+
+        double max_error = 0.0;
+        for (SymbolId id = 0; id < registry.size(); ++id) {
+            const auto it = reference_mean.find(registry.name(id));
+            max_error = std::max(max_error, std::abs(mean_weights[id] - (it != reference_mean.end() ? it->second : 0.0)));
+
+            std::vector<double>& column = columns[id];
+            if (!column.empty()) {
+                std::sort(column.begin(), column.end());
+                const std::size_t half = column.size() / 2;
+                const double expected = column.size() % 2 ? column[half] : 0.5 * (column[half - 1] + column[half]);
+                max_error = std::max(max_error, std::abs(median_weights[id] - expected));
+            }
+        }
+
+        std::printf("%-60s %12zu symbols max abs error %.3g\n",
+                    ("Matrix vs reference aggregation, N=" + std::to_string(registry.size())).c_str(),
+                    registry.size(), max_error);
+        if (max_error > 1e-12) {
+            throw std::runtime_error("Matrix aggregation disagrees with the reference implementation");
+        }
+    }
+
+    // The covariance matrix is symbols^2 doubles: 8 MB at 1000 symbols, 200 MB at 5000
+    constexpr std::size_t kMaxCovarianceSymbols = 2000;
+
+    // Checks the incremental EWMA covariance and its quadratic form against a
+    // direct weighted sum over the whole return history.
+    void check_covariance(std::size_t symbols) {
+        constexpr double kDecay = 0.94;
+        constexpr std::size_t kPeriods = 500;
+        std::mt19937_64 rng(3);
+        std::normal_distribution<double> daily_return(0.0, 0.02);
+        std::bernoulli_distribution traded(0.8);
+
+        EwmaCovariance covariance(kDecay);
+        covariance.resize(symbols);
+        std::vector<std::vector<double>> history(kPeriods, std::vector<double>(symbols, 0.0));
+        for (auto& returns : history) {
+            for (double& value : returns) {
+                value = traded(rng) ? daily_return(rng) : 0.0; // Some symbols do not trade every period
+            }
+            covariance.update(returns);
+        }
+
+        std::vector<double> weights(symbols);
+        for (double& weight : weights) {
+            weight = daily_return(rng);
+        }
+
+        double max_error = 0.0;
+        double expected_variance = 0.0;
+        for (std::size_t i = 0; i < symbols; ++i) {
+            for (std::size_t j = 0; j < symbols; ++j) {
+                double expected = 0.0;
+                double weight = 1.0 - kDecay;
+                for (std::size_t t = kPeriods; t-- > 0;) {
+                    expected += weight * history[t][i] * history[t][j];
+                    weight *= kDecay;
+                }
+                max_error = std::max(max_error, std::abs(covariance.covariance(i, j) - expected) / 4e-4);
+                expected_variance += weights[i] * expected * weights[j];
+            }
+        }
+        // The second call reuses C w from the first and only adds the changed rows
+        std::vector<double> shifted = weights;
+        for (std::size_t i = 0; i < symbols; i += 7) {
+            shifted[i] *= 2.0;
+        }
+        (void)covariance.portfolio_variance(shifted);
+        const double variance = covariance.portfolio_variance(weights);
+        max_error = std::max(max_error, std::abs(variance - expected_variance) / expected_variance);
+
+        std::printf("%-60s %12zu periods  relative error %.3g\n",
+                    ("Incremental vs direct EWMA covariance, N=" + std::to_string(symbols)).c_str(),
+                    kPeriods, max_error);
+        if (max_error > 1e-9) {
+            throw std::runtime_error("Incremental EWMA covariance disagrees with the direct sum");
+        }
+    }
+
+    // Per-bar cost of each hot-path component, for one universe size.
+    void bench_universe(const BenchOptions& options, std::size_t symbols) {
+        SyntheticData data({symbols, 1, options.models});
+        const auto& registry = data.registry();
+
+        // Keep the work per benchmark roughly constant across universe sizes
+        const std::size_t calls = std::max<std::size_t>(16, options.bars / (10 * symbols));
+        const std::string suffix = ", N=" + std::to_string(symbols);
+
+        // --- Signal aggregation (K models x N symbols packets per bar) ---
+        const ModelSignals signals = data.model_signals();
+        const std::string aggregation_suffix = suffix + " K=" + std::to_string(options.models);
+
+        std::vector<SignalPacket> packets;
+        for (const auto& model_packets : signals) {
+            packets.insert(packets.end(), model_packets.begin(), model_packets.end());
+        }
+        run_bench("aggregate_signals (map, reference)" + aggregation_suffix, calls, options.repetitions, [&] {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                total += aggregate_signals(packets).size();
+            }
+            do_not_optimize(total);
+        });
+
+        SignalMatrix matrix;
+        run_bench("SignalMatrix::load (packets)" + aggregation_suffix, calls, options.repetitions, [&] {
+            for (std::size_t i = 0; i < calls; ++i) {
+                matrix.load(signals, *registry);
+            }
+            do_not_optimize(matrix.confidences(0)[0]);
+        });
+
+        // What the IPC sources do per bar: keep each binary reply and decode it into the rows
+        std::vector<std::string> encoded(signals.size());
+        for (std::size_t model = 0; model < signals.size(); ++model) {
+            wire::encode_signals(signals[model], encoded[model]);
+        }
+        ModelReplies replies(signals.size());
+        run_bench("store_reply + SignalMatrix::load (wire)" + aggregation_suffix, calls, options.repetitions, [&] {
+            for (std::size_t i = 0; i < calls; ++i) {
+                for (std::size_t model = 0; model < encoded.size(); ++model) {
+                    wire::store_reply(encoded[model].data(), encoded[model].size(), replies[model]);
+                }
+                matrix.load(replies, *registry);
+            }
+            do_not_optimize(matrix.confidences(0)[0]);
+        });
+        check_wire_load(signals, replies, *registry);
+
+        WeightedMeanAggregator mean;
+        MedianAggregator median;
+        TrimmedMeanAggregator trimmed_mean(0.1);
+        const std::pair<const char*, ISignalAggregator*> aggregators[] = {
+            {"WeightedMeanAggregator", &mean},
+            {"MedianAggregator", &median},
+            {"TrimmedMeanAggregator (10%)", &trimmed_mean},
+        };
+        for (const auto& [name, aggregator] : aggregators) {
+            run_bench(name + aggregation_suffix, calls, options.repetitions, [&] {
+                WeightVector weights;
+                double total = 0.0;
+                for (std::size_t i = 0; i < calls; ++i) {
+                    aggregator->aggregate(matrix, weights);
+                    total += weights.front();
+                }
+                do_not_optimize(total);
+            });
+        }
+
+        // Every fifth model misses the deadline: its row is skipped, not cleared
+        ModelSignals partial_signals = signals;
+        for (std::size_t model = 0; model < partial_signals.size(); model += 5) {
+            partial_signals[model].clear();
+        }
+        SignalMatrix partial_matrix;
+        partial_matrix.load(partial_signals, *registry);
+        run_bench("WeightedMeanAggregator, 1 in 5 silent" + aggregation_suffix, calls, options.repetitions, [&] {
+            WeightVector weights;
+            double total = 0.0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                mean.aggregate(partial_matrix, weights);
+                total += weights.front();
+            }
+            do_not_optimize(total);
+        });
+
+        check_aggregation(partial_signals, *registry);
+
+        // --- Risk validation ---
+        PortfolioRiskManager risk_manager(0.25, 1.0, 0.20);
+        Portfolio flat_portfolio(1e6, registry);
+        const auto target_portfolio = data.target_portfolio();
+        const WeightVector target_weights = data.target_weights();
+
+        run_bench("PortfolioRiskManager::validate_target" + suffix, calls, options.repetitions, [&] {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                total += risk_manager.validate_target(flat_portfolio, 1e6, target_portfolio).size();
+            }
+            do_not_optimize(total);
+        });
+
+        run_bench("PortfolioRiskManager::validate_target_weights" + suffix, calls, options.repetitions, [&] {
+            WeightVector weights;
+            double total = 0.0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                weights = target_weights; // Validated in place
+                risk_manager.validate_target_weights(flat_portfolio, 1e6, *registry, weights);
+                total += weights.front();
+            }
+            do_not_optimize(total);
+        });
+
+        const PriceVector prices = data.prices();
+
+        // --- Covariance-aware risk: one rank-1 update per period, one quadratic form per bar ---
+        if (symbols <= kMaxCovarianceSymbols) {
+            std::mt19937_64 rng(11);
+            std::normal_distribution<double> daily_return(0.0, 0.01);
+            std::vector<std::vector<double>> period_returns(16, std::vector<double>(symbols));
+            for (auto& returns : period_returns) {
+                for (double& value : returns) {
+                    value = daily_return(rng);
+                }
+            }
+
+            EwmaCovariance covariance(0.94);
+            covariance.resize(symbols);
+            run_bench("EwmaCovariance::update" + suffix, calls, options.repetitions, [&] {
+                for (std::size_t i = 0; i < calls; ++i) {
+                    covariance.update(period_returns[i % period_returns.size()]);
+                }
+                do_not_optimize(covariance.covariance(0, 0));
+            });
+
+            // Worst case: every weight changes between calls, so C w is rebuilt each time
+            const WeightVector alternate_weights[] = {data.target_weights(), data.target_weights()};
+            run_bench("EwmaCovariance::portfolio_variance (all changed)" + suffix, calls, options.repetitions, [&] {
+                double total = 0.0;
+                for (std::size_t i = 0; i < calls; ++i) {
+                    total += covariance.portfolio_variance(alternate_weights[i & 1]);
+                }
+                do_not_optimize(total);
+            });
+
+            // Typical within one timestamp: only the ticking symbol's target moves
+            WeightVector moving_weights = target_weights;
+            run_bench("EwmaCovariance::portfolio_variance (one changed)" + suffix, calls, options.repetitions, [&] {
+                double total = 0.0;
+                for (std::size_t i = 0; i < calls; ++i) {
+                    moving_weights[i % symbols] *= 1.0001;
+                    total += covariance.portfolio_variance(moving_weights);
+                }
+                do_not_optimize(total);
+            });
+
+            VolatilityLimits limits;
+            limits.target_volatility = 0.10;
+            limits.min_observations = 0;
+            PortfolioRiskManager volatility_manager(0.25, 1.0, 0.20, limits);
+            const auto start = std::chrono::system_clock::time_point{};
+            for (std::size_t period = 0; period < 3; ++period) {
+                for (SymbolId id = 0; id < symbols; ++id) {
+                    const double close = prices[id] * std::exp(period_returns[period][id]);
+                    volatility_manager.on_market_bar(id, DataBar(data.symbols()[id], start + std::chrono::hours(24 * period),
+                                                                 close, close, close, close, 0, id));
+                }
+            }
+            run_bench("PortfolioRiskManager::validate_target_weights+vol" + suffix, calls, options.repetitions, [&] {
+                WeightVector weights;
+                double total = 0.0;
+                for (std::size_t i = 0; i < calls; ++i) {
+                    weights = target_weights;
+                    volatility_manager.validate_target_weights(flat_portfolio, 1e6, *registry, weights);
+                    total += weights.front();
+                }
+                do_not_optimize(total);
+            });
+
+            check_covariance(std::min<std::size_t>(symbols, 64));
+        }
+
+        // --- Execution: alternate between two targets so every call trades ---
+        BacktestExecutionHandler execution_handler(1.0, 0.0005);
+        std::map<std::string, double> price_map;
+        for (std::size_t i = 0; i < symbols; ++i) {
+            price_map.emplace(data.symbols()[i], prices[i]);
+        }
+        const std::map<std::string, double> targets[] = {data.target_portfolio(), data.target_portfolio()};
+        const WeightVector weight_targets[] = {data.target_weights(), data.target_weights()};
+
+        run_bench("BacktestExecutionHandler::execute_trades" + suffix, calls, options.repetitions, [&] {
+            Portfolio portfolio(1e6, registry);
+            for (std::size_t i = 0; i < calls; ++i) {
+                execution_handler.execute_trades(portfolio, targets[i & 1], price_map);
+            }
+            do_not_optimize(portfolio.get_cash());
+        });
+
+        run_bench("BacktestExecutionHandler::execute_target_weights" + suffix, calls, options.repetitions, [&] {
+            Portfolio portfolio(1e6, registry);
+            for (std::size_t i = 0; i < calls; ++i) {
+                execution_handler.execute_target_weights(portfolio, *registry, weight_targets[i & 1], prices);
+            }
+            do_not_optimize(portfolio.get_cash());
+        });
+
+        // --- Mark-to-market with a position in every symbol ---
+        Portfolio invested(1e6, registry);
+        execution_handler.execute_target_weights(invested, *registry, weight_targets[0], prices);
+
+        run_bench("Portfolio::recalculate_total_value (map)" + suffix, calls, options.repetitions, [&] {
+            double total = 0.0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                invested.recalculate_total_value(price_map);
+                total += invested.get_total_value();
+            }
+            do_not_optimize(total);
+        });
+
+        run_bench("Portfolio::recalculate_total_value (dense)" + suffix, calls, options.repetitions, [&] {
+            double total = 0.0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                invested.recalculate_total_value(prices);
+                total += invested.get_total_value();
+            }
+            do_not_optimize(total);
+        });
+
+        // One symbol ticks per bar, as in the EventLoop
+        run_bench("Portfolio::mark_price (incremental)" + suffix, calls, options.repetitions, [&] {
+            double total = 0.0;
+            for (std::size_t i = 0; i < calls; ++i) {
+                const auto id = static_cast<SymbolId>(i % symbols);
+                invested.mark_price(id, prices[id] * (1.0 + 1e-4 * static_cast<double>(i & 7)));
+                total += invested.get_total_value();
+            }
+            do_not_optimize(total);
+        });
+
+        check_incremental_valuation(data);
+    }
+}
+
+// Hot-path components on synthetic data at several universe sizes. One item = one bar.
+void run_component_benchmarks(const BenchOptions& options) {
+    // The risk manager warns on every scaled position; keep that out of the timings
+    auto& logger = logging::Logger::instance();
+    logger.set_min_level(logging::Level::Error);
+
+    for (std::size_t symbols : options.universe_sizes) {
+        if (symbols > 0) {
+            bench_universe(options, symbols);
+        }
+    }
+
+    logger.set_min_level(logging::Level::Debug);
+}
@@ -0,0 +1,339 @@
+// bench/DataReaderBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "data/BinFileReader.h"
+#include "data/BincodeBarReader.h"
+#include "data/ColumnarBarReader.h"
+#include "data/ColumnarBarWriter.h"
+#include "data/MmapBarReader.h"
+#include "data/MergedBarProvider.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    bool same_bar(const DataBarRecord& a, const DataBarRecord& b) {
+        return std::memcmp(&a, &b, sizeof(DataBarRecord)) == 0; // Bit-exact, symbol included
+    }
+
+    // Decoding the .cbar file must give back the source records bit for bit.
+    void check_columnar_round_trip(const std::vector<DataBarRecord>& expected, const std::filesystem::path& path) {
+        ColumnarBarReader reader(path.string());
+        std::size_t i = 0;
+        for (auto batch = reader.next_batch(4096); !batch.empty(); batch = reader.next_batch(4096)) {
+            for (const DataBarRecord& record : batch) {
+                if (i >= expected.size() || !same_bar(record, expected[i])) {
+                    throw std::runtime_error("ColumnarBarReader disagrees with the source at bar " + std::to_string(i));
+                }
+                ++i;
+            }
+        }
+        if (i != expected.size()) {
+            throw std::runtime_error("ColumnarBarReader returned " + std::to_string(i) + " of "
+                                     + std::to_string(expected.size()) + " bars");
+        }
+    }
+
+    // A flipped payload byte must fail the block checksum instead of decoding to wrong bars.
+    void check_corruption_detected(const std::filesystem::path& path) {
+        const auto corrupt = std::filesystem::path(path).replace_extension(".corrupt.cbar");
+        std::filesystem::copy_file(path, corrupt, std::filesystem::copy_options::overwrite_existing);
+        {
+            std::fstream file(corrupt, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(sizeof(ColumnarFileHeader) + 100));
+            file.put('\x5A');
+        }
+        bool detected = false;
+        try {
+            ColumnarBarReader reader(corrupt.string());
+            while (reader.next_record()) {
+            }
+        } catch (const std::runtime_error&) {
+            detected = true;
+        }
+        std::filesystem::remove(corrupt);
+        if (!detected) {
+            throw std::runtime_error("ColumnarBarReader decoded a corrupted block without an error");
+        }
+    }
+
+    // Every reader must land on the first bar at or after the requested time.
+    void check_seek(const std::vector<DataBarRecord>& expected, const std::filesystem::path& bin_path,
+                    const std::filesystem::path& columnar_path) {
+        MmapBarReader mmap_reader(bin_path.string());
+        ColumnarBarReader columnar_reader(columnar_path.string());
+        const std::uint64_t first = expected.front().timestamp_epoch_ns;
+        const std::uint64_t last = expected.back().timestamp_epoch_ns;
+
+        std::vector<std::uint64_t> targets = {0, first, last, last + 1};
+        for (std::size_t i = 0; i < 200; ++i) {
+            const std::uint64_t at = first + (last - first) / 200 * i;
+            targets.push_back(at);
+            targets.push_back(at + 1); // Between bars
+        }
+
+        for (const std::uint64_t target : targets) {
+            const auto it = std::partition_point(expected.begin(), expected.end(),
+                [target](const DataBarRecord& record) { return record.timestamp_epoch_ns < target; });
+            const DataBarRecord* want = it == expected.end() ? nullptr : &*it;
+
+            mmap_reader.seek(target);
+            columnar_reader.seek(target);
+            BinFileReader file_reader(bin_path.string(), TimeRange{target});
+            const DataBarRecord* got_mmap = mmap_reader.next_record();
+            const DataBarRecord* got_columnar = columnar_reader.next_record();
+            const auto got_file = file_reader.get_next_bar();
+
+            const bool ok = want
+                ? (got_mmap && same_bar(*got_mmap, *want) && got_columnar && same_bar(*got_columnar, *want)
+                   && got_file && TimeRange::to_epoch_ns(got_file->timestamp) == want->timestamp_epoch_ns
+                   && columnar_reader.position() == static_cast<std::size_t>(it - expected.begin()) + 1)
+                : (!got_mmap && !got_columnar && !got_file);
+            if (!ok) {
+                throw std::runtime_error("seek(" + std::to_string(target) + ") did not land on the first bar at or after it");
+            }
+        }
+    }
+
+    void print_size(const char* label, const std::filesystem::path& path, std::size_t bars) {
+        const auto bytes = std::filesystem::file_size(path);
+        std::printf("%-60s %12ju bytes %10.2f bytes/bar\n", label, static_cast<std::uintmax_t>(bytes),
+                    static_cast<double>(bytes) / static_cast<double>(bars));
+    }
+}
+
+void run_data_reader_benchmarks(const BenchOptions& options) {
+    const auto path = std::filesystem::temp_directory_path() / "engine_bench_bars.bin";
+    SyntheticData::write_bar_file(path, "SYNTH", options.bars);
+
+    run_bench("BinFileReader::get_next_bar", options.bars, options.repetitions, [&] {
+        BinFileReader reader(path.string());
+        double sum = 0.0;
+        while (auto bar = reader.get_next_bar()) {
+            sum += bar->close;
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("MmapBarReader::get_next_bar", options.bars, options.repetitions, [&] {
+        MmapBarReader reader(path.string());
+        double sum = 0.0;
+        while (auto bar = reader.get_next_bar()) {
+            sum += bar->close;
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("MmapBarReader::next_record", options.bars, options.repetitions, [&] {
+        MmapBarReader reader(path.string());
+        double sum = 0.0;
+        while (const DataBarRecord* record = reader.next_record()) {
+            sum += record->close;
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("MmapBarReader::next_batch(4096)", options.bars, options.repetitions, [&] {
+        MmapBarReader reader(path.string());
+        double sum = 0.0;
+        for (auto batch = reader.next_batch(4096); !batch.empty(); batch = reader.next_batch(4096)) {
+            for (const auto& record : batch) {
+                sum += record.close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    // --- Compressed columnar format ---
+    const auto columnar_path = std::filesystem::temp_directory_path() / "engine_bench_bars.cbar";
+    run_bench("ColumnarBarWriter::append (.bin -> .cbar)", options.bars, options.repetitions, [&] {
+        MmapBarReader reader(path.string());
+        ColumnarBarWriter writer(columnar_path.string(), "SYNTH");
+        while (const DataBarRecord* record = reader.next_record()) {
+            writer.append(*record);
+        }
+        writer.finish();
+    });
+    print_size("  .bin (64-byte records)", path, options.bars);
+    print_size("  .cbar", columnar_path, options.bars);
+
+    {
+        MmapBarReader source(path.string());
+        const std::vector<DataBarRecord> expected(source.records().begin(), source.records().end());
+        check_columnar_round_trip(expected, columnar_path);
+    }
+    check_corruption_detected(columnar_path);
+
+    run_bench("ColumnarBarReader::get_next_bar", options.bars, options.repetitions, [&] {
+        ColumnarBarReader reader(columnar_path.string());
+        double sum = 0.0;
+        while (auto bar = reader.get_next_bar()) {
+            sum += bar->close;
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("ColumnarBarReader::next_batch(4096)", options.bars, options.repetitions, [&] {
+        ColumnarBarReader reader(columnar_path.string());
+        double sum = 0.0;
+        for (auto batch = reader.next_batch(4096); !batch.empty(); batch = reader.next_batch(4096)) {
+            for (const auto& record : batch) {
+                sum += record.close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    // --- Time-range seeks: a walk-forward study opens one reader per window ---
+    {
+        MmapBarReader source(path.string());
+        const std::vector<DataBarRecord> expected(source.records().begin(), source.records().end());
+        check_seek(expected, path, columnar_path);
+    }
+
+    constexpr std::size_t kWindows = 1000;
+    const std::uint64_t first_ns = 1'700'000'000'000'000'000ULL;
+    const std::uint64_t span_ns = options.bars * 60'000'000'000ULL; // As written by write_bar_file
+    auto window_start = [&](std::size_t window) { return first_ns + span_ns / kWindows * window; };
+
+    run_bench("MmapBarReader open+seek (1000 windows)", kWindows, options.repetitions, [&] {
+        double sum = 0.0;
+        for (std::size_t w = 0; w < kWindows; ++w) {
+            MmapBarReader reader(path.string());
+            reader.seek(window_start(w));
+            if (const DataBarRecord* record = reader.next_record()) {
+                sum += record->close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("ColumnarBarReader open+seek (1000 windows)", kWindows, options.repetitions, [&] {
+        double sum = 0.0;
+        for (std::size_t w = 0; w < kWindows; ++w) {
+            ColumnarBarReader reader(columnar_path.string());
+            reader.seek(window_start(w));
+            if (const DataBarRecord* record = reader.next_record()) {
+                sum += record->close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("BinFileReader open+seek (1000 windows)", kWindows, options.repetitions, [&] {
+        double sum = 0.0;
+        for (std::size_t w = 0; w < kWindows; ++w) {
+            BinFileReader reader(path.string(), TimeRange{window_start(w)});
+            if (auto bar = reader.get_next_bar()) {
+                sum += bar->close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    // The old way: read the prefix up to the window start
+    constexpr std::size_t kScannedWindows = 10;
+    run_bench("BinFileReader open+scan to start (10 windows)", kScannedWindows, options.repetitions, [&] {
+        double sum = 0.0;
+        for (std::size_t w = 0; w < kScannedWindows; ++w) {
+            BinFileReader reader(path.string());
+            const auto start = record_timestamp(DataBarRecord{{}, window_start(w * (kWindows / kScannedWindows)), 0, 0, 0, 0, 0});
+            while (auto bar = reader.get_next_bar()) {
+                if (bar->timestamp >= start) {
+                    sum += bar->close;
+                    break;
+                }
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    std::filesystem::remove(path);
+
+    // The fetcher's bincode output, converted the way bar_converter does
+    const auto bincode_path = std::filesystem::temp_directory_path() / "engine_bench_fetcher.bin";
+    SyntheticData::write_bincode_file(bincode_path, options.bars);
+    run_bench("BincodeBarReader -> ColumnarBarWriter", options.bars, options.repetitions, [&] {
+        BincodeBarReader reader(bincode_path.string(), "SYNTH");
+        ColumnarBarWriter writer(columnar_path.string(), "SYNTH");
+        while (const DataBarRecord* record = reader.next_record()) {
+            writer.append(*record);
+        }
+        writer.finish();
+    });
+    print_size("  fetcher bincode", bincode_path, options.bars);
+    print_size("  .cbar", columnar_path, options.bars);
+    {
+        BincodeBarReader source(bincode_path.string(), "SYNTH");
+        std::vector<DataBarRecord> expected;
+        while (const DataBarRecord* record = source.next_record()) {
+            expected.push_back(*record);
+        }
+        check_columnar_round_trip(expected, columnar_path);
+    }
+    std::filesystem::remove(bincode_path);
+    std::filesystem::remove(columnar_path);
+
+    // Same total bar count, spread over several per-symbol files.
+    constexpr std::size_t kSymbols = 16;
+    const auto directory = std::filesystem::temp_directory_path() / "engine_bench_universe";
+    std::filesystem::create_directories(directory);
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        SyntheticData::write_bar_file(directory / ("SYM" + std::to_string(i) + ".bin"),
+                             "SYM" + std::to_string(i), options.bars / kSymbols);
+    }
+
+    run_bench("MergedBarProvider::get_next_bar (16 files)", options.bars / kSymbols * kSymbols,
+              options.repetitions, [&] {
+        MergedBarProvider provider(directory.string());
+        double sum = 0.0;
+        while (auto bar = provider.get_next_bar()) {
+            sum += bar->close;
+        }
+        do_not_optimize(sum);
+    });
+
+    // The last tenth of the data, merged from all 16 files
+    const std::uint64_t bars_per_file = options.bars / kSymbols;
+    const TimeRange last_tenth{first_ns + bars_per_file * 9 / 10 * 60'000'000'000ULL};
+    std::size_t window_bars = 0;
+    run_bench("MergedBarProvider last 10% window (16 files)", kSymbols * (bars_per_file - bars_per_file * 9 / 10),
+              options.repetitions, [&] {
+        MergedBarProvider provider(directory.string(), 4096, nullptr, last_tenth);
+        window_bars = 0;
+        while (auto bar = provider.get_next_bar()) {
+            ++window_bars;
+        }
+    });
+    if (window_bars != kSymbols * (bars_per_file - bars_per_file * 9 / 10)) {
+        throw std::runtime_error("MergedBarProvider returned " + std::to_string(window_bars) + " bars for the window");
+    }
+
+    // The same files compressed
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        const auto bin = directory / ("SYM" + std::to_string(i) + ".bin");
+        MmapBarReader reader(bin.string());
+        ColumnarBarWriter writer((directory / ("SYM" + std::to_string(i) + ".cbar")).string(), "SYM" + std::to_string(i));
+        while (const DataBarRecord* record = reader.next_record()) {
+            writer.append(*record);
+        }
+        writer.finish();
+    }
+
+    run_bench("MergedBarProvider::get_next_bar (16 .cbar files)", options.bars / kSymbols * kSymbols,
+              options.repetitions, [&] {
+        MergedBarProvider provider(directory.string()); // Prefers .cbar over .bin
+        double sum = 0.0;
+        while (auto bar = provider.get_next_bar()) {
+            sum += bar->close;
+        }
+        do_not_optimize(sum);
+    });
+
+    std::filesystem::remove_all(directory);
+}
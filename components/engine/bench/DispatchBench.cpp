@@ -0,0 +1,72 @@
+// bench/DispatchBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "risk/PortfolioRiskManager.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // The same components, named by their concrete (final) types
+    using StaticEventLoop =
+        BasicEventLoop<InMemoryBarProvider, RotatingSignalSource, PortfolioRiskManager, BacktestExecutionHandler>;
+
+    template <typename Loop>
+    std::unique_ptr<Loop> make_event_loop(const SharedBarStore& bars, const SyntheticData& data) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        return std::make_unique<Loop>(
+            std::make_unique<InMemoryBarProvider>(bars),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+
+    template <typename Loop>
+    std::string outcome(const Loop& event_loop) {
+        return std::to_string(event_loop.get_portfolio().get_total_value()) + " " +
+               std::to_string(event_loop.get_peak_portfolio_value()) + " " +
+               event_loop.get_performance().to_json().dump();
+    }
+}
+
+// Virtual dispatch (EventLoop) against static dispatch (BasicEventLoop over concrete types).
+void run_dispatch_benchmarks(const BenchOptions& options) {
+    SyntheticSpec spec;
+    spec.bars_per_symbol = std::max<std::size_t>(2, options.bars / 10 / spec.symbols);
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+
+    auto virtual_loop = make_event_loop<EventLoop>(bars, data);
+    virtual_loop->run_backtest();
+    auto static_loop = make_event_loop<StaticEventLoop>(bars, data);
+    static_loop->run_backtest();
+    if (outcome(*virtual_loop) != outcome(*static_loop)) {
+        throw std::runtime_error("Statically dispatched backtest differs from the virtual one");
+    }
+
+    run_bench("EventLoop::run_backtest (virtual dispatch)", bars->size(), options.repetitions, [&] {
+        make_event_loop<EventLoop>(bars, data)->run_backtest();
+    });
+    run_bench("BasicEventLoop::run_backtest (static dispatch)", bars->size(), options.repetitions, [&] {
+        make_event_loop<StaticEventLoop>(bars, data)->run_backtest();
+    });
+
+    logger.flush();
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+}
@@ -0,0 +1,57 @@
+// bench/LoggingBench.cpp
+
+#include "BenchHarness.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+// Caller-side cost of one risk-manager style log line: iostream + endl vs the async logger.
+// Both write to /dev/null, so neither measures the terminal.
+void run_logging_benchmarks(const BenchOptions& options) {
+    const std::size_t lines = options.bars / 20;
+    const std::string symbol = "AAPL";
+
+    std::ofstream null_stream("/dev/null");
+    run_bench("iostream << ... << std::endl", lines, options.repetitions, [&] {
+        for (std::size_t i = 0; i < lines; ++i) {
+            null_stream << "[RiskManager] WARNING: Position " << symbol << " target weight (" << 0.5 * 100
+                        << "%) exceeds max allowed (" << 0.25 * 100 << "%). Scaling down." << std::endl;
+        }
+    });
+
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+    const std::uint64_t dropped_before = logger.dropped_records();
+
+    // Every repetition of this burst must fit in the ring, or it would time drops
+    const std::size_t burst = std::min<std::size_t>(lines, logging::Logger::kRingCapacity / 128 / options.repetitions);
+    logger.flush();
+    run_bench("LOG_WARN (async, caller side)", burst, options.repetitions, [&] {
+        for (std::size_t i = 0; i < burst; ++i) {
+            LOG_WARN("RiskManager", "WARNING: Position {} target weight ({}%) exceeds max allowed ({}%). Scaling down.",
+                     symbol, 0.5 * 100, 0.25 * 100);
+        }
+    });
+    // End to end: waits for the logger thread to write out each burst
+    run_bench("LOG_WARN (async, including drain)", lines, options.repetitions, [&] {
+        for (std::size_t i = 0; i < lines; ++i) {
+            LOG_WARN("RiskManager", "WARNING: Position {} target weight ({}%) exceeds max allowed ({}%). Scaling down.",
+                     symbol, 0.5 * 100, 0.25 * 100);
+            if ((i + 1) % burst == 0) {
+                logger.flush();
+            }
+        }
+        logger.flush();
+    });
+    std::printf("%-60s %12llu records dropped (ring full)\n", "",
+                static_cast<unsigned long long>(logger.dropped_records() - dropped_before));
+
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+}
@@ -0,0 +1,182 @@
+// bench/OrderBookBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "core/Portfolio.h"
+#include "execution/OrderBook.h"
+#include "execution/OrderBookExecutionHandler.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    /**
+     * @brief The obvious book: a std::map of levels per side and a hash map of orders.
+     * Slow, but easy to trust; OrderBook must agree with it after every event.
+     */
+    class ReferenceBook {
+    public:
+        void apply(const BookEventRecord& event) {
+            auto& levels = event.side == 0 ? m_bids : m_asks;
+            switch (event.type) {
+                case BookEventType::Add:
+                    m_orders[event.order_id] = {event.side, event.price_ticks, event.quantity};
+                    levels[event.price_ticks] += event.quantity;
+                    break;
+                case BookEventType::Cancel:
+                case BookEventType::Execute: {
+                    auto it = m_orders.find(event.order_id);
+                    if (it == m_orders.end()) {
+                        break;
+                    }
+                    Order& order = it->second;
+                    const std::int64_t taken = event.type == BookEventType::Cancel
+                        ? order.quantity : std::min(order.quantity, event.quantity);
+                    take(order.side == 0 ? m_bids : m_asks, order.price_ticks, taken);
+                    order.quantity -= taken;
+                    if (order.quantity == 0) {
+                        m_orders.erase(it);
+                    }
+                    break;
+                }
+                case BookEventType::Level:
+                    if (event.quantity == 0) {
+                        levels.erase(event.price_ticks);
+                    } else {
+                        levels[event.price_ticks] = event.quantity;
+                    }
+                    break;
+                case BookEventType::Clear:
+                    m_bids.clear();
+                    m_asks.clear();
+                    m_orders.clear();
+                    break;
+            }
+        }
+
+        // Top `depth` levels of both sides must match, price and quantity.
+        void verify(const OrderBook& book, std::size_t event_index, std::size_t depth) const {
+            const std::int64_t best_bid = m_bids.empty() ? OrderBook::kNoBid : m_bids.rbegin()->first;
+            const std::int64_t best_ask = m_asks.empty() ? OrderBook::kNoAsk : m_asks.begin()->first;
+            if (book.best_bid() != best_bid || book.best_ask() != best_ask) {
+                throw std::runtime_error("OrderBook best bid/ask diverged from the reference at event "
+                                         + std::to_string(event_index));
+            }
+            verify_side(book, BookSide::Bid, m_bids.rbegin(), m_bids.rend(), event_index, depth);
+            verify_side(book, BookSide::Ask, m_asks.begin(), m_asks.end(), event_index, depth);
+        }
+
+    private:
+        struct Order {
+            std::uint8_t side;
+            std::int64_t price_ticks;
+            std::int64_t quantity;
+        };
+
+        static void take(std::map<std::int64_t, std::int64_t>& levels, std::int64_t price_ticks, std::int64_t quantity) {
+            auto it = levels.find(price_ticks);
+            it->second -= quantity;
+            if (it->second == 0) {
+                levels.erase(it);
+            }
+        }
+
+        template <typename It>
+        static void verify_side(const OrderBook& book, BookSide side, It it, It end,
+                                std::size_t event_index, std::size_t depth) {
+            std::size_t seen = 0;
+            bool matches = true;
+            book.for_each_level(side, [&](std::int64_t price_ticks, std::int64_t quantity) {
+                if (it == end || it->first != price_ticks || it->second != quantity) {
+                    matches = false;
+                    return false;
+                }
+                ++it;
+                return ++seen < depth;
+            });
+            if (!matches || (seen < depth && it != end)) {
+                throw std::runtime_error("OrderBook depth diverged from the reference at event "
+                                         + std::to_string(event_index));
+            }
+        }
+
+        std::map<std::int64_t, std::int64_t> m_bids;
+        std::map<std::int64_t, std::int64_t> m_asks;
+        std::unordered_map<std::uint64_t, Order> m_orders;
+    };
+
+    void check_against_reference(const std::vector<BookEventRecord>& events, const char* feed) {
+        OrderBook book;
+        ReferenceBook reference;
+        std::size_t rejected = 0;
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            rejected += !book.apply(events[i]);
+            reference.apply(events[i]);
+            if (i % 1000 == 999 || i + 1 == events.size()) {
+                reference.verify(book, i, 10);
+            }
+        }
+        if (rejected != 0) {
+            throw std::runtime_error(std::string("OrderBook rejected events of the synthetic ") + feed + " feed");
+        }
+        std::printf("%-60s %12zu events agree\n", (std::string("OrderBook vs reference (") + feed + ")").c_str(),
+                    events.size());
+    }
+}
+
+void run_order_book_benchmarks(const BenchOptions& options) {
+    SyntheticData data({1, 1, 1});
+    const auto l3_events = data.book_events(options.bars);
+    const auto l2_events = data.book_events(options.bars, true);
+
+    check_against_reference(l3_events, "L3");
+    check_against_reference(l2_events, "L2");
+
+    run_bench("OrderBook::apply (L3 replay)", l3_events.size(), options.repetitions, [&] {
+        OrderBook book;
+        for (const BookEventRecord& event : l3_events) {
+            book.apply(event);
+        }
+        do_not_optimize(book.best_bid());
+    });
+
+    run_bench("OrderBook::apply (L2 replay)", l2_events.size(), options.repetitions, [&] {
+        OrderBook book;
+        for (const BookEventRecord& event : l2_events) {
+            book.apply(event);
+        }
+        do_not_optimize(book.best_bid());
+    });
+
+    // End to end: one bar per millisecond (~1000 events), flipping between a
+    // 50% position and flat, each trade an IOC order walking the replayed book.
+    const auto directory = std::filesystem::temp_directory_path() / "engine_bench_books";
+    std::filesystem::create_directories(directory);
+    SyntheticData::write_book_file(directory / "SYNTH.book", l3_events);
+
+    auto registry = std::make_shared<SymbolRegistry>();
+    const SymbolId synth = registry->intern("SYNTH");
+    const std::size_t trades = options.bars / 1000;
+    const auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1'700'000'000));
+
+    run_bench("OrderBookExecutionHandler::execute_target_weights", trades, options.repetitions, [&] {
+        OrderBookExecutionHandler handler(directory.string(), 0.01, 1.0, 0.05, 0.0005);
+        Portfolio portfolio(1'000'000.0, registry);
+        WeightVector weights(1, 0.0);
+        const PriceVector prices(1, 100.0);
+        for (std::size_t t = 1; t <= trades; ++t) {
+            handler.on_market_bar(synth, DataBar("SYNTH", start + std::chrono::milliseconds(t),
+                                                 100.0, 100.0, 100.0, 100.0, 0, synth));
+            weights[0] = t % 2 ? 0.5 : 0.0;
+            handler.execute_target_weights(portfolio, *registry, weights, prices);
+        }
+        do_not_optimize(portfolio.get_cash());
+    });
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,80 @@
+// bench/PipelineBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "risk/PortfolioRiskManager.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace {
+    // Rotating targets that take `delay` to come back, like a model round trip.
+    class SlowSignalSource : public ISignalSource {
+    public:
+        explicit SlowSignalSource(std::chrono::nanoseconds delay) : m_delay(delay) {}
+
+        void update_market_data([[maybe_unused]] const nlohmann::json& market_data) override {}
+        void update_market_bar(const DataBar& bar) override { m_targets.update_market_bar(bar); }
+        std::map<std::string, double> get_target_portfolio() override { return {}; }
+
+        void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override {
+            const auto until = std::chrono::steady_clock::now() + m_delay;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+            m_targets.get_target_weights(registry, target_weights);
+        }
+
+    private:
+        std::chrono::nanoseconds m_delay;
+        RotatingSignalSource m_targets;
+    };
+
+    std::unique_ptr<EventLoop> make_event_loop(const SharedBarStore& bars, const SyntheticData& data,
+                                               std::chrono::nanoseconds signal_delay) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        return std::make_unique<EventLoop>(
+            std::make_unique<InMemoryBarProvider>(bars),
+            std::make_unique<SlowSignalSource>(signal_delay),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+}
+
+// Sequential against three-stage pipelined backtests: the overlap gained.
+// tests/PipelineTest.cpp checks that both end identically.
+void run_pipeline_benchmarks(const BenchOptions& options) {
+    SyntheticSpec spec;
+    spec.bars_per_symbol = std::max<std::size_t>(2, options.bars / 10 / spec.symbols);
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+
+    // Without a signal delay the stages are too short to hide anything; at a few
+    // microseconds the signal stage dominates and the others run in its shadow
+    for (const auto delay : {std::chrono::nanoseconds(0), std::chrono::nanoseconds(2000)}) {
+        const std::string suffix = " (signal " + std::to_string(delay.count()) + " ns)";
+        run_bench("EventLoop::run_backtest" + suffix, bars->size(), options.repetitions, [&] {
+            make_event_loop(bars, data, delay)->run_backtest();
+        });
+        run_bench("EventLoop::run_pipelined_backtest" + suffix, bars->size(), options.repetitions, [&] {
+            make_event_loop(bars, data, delay)->run_pipelined_backtest();
+        });
+    }
+
+    logger.flush();
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+}
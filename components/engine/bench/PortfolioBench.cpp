@@ -0,0 +1,117 @@
+// bench/PortfolioBench.cpp
+
+#include "BenchHarness.h"
+#include "core/Portfolio.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace {
+    constexpr std::size_t kUniverse = 500;
+    constexpr std::size_t kTradesPerBar = 20;
+
+    // The previous design: every call takes the same mutex, and monitoring
+    // copies the holdings under it.
+    class LockedPortfolio {
+    public:
+        LockedPortfolio() : m_positions(kUniverse, 0) {}
+
+        long long get_position(SymbolId id) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_positions[id];
+        }
+        void update_holding(SymbolId id, long long quantity) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_positions[id] += quantity;
+        }
+        void update_cash(double amount) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cash += amount;
+        }
+        void recalculate_total_value(const PriceVector& prices) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            double market_value = 0.0;
+            for (std::size_t id = 0; id < m_positions.size(); ++id) {
+                market_value += m_positions[id] * prices[id];
+            }
+            m_total_value = m_cash + market_value;
+        }
+        void snapshot(PortfolioSnapshot& out) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            out.cash = m_cash;
+            out.total_value = m_total_value;
+            out.positions = m_positions;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        double m_cash = 1e6;
+        double m_total_value = 1e6;
+        std::vector<long long> m_positions;
+    };
+
+    // One bar of execution-handler traffic: a few trades, then mark-to-market.
+    template <typename P>
+    void simulate_bars(P& portfolio, std::size_t bars, const PriceVector& prices) {
+        for (std::size_t bar = 0; bar < bars; ++bar) {
+            for (std::size_t t = 0; t < kTradesPerBar; ++t) {
+                const auto id = static_cast<SymbolId>((bar * 7 + t * 31) % kUniverse);
+                const long long shares = portfolio.get_position(id) > 0 ? -10 : 10;
+                portfolio.update_holding(id, shares);
+                portfolio.update_cash(-shares * prices[id]);
+            }
+            portfolio.recalculate_total_value(prices);
+        }
+    }
+
+    // Runs the writer while `readers` threads snapshot in a tight loop.
+    template <typename P>
+    void bench_contention(const std::string& label, P& portfolio, std::size_t bars,
+                          std::size_t readers, const BenchOptions& options) {
+        const PriceVector prices(kUniverse, 100.0);
+        std::atomic<bool> stop{false};
+        std::atomic<std::size_t> snapshots{0};
+
+        std::vector<std::thread> reader_threads;
+        for (std::size_t r = 0; r < readers; ++r) {
+            reader_threads.emplace_back([&] {
+                PortfolioSnapshot snapshot;
+                std::size_t count = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    portfolio.snapshot(snapshot);
+                    ++count;
+                }
+                snapshots.fetch_add(count);
+            });
+        }
+
+        run_bench(label + ", " + std::to_string(readers) + " readers", bars, options.repetitions, [&] {
+            simulate_bars(portfolio, bars, prices);
+        });
+
+        stop = true;
+        for (auto& thread : reader_threads) {
+            thread.join();
+        }
+        if (readers > 0) {
+            std::printf("%-60s %12zu snapshots\n", "", snapshots.load());
+        }
+    }
+}
+
+// Writer throughput (bars/s) with and without concurrent snapshot readers.
+void run_portfolio_benchmarks(const BenchOptions& options) {
+    const std::size_t bars = options.bars / 20;
+    const auto registry = std::make_shared<SymbolRegistry>();
+    for (std::size_t i = 0; i < kUniverse; ++i) {
+        registry->intern("SYM" + std::to_string(i));
+    }
+
+    for (std::size_t readers : {0, 1, 3}) {
+        LockedPortfolio locked;
+        bench_contention("Mutex portfolio", locked, bars, readers, options);
+
+        Portfolio seqlock(1e6, registry);
+        bench_contention("Single-writer portfolio", seqlock, bars, readers, options);
+    }
+}
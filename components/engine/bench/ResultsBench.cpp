@@ -0,0 +1,231 @@
+// bench/ResultsBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "metrics/PerformanceAnalytics.h"
+#include "results/ResultsStore.h"
+#include "risk/PortfolioRiskManager.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::unique_ptr<EventLoop> make_event_loop(const SharedBarStore& bars, const SyntheticData& data) {
+        return std::make_unique<EventLoop>(
+            std::make_unique<InMemoryBarProvider>(bars),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+
+    std::int64_t query_int(const fs::path& db_path, const std::string& sql) {
+        sqlite3* db = nullptr;
+        sqlite3_stmt* statement = nullptr;
+        std::int64_t value = -1;
+        if (sqlite3_open_v2(db_path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK &&
+            sqlite3_prepare_v2(db, sql.c_str(), -1, &statement, nullptr) == SQLITE_OK &&
+            sqlite3_step(statement) == SQLITE_ROW) {
+            value = sqlite3_column_int64(statement, 0);
+        }
+        sqlite3_finalize(statement);
+        sqlite3_close(db);
+        return value;
+    }
+
+    void remove_database(const fs::path& db_path) {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            fs::remove(db_path.string() + suffix);
+        }
+    }
+
+    // Marks every bar and trades one symbol every 50 bars, feeding the analytics like the EventLoop.
+    template <typename OnPeriodEnd>
+    PerformanceSummary replay_portfolio(const std::vector<DataBar>& bars, const SyntheticData& data,
+                                        OnPeriodEnd&& on_period_end) {
+        Portfolio portfolio(100000.0, data.registry());
+        PerformanceAnalytics analytics(portfolio.get_total_value());
+        double peak = portfolio.get_total_value();
+        for (std::size_t i = 0; i < bars.size(); ++i) {
+            const DataBar& bar = bars[i];
+            portfolio.mark_price(bar.symbol_id, bar.close);
+            peak = std::max(peak, portfolio.get_total_value());
+            if (i % 50 == 0) {
+                const long long shares = (i / 50) % 3 == 2 ? -portfolio.get_position(bar.symbol_id) : 20;
+                portfolio.update_holding(bar.symbol_id, shares);
+                portfolio.update_cash(-shares * bar.close - 1.0);
+            }
+            analytics.on_bar(bar.timestamp, portfolio, peak);
+            if (i + 1 == bars.size() || bars[i + 1].timestamp != bar.timestamp) {
+                on_period_end(portfolio.get_total_value(), peak);
+            }
+        }
+        return analytics.finish();
+    }
+
+    void check_close(const char* what, double actual, double expected) {
+        if (std::abs(actual - expected) > 1e-9 * std::max(1.0, std::abs(expected))) {
+            throw std::runtime_error(std::string("PerformanceAnalytics ") + what + " is " + std::to_string(actual) +
+                                     ", expected " + std::to_string(expected));
+        }
+    }
+}
+
+// Cost of persisting fills and the equity curve: on the producer, end to end, and inside the bar loop.
+void run_results_benchmarks(const BenchOptions& options) {
+    const fs::path db_path = fs::temp_directory_path() / "engine_bench_results.db";
+    remove_database(db_path);
+
+    // What recording costs the bar loop while the writer keeps up: a push onto the ring
+    {
+        const std::size_t burst = std::min<std::size_t>(options.bars, 1 << 18);
+        ResultsStore store(db_path.string(), burst * options.repetitions);
+        auto recorder = store.begin_run("bench: caller side");
+        recorder->begin_bar(std::chrono::system_clock::now());
+        run_bench("ResultsRecorder::record_equity (caller side)", burst, options.repetitions, [&] {
+            for (std::size_t i = 0; i < burst; ++i) {
+                recorder->record_equity(100000.0 + static_cast<double>(i), 50000.0, 100000.0);
+            }
+        });
+        recorder->finish(SymbolRegistry{});
+        store.flush();
+    }
+
+    // Sustained rate of the writer thread: rows committed per second
+    {
+        ResultsStore store(db_path.string());
+        auto recorder = store.begin_run("bench: end to end");
+        std::uint64_t rows = 0;
+        run_bench("ResultsStore rows (including commit)", options.bars, options.repetitions, [&] {
+            for (std::size_t i = 0; i < options.bars; ++i) {
+                recorder->begin_bar(std::chrono::system_clock::time_point(std::chrono::seconds(i)));
+                if (i % 4 == 0) {
+                    recorder->record_fill(static_cast<SymbolId>(i % 100), 100, 50.0, 1.0);
+                } else {
+                    recorder->record_equity(100000.0, 50000.0, 100000.0);
+                }
+            }
+            rows += options.bars;
+            store.flush();
+        });
+        std::printf("%-60s %12llu producer stalls (ring full)\n", "",
+                    static_cast<unsigned long long>(recorder->stalls()));
+        recorder->finish(SymbolRegistry{});
+        store.flush();
+        if (store.rows_written() != rows) {
+            throw std::runtime_error("ResultsStore committed " + std::to_string(store.rows_written()) +
+                                     " rows, expected " + std::to_string(rows));
+        }
+    }
+
+    SyntheticSpec spec;
+    spec.bars_per_symbol = std::max<std::size_t>(2, options.bars / 10 / spec.symbols);
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    // Streaming statistics against a second pass over the stored equity curve
+    {
+        std::vector<double> curve;
+        double drawdown = 0.0;
+        const PerformanceSummary streamed = replay_portfolio(*bars, data, [&](double equity, double peak) {
+            curve.push_back(equity);
+            drawdown = std::max(drawdown, 1.0 - equity / std::max(peak, equity));
+        });
+
+        std::vector<double> returns;
+        double previous = 100000.0;
+        for (double equity : curve) {
+            returns.push_back(equity / previous - 1.0);
+            previous = equity;
+        }
+        double mean = 0.0;
+        for (double r : returns) {
+            mean += r;
+        }
+        mean /= static_cast<double>(returns.size());
+        double variance = 0.0;
+        double downside = 0.0;
+        for (double r : returns) {
+            variance += (r - mean) * (r - mean);
+            downside += r < 0.0 ? r * r : 0.0;
+        }
+        const double volatility = std::sqrt(variance / static_cast<double>(returns.size() - 1));
+        const double annualization = std::sqrt(streamed.periods_per_year);
+        check_close("periods", static_cast<double>(streamed.periods), static_cast<double>(curve.size()));
+        check_close("mean return", streamed.mean_return, mean);
+        check_close("volatility", streamed.return_volatility, volatility);
+        check_close("Sharpe ratio", streamed.sharpe_ratio, mean / volatility * annualization);
+        check_close("Sortino ratio", streamed.sortino_ratio,
+                    mean / std::sqrt(downside / static_cast<double>(returns.size())) * annualization);
+        check_close("max drawdown", streamed.max_drawdown, drawdown);
+        check_close("final equity", streamed.final_equity, curve.back());
+
+        run_bench("PerformanceAnalytics::on_bar (with mark and fills)", bars->size(), options.repetitions, [&] {
+            do_not_optimize(replay_portfolio(*bars, data, [](double, double) {}).sharpe_ratio);
+        });
+        std::printf("%-60s %12.3f Sharpe, %.2f%% max drawdown over %llu periods\n", "", streamed.sharpe_ratio,
+                    streamed.max_drawdown * 100, static_cast<unsigned long long>(streamed.periods));
+    }
+
+    // The same backtest with and without a recorder attached
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+
+    double plain_value = 0.0;
+    run_bench("EventLoop::run_backtest (no results)", bars->size(), options.repetitions, [&] {
+        auto event_loop = make_event_loop(bars, data);
+        event_loop->run_backtest();
+        plain_value = event_loop->get_portfolio().get_total_value();
+    });
+
+    double recorded_value = 0.0;
+    std::uint32_t last_run_id = 0;
+    {
+        ResultsStore store(db_path.string());
+        run_bench("EventLoop::run_backtest (recording results)", bars->size(), options.repetitions, [&] {
+            auto event_loop = make_event_loop(bars, data);
+            auto recorder = store.begin_run("bench: backtest");
+            event_loop->set_results_recorder(recorder);
+            event_loop->run_backtest();
+            recorded_value = event_loop->get_portfolio().get_total_value();
+            last_run_id = recorder->run_id();
+        });
+        store.flush();
+    }
+
+    logger.flush();
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+
+    // Recording must not change the run, and must persist every bar and fill of it
+    if (recorded_value != plain_value) {
+        throw std::runtime_error("Recording results changed the backtest's final value");
+    }
+    const std::string run = std::to_string(last_run_id);
+    const std::int64_t equity_rows = query_int(db_path, "SELECT COUNT(*) FROM equity WHERE run_id = " + run);
+    const std::int64_t fill_rows = query_int(db_path, "SELECT COUNT(*) FROM fills WHERE run_id = " + run);
+    if (equity_rows != static_cast<std::int64_t>(bars->size()) ||
+        query_int(db_path, "SELECT bars FROM runs WHERE run_id = " + run) != equity_rows ||
+        query_int(db_path, "SELECT fills FROM runs WHERE run_id = " + run) != fill_rows ||
+        query_int(db_path, "SELECT COUNT(*) FROM symbols WHERE run_id = " + run) != static_cast<std::int64_t>(spec.symbols)) {
+        throw std::runtime_error("Results database does not match the recorded backtest");
+    }
+    std::printf("%-60s %12lld equity rows, %lld fills per run\n", "",
+                static_cast<long long>(equity_rows), static_cast<long long>(fill_rows));
+
+    remove_database(db_path);
+}
@@ -0,0 +1,154 @@
+// bench/SignalCacheBench.cpp
+
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "logging/Logger.h"
+#include "risk/PortfolioRiskManager.h"
+#include "signals/CachedSignalSource.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr const char* kModelKey = "bench models v1";
+
+    // A deterministic model: its weights depend on the bar alone. Replies take
+    // `delay` and come back in bar order, up to `depth` bars in flight.
+    class DeterministicModel : public ISignalSource {
+    public:
+        DeterministicModel(std::chrono::nanoseconds delay, std::size_t depth, std::uint64_t& requests)
+            : m_delay(delay), m_depth(depth), m_requests(requests) {}
+
+        void update_market_data([[maybe_unused]] const nlohmann::json& market_data) override {}
+        void update_market_bar(const DataBar& bar) override {
+            m_in_flight.push_back(bar.timestamp.time_since_epoch().count());
+            ++m_requests;
+        }
+        std::map<std::string, double> get_target_portfolio() override { return {}; }
+        std::size_t pipeline_depth() const override { return m_depth; }
+        bool models_stateless() const override { return true; } // Each answer depends on its own bar only
+
+        void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override {
+            const auto until = std::chrono::steady_clock::now() + m_delay;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+            const auto rotation = static_cast<std::size_t>(m_in_flight.front() / 3'600'000'000'000LL);
+            m_in_flight.erase(m_in_flight.begin());
+            target_weights.assign(registry.size(), 0.0);
+            for (std::size_t i = 0; i < 10; ++i) {
+                target_weights[(rotation + i) % registry.size()] = 0.09;
+            }
+        }
+
+    private:
+        std::chrono::nanoseconds m_delay;
+        std::size_t m_depth;
+        std::uint64_t& m_requests;
+        std::vector<std::int64_t> m_in_flight;
+    };
+
+    std::unique_ptr<EventLoop> make_event_loop(const SharedBarStore& bars, const SyntheticData& data,
+                                               std::unique_ptr<ISignalSource> signal_source) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        return std::make_unique<EventLoop>(
+            std::make_unique<InMemoryBarProvider>(bars),
+            std::move(signal_source),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+
+    std::string outcome(const EventLoop& event_loop) {
+        return std::to_string(event_loop.get_portfolio().get_total_value()) + " " +
+               std::to_string(event_loop.get_peak_portfolio_value()) + " " +
+               event_loop.get_performance().to_json().dump();
+    }
+
+    // One backtest through the cache at `path`; returns its outcome and counts the model's requests.
+    std::string run_cached(const SharedBarStore& bars, const SyntheticData& data, const fs::path& path,
+                           SignalCacheMode mode, std::uint64_t& requests) {
+        auto cache = std::make_shared<SignalReplyCache>(path.string(), kModelKey, mode);
+        auto event_loop = make_event_loop(bars, data, std::make_unique<CachedSignalSource>(
+            std::make_unique<DeterministicModel>(std::chrono::nanoseconds(0), 4, requests), cache));
+        event_loop->run_backtest();
+        return outcome(*event_loop);
+    }
+
+    void expect(bool condition, const std::string& what) {
+        if (!condition) {
+            throw std::runtime_error("Signal cache: " + what);
+        }
+    }
+}
+
+// Backtests through a persistent signal reply cache: identical results, no model requests once warm.
+void run_signal_cache_benchmarks(const BenchOptions& options) {
+    SyntheticSpec spec;
+    spec.bars_per_symbol = std::max<std::size_t>(2, options.bars / 10 / spec.symbols);
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+    const fs::path path = fs::temp_directory_path() / "engine_bench_signals.cache";
+
+    std::FILE* null_file = std::fopen("/dev/null", "w");
+    if (!null_file) {
+        return;
+    }
+    auto& logger = logging::Logger::instance();
+    logger.set_output(null_file, null_file);
+
+    std::uint64_t requests = 0;
+    auto uncached = make_event_loop(bars, data,
+        std::make_unique<DeterministicModel>(std::chrono::nanoseconds(0), 4, requests));
+    uncached->run_backtest();
+    const std::string expected = outcome(*uncached);
+
+    // Cold: every bar goes to the model and is recorded
+    requests = 0;
+    expect(run_cached(bars, data, path, SignalCacheMode::Invalidate, requests) == expected, "cold run differs");
+    expect(requests == bars->size(), "cold run skipped model requests");
+    std::printf("%-60s %12zu bars %10.1f bytes per bar\n", "Signal cache recorded", bars->size(),
+                static_cast<double>(fs::file_size(path)) / static_cast<double>(bars->size()));
+
+    // Warm: every bar is served from the log
+    requests = 0;
+    expect(run_cached(bars, data, path, SignalCacheMode::ReadWrite, requests) == expected, "warm run differs");
+    expect(requests == 0, std::to_string(requests) + " model requests on a warm run");
+
+    // A torn last record is dropped, and only that bar goes to the model again
+    fs::resize_file(path, fs::file_size(path) - 5);
+    requests = 0;
+    expect(run_cached(bars, data, path, SignalCacheMode::ReadWrite, requests) == expected, "repaired run differs");
+    expect(requests == 1, std::to_string(requests) + " model requests after losing one record");
+
+    // Other models, and explicit invalidation, see nothing
+    expect(SignalReplyCache(path.string(), "other models", SignalCacheMode::ReadOnly).recorded_entries() == 0,
+           "replies served to other models");
+    expect(SignalReplyCache(path.string(), kModelKey, SignalCacheMode::ReadOnly).recorded_entries() == bars->size(),
+           "read-only open lost records");
+    expect(SignalReplyCache(path.string(), kModelKey, SignalCacheMode::Invalidate).recorded_entries() == 0,
+           "invalidated cache still has records");
+
+    // A model round trip of 20 us against the warm cache
+    run_bench("EventLoop::run_backtest (models, 20 us round trip)", bars->size(), options.repetitions, [&] {
+        make_event_loop(bars, data, std::make_unique<DeterministicModel>(std::chrono::microseconds(20), 4, requests))
+            ->run_backtest();
+    });
+    run_cached(bars, data, path, SignalCacheMode::Invalidate, requests);
+    run_bench("EventLoop::run_backtest (CachedSignalSource, warm)", bars->size(), options.repetitions, [&] {
+        run_cached(bars, data, path, SignalCacheMode::ReadOnly, requests);
+    });
+    fs::remove(path);
+
+    logger.flush();
+    logger.set_output(stdout, stderr);
+    std::fclose(null_file);
+}
@@ -0,0 +1,267 @@
+// bench/SyntheticData.cpp
+
+#include "SyntheticData.h"
+#include "checkpoint/Checkpoint.h"
+#include "data/DataBarRecord.h"
+#include "data/TimeRange.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+SyntheticData::SyntheticData(const SyntheticSpec& spec)
+    : m_spec(spec), m_registry(std::make_shared<SymbolRegistry>()), m_rng(spec.seed)
+{
+    m_symbols.reserve(spec.symbols);
+    char name[32];
+    for (std::size_t i = 0; i < spec.symbols; ++i) {
+        std::snprintf(name, sizeof(name), "SYM%05zu", i);
+        m_symbols.emplace_back(name);
+        m_registry->intern(m_symbols.back());
+    }
+}
+
+std::vector<DataBar> SyntheticData::bars() {
+    std::normal_distribution<double> step(0.0, 0.01);
+    std::vector<double> closes(m_spec.symbols, 100.0);
+
+    std::vector<DataBar> bars;
+    bars.reserve(m_spec.symbols * m_spec.bars_per_symbol);
+    const auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1'700'000'000));
+    for (std::size_t t = 0; t < m_spec.bars_per_symbol; ++t) {
+        const auto timestamp = start + std::chrono::minutes(t);
+        for (std::size_t i = 0; i < m_spec.symbols; ++i) {
+            const double open = closes[i];
+            closes[i] = open * (1.0 + step(m_rng));
+            bars.emplace_back(m_symbols[i], timestamp, open, std::max(open, closes[i]) * 1.001,
+                              std::min(open, closes[i]) * 0.999, closes[i], 1000 + t % 100,
+                              static_cast<SymbolId>(i));
+        }
+    }
+    return bars;
+}
+
+PriceVector SyntheticData::prices() {
+    std::uniform_real_distribution<double> price(10.0, 500.0);
+    PriceVector prices(m_spec.symbols);
+    for (double& p : prices) {
+        p = price(m_rng);
+    }
+    return prices;
+}
+
+ModelSignals SyntheticData::model_signals() {
+    std::uniform_real_distribution<double> weight(-0.5, 1.0);
+    std::uniform_real_distribution<double> confidence(0.1, 1.0);
+
+    ModelSignals signals(m_spec.models);
+    for (auto& packets : signals) {
+        packets.reserve(m_spec.symbols);
+        for (const auto& symbol : m_symbols) {
+            const double w = weight(m_rng) / static_cast<double>(m_spec.symbols);
+            packets.emplace_back(symbol, w >= 0 ? SignalType::Long : SignalType::Short, w, confidence(m_rng));
+        }
+    }
+    return signals;
+}
+
+WeightVector SyntheticData::target_weights() {
+    // Uneven weights summing to ~1.2: some names trip the concentration rule,
+    // and the total trips the leverage rule, so every risk branch runs
+    std::uniform_real_distribution<double> weight(0.0, 2.4);
+    WeightVector weights(m_spec.symbols);
+    for (double& w : weights) {
+        w = weight(m_rng) / static_cast<double>(m_spec.symbols);
+    }
+    if (!weights.empty()) {
+        weights.front() = 0.5;
+    }
+    return weights;
+}
+
+std::map<std::string, double> SyntheticData::target_portfolio() {
+    std::map<std::string, double> portfolio;
+    const WeightVector weights = target_weights();
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        portfolio.emplace(m_symbols[i], weights[i]);
+    }
+    return portfolio;
+}
+
+std::vector<BookEventRecord> SyntheticData::book_events(std::size_t count, bool level2) {
+    struct LiveOrder {
+        std::uint64_t id;
+        std::int64_t quantity;
+    };
+    constexpr std::size_t kTargetDepth = 5000; // Resting orders the feed hovers around
+    const std::uint64_t start_ns = 1'700'000'000'000'000'000ULL;
+
+    std::uniform_int_distribution<int> distance(1, 20);    // Ticks from the mid
+    std::uniform_int_distribution<std::int64_t> size(1, 500);
+    std::uniform_real_distribution<double> action(0.0, 1.0);
+
+    std::vector<BookEventRecord> events;
+    events.reserve(count);
+    std::vector<LiveOrder> live;
+    std::int64_t mid = 10'000;
+    std::uint64_t next_id = 1;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 100 == 0) {
+            mid += action(m_rng) < 0.5 ? -1 : 1;
+        }
+        BookEventRecord event{};
+        event.timestamp_epoch_ns = start_ns + i * 1000;
+        const bool bid = action(m_rng) < 0.5;
+        event.side = bid ? 0 : 1;
+        event.price_ticks = bid ? mid - distance(m_rng) : mid + distance(m_rng);
+
+        const double roll = action(m_rng);
+        if (level2) {
+            event.type = BookEventType::Level;
+            event.quantity = roll < 0.2 ? 0 : size(m_rng) * 10; // Some updates empty a level
+        } else if (live.empty() || roll < (live.size() < kTargetDepth ? 0.55 : 0.45)) {
+            event.type = BookEventType::Add;
+            event.order_id = next_id++;
+            event.quantity = size(m_rng);
+            live.push_back({event.order_id, event.quantity});
+        } else {
+            // Cancel or (partially) execute a random resting order
+            const std::size_t victim = m_rng() % live.size();
+            event.order_id = live[victim].id;
+            if (roll < 0.85) {
+                event.type = BookEventType::Cancel;
+                event.quantity = live[victim].quantity;
+            } else {
+                event.type = BookEventType::Execute;
+                event.quantity = std::min<std::int64_t>(live[victim].quantity, size(m_rng));
+            }
+            live[victim].quantity -= event.quantity;
+            if (live[victim].quantity == 0) {
+                live[victim] = live.back();
+                live.pop_back();
+            }
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+
+void SyntheticData::write_book_file(const std::filesystem::path& path, const std::vector<BookEventRecord>& events) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create " + path.string());
+    }
+    out.write(reinterpret_cast<const char*>(events.data()),
+              static_cast<std::streamsize>(events.size() * sizeof(BookEventRecord)));
+}
+
+void SyntheticData::write_bincode_file(const std::filesystem::path& path, std::size_t count) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create " + path.string());
+    }
+    auto write_varint = [&](std::uint64_t value) {
+        if (value < 251) {
+            const auto byte = static_cast<std::uint8_t>(value);
+            out.write(reinterpret_cast<const char*>(&byte), 1);
+        } else {
+            const std::uint8_t marker = 253; // u64 follows
+            out.write(reinterpret_cast<const char*>(&marker), 1);
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    };
+    auto write_f64 = [&](double value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto cents = [](double price) { return std::round(price * 100.0) / 100.0; };
+
+    using namespace std::chrono;
+    constexpr std::size_t kBarsPerSession = 78; // 09:30 to 16:00 in 5-minute bars
+    const sys_days first_day = year{2024} / January / 2;
+    double price = 100.0;
+    char date[64];
+
+    write_varint(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto time = first_day + days(i / kBarsPerSession) + hours(9) + minutes(30)
+                          + minutes(5 * (i % kBarsPerSession));
+        const year_month_day ymd{floor<days>(time)};
+        const hh_mm_ss hms{time - floor<days>(time)};
+        std::snprintf(date, sizeof(date), "%04d-%02u-%02u %02ld:%02ld:00", static_cast<int>(ymd.year()),
+                      static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()),
+                      static_cast<long>(hms.hours().count()), static_cast<long>(hms.minutes().count()));
+        write_varint(std::strlen(date));
+        out.write(date, static_cast<std::streamsize>(std::strlen(date)));
+
+        const double open = cents(price);
+        price += (i % 7 == 0) ? 0.06 : -0.01;
+        write_f64(open);
+        write_f64(cents(std::max(open, price) + 0.03));
+        write_f64(cents(std::min(open, price) - 0.02));
+        write_f64(cents(price));
+        write_f64(static_cast<double>(1000 + (i * 37) % 5000));
+    }
+}
+
+void SyntheticData::write_bar_file(const std::filesystem::path& path, const std::string& symbol, std::size_t count) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create " + path.string());
+    }
+    const BarFileHeader header = make_bar_file_header();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    DataBarRecord record{};
+    std::strncpy(record.symbol, symbol.c_str(), sizeof(record.symbol) - 1);
+    double price = 100.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        price += (i % 7 == 0) ? 0.05 : -0.01;
+        record.timestamp_epoch_ns = 1'700'000'000'000'000'000ULL + i * 60'000'000'000ULL;
+        record.open = price;
+        record.high = price + 0.1;
+        record.low = price - 0.1;
+        record.close = price + 0.02;
+        record.volume = 1000 + i % 100;
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+}
+
+void SyntheticData::write_symbol_files(const std::filesystem::path& directory, const std::vector<DataBar>& bars) const {
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::vector<std::ofstream> files;
+    const BarFileHeader header = make_bar_file_header();
+    for (const std::string& symbol : m_symbols) {
+        files.emplace_back(directory / (symbol + ".bin"), std::ios::binary | std::ios::trunc);
+        files.back().write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    for (const DataBar& bar : bars) {
+        DataBarRecord record{};
+        std::strncpy(record.symbol, bar.symbol.c_str(), sizeof(record.symbol) - 1);
+        record.timestamp_epoch_ns = TimeRange::to_epoch_ns(bar.timestamp);
+        record.open = bar.open;
+        record.high = bar.high;
+        record.low = bar.low;
+        record.close = bar.close;
+        record.volume = bar.volume;
+        files[bar.symbol_id].write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+}
+
+void RotatingSignalSource::get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) {
+    target_weights.assign(registry.size(), 0.0);
+    for (std::size_t i = 0; i < 10; ++i) {
+        target_weights[(m_bars / 100 + i) % registry.size()] = 0.09;
+    }
+}
+
+void RotatingSignalSource::save_state(StateWriter& out) const {
+    out.write(m_bars);
+}
+
+void RotatingSignalSource::restore_state(StateReader& in) {
+    in.read(m_bars);
+}
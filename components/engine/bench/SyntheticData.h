@@ -0,0 +1,103 @@
+// bench/SyntheticData.h
+
+#pragma once
+
+#include "core/DataBar.h"
+#include "core/SignalPacket.h"
+#include "core/SymbolRegistry.h"
+#include "data/BookEventRecord.h"
+#include "interfaces/ISignalSource.h"
+#include "signals/SignalMatrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Shape of a synthetic market: N symbols, M bars each, K fake models.
+ * Everything generated from the same spec and seed is identical run to run.
+ */
+struct SyntheticSpec {
+    std::size_t symbols = 100;
+    std::size_t bars_per_symbol = 1000;
+    std::size_t models = 4;
+    std::uint64_t seed = 42;
+};
+
+/**
+ * @brief Generates synthetic data sets for the component benchmarks.
+ * Symbols are named SYM00000, SYM00001, ... and interned into `registry()`
+ * in that order, so symbol i always has SymbolId i.
+ */
+class SyntheticData {
+public:
+    explicit SyntheticData(const SyntheticSpec& spec);
+
+    const SyntheticSpec& spec() const { return m_spec; }
+    const std::shared_ptr<SymbolRegistry>& registry() const { return m_registry; }
+    const std::vector<std::string>& symbols() const { return m_symbols; }
+
+    // Time-ordered bars, one per symbol per timestamp, from a random walk per symbol.
+    std::vector<DataBar> bars();
+
+    // One latest price per symbol, indexed by SymbolId.
+    PriceVector prices();
+
+    // The replies of all K models for one bar: each model covers every symbol.
+    ModelSignals model_signals();
+
+    // A target portfolio in both representations, fully invested across the universe.
+    std::map<std::string, double> target_portfolio();
+    WeightVector target_weights();
+
+    /**
+     * @brief A replay feed for one symbol's order book around a drifting mid of ~100.00
+     * (tick 0.01), one event per microsecond from the first bar's timestamp.
+     * @param level2 L3 adds/cancels/executions if false, L2 level updates if true.
+     */
+    std::vector<BookEventRecord> book_events(std::size_t count, bool level2 = false);
+
+    // Writes events in the 40-byte `.book` layout.
+    static void write_book_file(const std::filesystem::path& path, const std::vector<BookEventRecord>& events);
+
+    /**
+     * @brief Writes `count` bars the way rust_data_fetcher does: a bincode Vec of
+     * {date string, open, high, low, close, volume as f64}. Bars are 5 minutes
+     * apart over 6.5-hour sessions, with prices in whole cents.
+     */
+    static void write_bincode_file(const std::filesystem::path& path, std::size_t count);
+
+    // Writes `count` bars for one symbol as a `.bin` file: the header, then 64-byte records.
+    static void write_bar_file(const std::filesystem::path& path, const std::string& symbol, std::size_t count);
+
+    // Writes `bars` (from bars()) to one `.bin` file per symbol in `directory`, replacing its contents.
+    void write_symbol_files(const std::filesystem::path& directory, const std::vector<DataBar>& bars) const;
+
+private:
+    SyntheticSpec m_spec;
+    std::shared_ptr<SymbolRegistry> m_registry;
+    std::vector<std::string> m_symbols;
+    std::mt19937_64 m_rng;
+};
+
+/**
+ * @brief Holds ten symbols and moves one of them every 100 bars, so most bars trade.
+ * Its bar count is its sequence state, saved and restored with checkpoints.
+ */
+class RotatingSignalSource final : public ISignalSource {
+public:
+    void update_market_data([[maybe_unused]] const nlohmann::json& market_data) override {}
+    void update_market_bar([[maybe_unused]] const DataBar& bar) override { ++m_bars; }
+    std::map<std::string, double> get_target_portfolio() override { return {}; }
+    void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override;
+
+    void save_state(StateWriter& out) const override;
+    void restore_state(StateReader& in) override;
+
+private:
+    std::uint64_t m_bars = 0;
+};
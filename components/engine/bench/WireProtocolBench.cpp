@@ -0,0 +1,41 @@
+// bench/WireProtocolBench.cpp
+
+#include "BenchHarness.h"
+#include "signals/WireProtocol.h"
+#include <nlohmann/json.hpp>
+
+// Per-bar encode + decode cost of the model protocol: JSON vs binary.
+void run_wire_protocol_benchmarks(const BenchOptions& options) {
+    const std::size_t iterations = options.bars / 4;
+    const DataBar bar("AAPL", std::chrono::system_clock::now(), 189.1, 189.9, 188.7, 189.5, 120000);
+    const SignalPacket packet("AAPL", SignalType::Long, 0.2, 0.8);
+
+    run_bench("JSON request dump + reply parse", iterations, options.repetitions, [&] {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            std::string request = nlohmann::json{{"symbol", bar.symbol}, {"close", bar.close}}.dump();
+            std::string reply = nlohmann::json{{"symbol", packet.symbol}, {"signal_type", "LONG"},
+                                               {"target_weight", packet.target_weight},
+                                               {"confidence", packet.confidence}}.dump();
+            SignalPacket decoded = nlohmann::json::parse(reply).get<SignalPacket>();
+            sum += decoded.target_weight + static_cast<double>(request.size());
+        }
+        do_not_optimize(sum);
+    });
+
+    run_bench("Binary request encode + reply decode", iterations, options.repetitions, [&] {
+        std::string request;
+        std::string reply;
+        std::vector<SignalPacket> packets{packet};
+        std::vector<SignalPacket> decoded;
+        double sum = 0.0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            wire::encode_market_data(bar, request);
+            wire::encode_signals(packets, reply);
+            decoded.clear();
+            wire::decode_signals(reply.data(), reply.size(), decoded);
+            sum += decoded.front().target_weight + static_cast<double>(request.size());
+        }
+        do_not_optimize(sum);
+    });
+}
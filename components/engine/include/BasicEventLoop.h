@@ -0,0 +1,663 @@
+// include/BasicEventLoop.h
+
+#pragma once
+
+#include "interfaces/ComponentConcepts.h"
+#include "checkpoint/Checkpoint.h"
+#include "checkpoint/CheckpointWriter.h"
+#include "core/DataBar.h"
+#include "core/Portfolio.h"
+#include "core/SpscQueue.h"
+#include "data/TimeRange.h"
+#include "logging/Logger.h"
+#include "metrics/MetricsReport.h"
+#include "metrics/PerformanceAnalytics.h"
+#include "results/ResultsStore.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @class BasicEventLoop
+ * @brief Orchestrates the entire backtesting process.
+ *
+ * This class owns all the core components of the trading system and drives
+ * the simulation forward, one data bar at a time. The component types are
+ * template parameters: EventLoop (EventLoop.h) instantiates it with the
+ * interfaces, so any component can be plugged in at run time through virtual
+ * calls; a fixed configuration can name its concrete classes instead (eg
+ * BasicEventLoop<InMemoryBarProvider, ISignalSource, PortfolioRiskManager,
+ * BacktestExecutionHandler>), and the per-bar calls into those are resolved at
+ * compile time and can be inlined. Concrete classes are declared `final` for
+ * this; a class that is not still dispatches virtually through its own type.
+ * Every stage of every bar is timed into a latency histogram; the summary is
+ * logged when the run ends, as are the run's performance statistics, which
+ * are kept in constant memory as the bars go by (see PerformanceAnalytics).
+ * With a results recorder attached, every fill and each bar's equity, cash
+ * and peak are recorded as well.
+ *
+ * Checkpoints: with enable_checkpoints(), the state of the run (portfolio,
+ * peak, latest prices, analytics, the data position and each component's
+ * save_state()) is serialized into memory at the end of every Nth bar and
+ * written to disk by a background thread. restore_checkpoint() loads it into
+ * a freshly constructed loop, which then continues from the bar after the
+ * checkpoint and finishes exactly as the uninterrupted run would have.
+ */
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+class BasicEventLoop {
+public:
+    /**
+     * @brief Constructs the loop, taking ownership of all components.
+     * This uses dependency injection to decouple the loop from concrete implementations.
+     */
+    BasicEventLoop(
+        std::unique_ptr<DataP> data_provider,
+        std::unique_ptr<SignalS> signal_source,
+        std::unique_ptr<RiskM> risk_manager,
+        std::unique_ptr<ExecH> execution_handler,
+        std::unique_ptr<Portfolio> portfolio
+    );
+
+    /**
+     * @brief Records this run's fills and per-bar equity curve; call before run_backtest().
+     * Also hands the recorder to the execution handler, and finishes it when the run ends.
+     */
+    void set_results_recorder(std::shared_ptr<ResultsRecorder> recorder);
+
+    /**
+     * @brief Writes a checkpoint to `path` every `every_bars` bars; call before run_backtest().
+     * Capturing costs the bar loop one in-memory copy of the state; the file is written in the background.
+     * @throws std::invalid_argument if `every_bars` is 0.
+     */
+    void enable_checkpoints(const std::string& path, std::uint64_t every_bars);
+
+    /**
+     * @brief Restores the run saved at `path` and positions the data provider
+     * after its last bar. Call on a new loop, built with the same components
+     * and settings, before run_backtest().
+     * @throws std::runtime_error if the checkpoint is unreadable or does not match the components.
+     */
+    void restore_checkpoint(const std::string& path);
+
+    // Appends a snapshot of the run's state as of the last completed bar to `out`.
+    void save_state(std::vector<std::uint8_t>& out) const;
+
+    // The main entry point to start the simulation.
+    void run_backtest();
+
+    /**
+     * @brief Runs the same components against a live feed (eg ZmqBarSubscriber)
+     * until it ends. Each bar is processed the moment it arrives, never
+     * pipelined behind later ones, and the time from its arrival to the order
+     * decision is recorded as `tick_to_decision` (and, without the signal
+     * round trip, as `engine_overhead`) alongside the stage histograms.
+     */
+    void run_live();
+
+    /**
+     * @brief run_backtest() with its stages on three threads joined by bounded
+     * SPSC queues: bar decoding, then signal dispatch and collection (the
+     * source sees the same calls in the same order as in run_backtest()), then
+     * mark-to-market, risk and execution on the calling thread. Only the first
+     * stage is ahead in time; the portfolio still sees one bar at a time, so
+     * the results are identical to run_backtest() bar for bar. The decoder
+     * stalls when `queue_capacity` bars are in flight.
+     * @throws std::runtime_error If checkpoints are enabled, or a bar's symbol
+     *         was not interned before the run (file-backed providers intern at construction).
+     */
+    void run_pipelined_backtest(std::size_t queue_capacity = 1024);
+
+    // --- Results (meaningful once run_backtest() has returned) ---
+    const Portfolio& get_portfolio() const { return *m_portfolio; }
+    double get_peak_portfolio_value() const { return m_peak_portfolio_value; }
+    const MetricsReport& get_metrics() const { return m_metrics; }
+    const PerformanceSummary& get_performance() const { return m_analytics.summary(); }
+
+    /**
+     * @brief Writes the performance summary, the stage metrics, and the data provider's and
+     * signal source's if they have any, as JSON.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void write_metrics_json(const std::string& path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // --- Core Components ---
+    std::unique_ptr<DataP> m_data_provider;
+    std::unique_ptr<SignalS> m_signal_source;
+    std::unique_ptr<RiskM> m_risk_manager;
+    std::unique_ptr<ExecH> m_execution_handler;
+    std::unique_ptr<Portfolio> m_portfolio;
+
+    // Interns the bar's symbol unless the data provider already tagged it.
+    SymbolId resolve_symbol(const DataBar& bar);
+
+    // Serializes the state and hands it to the checkpoint writer.
+    void capture_checkpoint();
+
+    struct BarTiming {
+        Clock::time_point decided_at; // Execution done
+        Clock::duration signal_time;  // Spent in the signal source
+    };
+
+    // Steps 2-6 for one bar whose signal request was sent, then the bookkeeping after it.
+    // `signalled_weights`: the bar's signals, if already collected (pipelined run); swapped out.
+    BarTiming process_bar(const DataBar& bar, Clock::time_point bar_start,
+                          WeightVector* signalled_weights = nullptr);
+
+    // The final mark-to-market and the end-of-run reports.
+    void finish_run(const char* run_name);
+
+    // --- Backtest State ---
+    std::shared_ptr<SymbolRegistry> m_registry; // Shared with the portfolio
+    double m_peak_portfolio_value;
+    PriceVector m_latest_prices;                // Indexed by SymbolId, 0.0 = no price yet
+    WeightVector m_target_weights;              // Reused every bar
+    std::vector<std::optional<DataBar>> m_pending_bars; // Ring: sent to the signal source, not yet processed
+    std::shared_ptr<ResultsRecorder> m_results; // Optional
+    PerformanceAnalytics m_analytics;
+
+    // --- Checkpoints ---
+    std::uint64_t m_last_timestamp_ns = 0;      // Of the last completed bar
+    std::uint64_t m_bars_at_last_timestamp = 0; // Completed bars carrying that timestamp
+    std::unique_ptr<CheckpointWriter> m_checkpoint_writer; // Optional
+    std::uint64_t m_checkpoint_every_bars = 0;
+    std::uint64_t m_bars_since_checkpoint = 0;
+    std::vector<std::uint8_t> m_checkpoint_buffer; // Reused, swapped with the writer's
+
+    // --- Instrumentation ---
+    MetricsReport m_metrics{"EventLoop stages"};
+    LatencyHistogram& m_next_bar_latency = m_metrics.histogram("get_next_bar");
+    LatencyHistogram& m_mark_to_market_latency = m_metrics.histogram("mark_to_market");
+    LatencyHistogram& m_signal_latency = m_metrics.histogram("signal_round_trip");
+    LatencyHistogram& m_risk_latency = m_metrics.histogram("validate_target");
+    LatencyHistogram& m_execution_latency = m_metrics.histogram("execute_trades");
+    LatencyHistogram& m_bar_latency = m_metrics.histogram("bar_total");
+    std::uint64_t& m_bars_processed = m_metrics.counter("bars_processed");
+};
+
+// --- Implementation ---
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+BasicEventLoop<DataP, SignalS, RiskM, ExecH>::BasicEventLoop(
+    std::unique_ptr<DataP> data_provider,
+    std::unique_ptr<SignalS> signal_source,
+    std::unique_ptr<RiskM> risk_manager,
+    std::unique_ptr<ExecH> execution_handler,
+    std::unique_ptr<Portfolio> portfolio)
+    : m_data_provider(std::move(data_provider)),
+      m_signal_source(std::move(signal_source)),
+      m_risk_manager(std::move(risk_manager)),
+      m_execution_handler(std::move(execution_handler)),
+      m_portfolio(std::move(portfolio)),
+      m_registry(m_portfolio->registry()),
+      m_peak_portfolio_value(m_portfolio->get_total_value()), // Initialize peak value
+      m_analytics(m_portfolio->get_total_value())
+{}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+SymbolId BasicEventLoop<DataP, SignalS, RiskM, ExecH>::resolve_symbol(const DataBar& bar) {
+    SymbolId id = bar.symbol_id != kInvalidSymbolId ? bar.symbol_id : m_registry->intern(bar.symbol);
+    if (id >= m_latest_prices.size()) {
+        m_latest_prices.resize(m_registry->size(), 0.0);
+    }
+    return id;
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::set_results_recorder(std::shared_ptr<ResultsRecorder> recorder) {
+    m_execution_handler->set_results_recorder(recorder);
+    m_results = std::move(recorder);
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::enable_checkpoints(const std::string& path, std::uint64_t every_bars) {
+    if (every_bars == 0) {
+        throw std::invalid_argument("Checkpoint interval must be at least one bar");
+    }
+    m_checkpoint_writer = std::make_unique<CheckpointWriter>(path);
+    m_checkpoint_every_bars = every_bars;
+    m_bars_since_checkpoint = 0;
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::save_state(std::vector<std::uint8_t>& out) const {
+    StateWriter writer(out);
+
+    writer.begin_section(section_tag("ENGN"));
+    writer.write(m_peak_portfolio_value);
+    writer.write(m_bars_processed);
+    writer.write(m_last_timestamp_ns);
+    writer.write(m_bars_at_last_timestamp);
+    writer.write_vector(m_latest_prices);
+    writer.end_section();
+
+    // Ids are assigned in interning order; a restore re-interns in the same order
+    writer.begin_section(section_tag("SYMS"));
+    writer.write<std::uint64_t>(m_registry->size());
+    for (SymbolId id = 0; id < m_registry->size(); ++id) {
+        writer.write_string(m_registry->name(id));
+    }
+    writer.end_section();
+
+    writer.begin_section(section_tag("PORT"));
+    m_portfolio->save_state(writer);
+    writer.end_section();
+
+    writer.begin_section(section_tag("PERF"));
+    m_analytics.save_state(writer);
+    writer.end_section();
+
+    writer.begin_section(section_tag("SGNL"));
+    m_signal_source->save_state(writer);
+    writer.end_section();
+
+    writer.begin_section(section_tag("RISK"));
+    m_risk_manager->save_state(writer);
+    writer.end_section();
+
+    writer.begin_section(section_tag("EXEC"));
+    m_execution_handler->save_state(writer);
+    writer.end_section();
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::capture_checkpoint() {
+    m_checkpoint_buffer.clear();
+    save_state(m_checkpoint_buffer);
+    m_checkpoint_writer->submit(m_checkpoint_buffer);
+    m_bars_since_checkpoint = 0;
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::restore_checkpoint(const std::string& path) {
+    const std::vector<std::uint8_t> snapshot = read_checkpoint_file(path);
+    StateReader reader(snapshot);
+
+    StateReader engine = reader.section(section_tag("ENGN"), "engine");
+    engine.read(m_peak_portfolio_value);
+    engine.read(m_bars_processed);
+    engine.read(m_last_timestamp_ns);
+    engine.read(m_bars_at_last_timestamp);
+    engine.read_vector(m_latest_prices);
+    engine.expect_end("engine");
+
+    StateReader symbols = reader.section(section_tag("SYMS"), "symbol");
+    const auto symbol_count = symbols.read<std::uint64_t>();
+    for (std::uint64_t id = 0; id < symbol_count; ++id) {
+        const std::string name = symbols.read_string();
+        if (m_registry->intern(name) != id) {
+            throw std::runtime_error("Checkpoint symbol " + name + " has a different id in this run");
+        }
+    }
+    symbols.expect_end("symbol");
+
+    StateReader portfolio = reader.section(section_tag("PORT"), "portfolio");
+    m_portfolio->restore_state(portfolio);
+    portfolio.expect_end("portfolio");
+
+    StateReader analytics = reader.section(section_tag("PERF"), "performance");
+    m_analytics.restore_state(analytics);
+    analytics.expect_end("performance");
+
+    StateReader signal = reader.section(section_tag("SGNL"), "signal source");
+    m_signal_source->restore_state(signal);
+    signal.expect_end("signal source");
+
+    StateReader risk = reader.section(section_tag("RISK"), "risk manager");
+    m_risk_manager->restore_state(risk);
+    risk.expect_end("risk manager");
+
+    StateReader execution = reader.section(section_tag("EXEC"), "execution handler");
+    m_execution_handler->restore_state(execution);
+    execution.expect_end("execution handler");
+    reader.expect_end("checkpoint");
+
+    if (m_bars_at_last_timestamp > 0) {
+        m_data_provider->resume_after(m_last_timestamp_ns, m_bars_at_last_timestamp);
+    }
+    LOG_INFO("EventLoop", "Resumed from {} after {} bars, portfolio value ${}",
+             path, m_bars_processed, m_portfolio->get_total_value());
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::run_backtest() {
+    LOG_INFO("EventLoop", "--- Backtest Starting ---");
+    LOG_INFO("EventLoop", "Initial Portfolio Value: ${}", m_portfolio->get_total_value());
+
+    // Sources that pipeline requests see bars ahead of the one being processed.
+    // Results still come back in bar order, so this never changes the outcome.
+    const std::size_t pipeline_depth = std::max<std::size_t>(1, m_signal_source->pipeline_depth());
+    // A fixed ring rather than a queue, so the bar loop never allocates
+    m_pending_bars.resize(pipeline_depth);
+    std::size_t pending_head = 0;
+    std::size_t pending_count = 0;
+
+    while (true) {
+        const auto bar_start = Clock::now();
+
+        // 1. Get the latest data bar, keeping the signal pipeline full
+        while (pending_count < pipeline_depth) {
+            const auto fetch_start = Clock::now();
+            auto optional_bar = m_data_provider->get_next_bar();
+            m_next_bar_latency.record(Clock::now() - fetch_start);
+            if (!optional_bar) {
+                break;
+            }
+            // The signal source picks the wire encoding (binary or JSON) per model
+            m_signal_source->update_market_bar(*optional_bar);
+            m_pending_bars[(pending_head + pending_count++) % pipeline_depth] = std::move(optional_bar);
+        }
+        if (pending_count == 0) {
+            break;
+        }
+
+        process_bar(*m_pending_bars[pending_head], bar_start);
+        pending_head = (pending_head + 1) % pipeline_depth;
+        --pending_count;
+    }
+
+    finish_run("Backtest");
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::run_live() {
+    LOG_INFO("EventLoop", "--- Live Run Starting ---");
+    LOG_INFO("EventLoop", "Initial Portfolio Value: ${}", m_portfolio->get_total_value());
+
+    // Measured from the moment each bar reached the process
+    LatencyHistogram& tick_to_decision = m_metrics.histogram("tick_to_decision");
+    LatencyHistogram& engine_overhead = m_metrics.histogram("engine_overhead"); // Minus the signal round trip
+
+    while (true) {
+        // 1. Wait for the next bar; waiting for the feed is not engine time
+        auto optional_bar = m_data_provider->get_next_bar();
+        const auto returned = Clock::now();
+        if (!optional_bar) {
+            break;
+        }
+        const auto arrival = m_data_provider->last_arrival().value_or(returned);
+        m_next_bar_latency.record(returned - arrival);
+
+        // Each bar is decided before the next is read: no pipelining, a live bar never waits
+        m_signal_source->update_market_bar(*optional_bar);
+        const BarTiming timing = process_bar(*optional_bar, arrival);
+        tick_to_decision.record(timing.decided_at - arrival);
+        engine_overhead.record(timing.decided_at - arrival - timing.signal_time);
+    }
+
+    finish_run("Live run");
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::run_pipelined_backtest(std::size_t queue_capacity) {
+    if (m_checkpoint_writer) {
+        throw std::runtime_error("Checkpoints need the sequential loop: pipeline stages are never at the same bar");
+    }
+    // The signal stage holds up to pipeline_depth slots; one more keeps the decoder moving
+    const std::size_t pipeline_depth = std::max<std::size_t>(1, m_signal_source->pipeline_depth());
+    queue_capacity = std::max(queue_capacity, pipeline_depth + 1);
+    LOG_INFO("EventLoop", "--- Backtest Starting (pipelined, {} bars in flight) ---", queue_capacity);
+    LOG_INFO("EventLoop", "Initial Portfolio Value: ${}", m_portfolio->get_total_value());
+
+    // One slot per bar in flight. Stages pass slot indices; the slots themselves
+    // (bar and weight buffers) are reused, so the steady state never allocates.
+    struct Slot {
+        std::optional<DataBar> bar;
+        WeightVector weights;
+    };
+    constexpr std::size_t kEndOfStream = std::numeric_limits<std::size_t>::max();
+    std::vector<Slot> slots(queue_capacity);
+    SpscQueue<std::size_t> free_slots(queue_capacity + 1); // Stage 3 -> 1
+    SpscQueue<std::size_t> decoded(queue_capacity + 1);    // Stage 1 -> 2
+    SpscQueue<std::size_t> signalled(queue_capacity + 1);  // Stage 2 -> 3
+    for (std::size_t i = 0; i < queue_capacity; ++i) {
+        free_slots.try_push(i);
+    }
+
+    // A failing stage stops the others; the first error is rethrown once all have stopped
+    std::atomic<bool> stop{false};
+    std::exception_ptr errors[3];
+    const auto pop_wait = [&](SpscQueue<std::size_t>& queue) -> std::optional<std::size_t> {
+        while (true) {
+            if (auto index = queue.try_pop()) {
+                return index;
+            }
+            if (stop.load(std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            std::this_thread::yield();
+        }
+    };
+    // Queues hold every slot plus the end marker, so a push always succeeds
+    const auto push = [](SpscQueue<std::size_t>& queue, std::size_t index) { queue.try_push(index); };
+
+    // Stage 1: decode bars and resolve their ids; waits for a free slot (backpressure)
+    std::thread decode_stage([&] {
+        try {
+            while (auto index = pop_wait(free_slots)) {
+                const auto fetch_start = Clock::now();
+                auto optional_bar = m_data_provider->get_next_bar();
+                m_next_bar_latency.record(Clock::now() - fetch_start);
+                if (!optional_bar) {
+                    push(decoded, kEndOfStream);
+                    return;
+                }
+                // Interning here would race with the other stages' reads of the registry
+                if (optional_bar->symbol_id == kInvalidSymbolId) {
+                    optional_bar->symbol_id = m_registry->find(optional_bar->symbol);
+                    if (optional_bar->symbol_id == kInvalidSymbolId) {
+                        throw std::runtime_error("Pipelined run got a bar of " + optional_bar->symbol +
+                                                 ", which was not interned before the run");
+                    }
+                }
+                slots[*index].bar = std::move(*optional_bar);
+                push(decoded, *index);
+            }
+        } catch (...) {
+            errors[0] = std::current_exception();
+            stop.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    // Stage 2: send requests and collect signals, with the source's pipeline
+    // filled exactly as run_backtest() fills it, so it sees the same calls
+    std::thread signal_stage([&] {
+        try {
+            std::vector<std::size_t> pending(pipeline_depth); // Ring of slot indices, oldest at pending_head
+            std::size_t pending_head = 0;
+            std::size_t pending_count = 0;
+            bool input_done = false;
+            while (true) {
+                while (!input_done && pending_count < pipeline_depth) {
+                    const auto index = pop_wait(decoded);
+                    if (!index) {
+                        return; // Stopped
+                    }
+                    if (*index == kEndOfStream) {
+                        input_done = true;
+                        break;
+                    }
+                    m_signal_source->update_market_bar(*slots[*index].bar);
+                    pending[(pending_head + pending_count++) % pipeline_depth] = *index;
+                }
+                if (pending_count == 0) {
+                    push(signalled, kEndOfStream);
+                    return;
+                }
+
+                const std::size_t index = pending[pending_head];
+                pending_head = (pending_head + 1) % pipeline_depth;
+                --pending_count;
+                const auto signal_start = Clock::now();
+                m_signal_source->get_target_weights(*m_registry, slots[index].weights);
+                m_signal_latency.record(Clock::now() - signal_start);
+                push(signalled, index);
+            }
+        } catch (...) {
+            errors[1] = std::current_exception();
+            stop.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    // Stage 3 (this thread): mark-to-market, risk, execution and the portfolio
+    try {
+        while (const auto index = pop_wait(signalled)) {
+            if (*index == kEndOfStream) {
+                break;
+            }
+            Slot& slot = slots[*index];
+            process_bar(*slot.bar, Clock::now(), &slot.weights);
+            push(free_slots, *index);
+        }
+    } catch (...) {
+        errors[2] = std::current_exception();
+        stop.store(true, std::memory_order_relaxed);
+    }
+    decode_stage.join();
+    signal_stage.join();
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    finish_run("Backtest");
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+auto BasicEventLoop<DataP, SignalS, RiskM, ExecH>::process_bar(const DataBar& bar, Clock::time_point bar_start,
+                                                        WeightVector* signalled_weights) -> BarTiming {
+    const SymbolId bar_symbol = resolve_symbol(bar);
+    m_latest_prices[bar_symbol] = bar.close; // Update the latest known price
+    if (m_results) {
+        m_results->begin_bar(bar.timestamp);
+    }
+
+    // 2. Update Portfolio Value (Mark-to-Market): only this symbol's price moved
+    const auto mark_start = Clock::now();
+    m_portfolio->mark_price(bar_symbol, bar.close);
+    double current_value = m_portfolio->get_total_value();
+
+    // 3. Update Historical Peak Value for Drawdown Calculation
+    if (current_value > m_peak_portfolio_value) {
+        m_peak_portfolio_value = current_value;
+    }
+
+    // 4. Get Signals (for the oldest pending bar, i.e. this one), unless a pipeline stage already did
+    const auto signal_start = Clock::now();
+    m_mark_to_market_latency.record(signal_start - mark_start);
+    if (signalled_weights) {
+        m_target_weights.swap(*signalled_weights); // The stage gets the old buffer back to refill
+    } else {
+        m_signal_source->get_target_weights(*m_registry, m_target_weights);
+    }
+    const auto risk_start = Clock::now();
+    if (!signalled_weights) {
+        m_signal_latency.record(risk_start - signal_start);
+    }
+
+    // 5. Manage Risk (rewrites the target weights in place)
+    m_risk_manager->on_market_bar(bar_symbol, bar);
+    m_risk_manager->validate_target_weights(
+        *m_portfolio,
+        m_peak_portfolio_value,
+        *m_registry,
+        m_target_weights
+    );
+    const auto execution_start = Clock::now();
+    m_risk_latency.record(execution_start - risk_start);
+
+    // 6. Execute Trades
+    m_execution_handler->on_market_bar(bar_symbol, bar);
+    m_execution_handler->execute_target_weights(
+        *m_portfolio,
+        *m_registry,
+        m_target_weights,
+        m_latest_prices
+    );
+    const auto decided_at = Clock::now();
+    m_execution_latency.record(decided_at - execution_start);
+
+    m_portfolio->publish(); // Monitoring threads see the state as of this bar's end
+    m_analytics.on_bar(bar.timestamp, *m_portfolio, m_peak_portfolio_value);
+    if (m_results) {
+        // A copy onto a ring; the store's thread does the writing
+        m_results->record_equity(m_portfolio->get_total_value(), m_portfolio->get_cash(), m_peak_portfolio_value);
+    }
+    m_bar_latency.record(Clock::now() - bar_start);
+    ++m_bars_processed;
+
+    const std::uint64_t timestamp_ns = TimeRange::to_epoch_ns(bar.timestamp);
+    if (timestamp_ns == m_last_timestamp_ns) {
+        ++m_bars_at_last_timestamp;
+    } else {
+        m_last_timestamp_ns = timestamp_ns;
+        m_bars_at_last_timestamp = 1;
+    }
+    if (m_checkpoint_writer && ++m_bars_since_checkpoint >= m_checkpoint_every_bars) {
+        capture_checkpoint();
+    }
+
+    // Log portfolio value at each step
+    LOG_DEBUG("EventLoop", "{} Value: ${}", bar.symbol, current_value);
+
+    return {decided_at, risk_start - signal_start};
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::finish_run(const char* run_name) {
+    // Final full mark-to-market, free of any incremental rounding
+    m_portfolio->recalculate_total_value(m_latest_prices);
+    if (m_results) {
+        m_results->finish(*m_registry);
+    }
+
+    LOG_INFO("EventLoop", "--- {} Finished ---", run_name);
+    LOG_INFO("EventLoop", "Final Portfolio Value: ${}", m_portfolio->get_total_value());
+
+    m_analytics.finish().log_summary();
+
+    if (m_checkpoint_writer) {
+        m_checkpoint_writer->flush();
+        LOG_INFO("EventLoop", "Checkpoints written to {}: {} ({} superseded before writing)",
+                 m_checkpoint_writer->path(), m_checkpoint_writer->written(), m_checkpoint_writer->replaced());
+    }
+
+    m_metrics.log_summary();
+    if (const MetricsReport* provider_metrics = m_data_provider->metrics()) {
+        provider_metrics->log_summary();
+    }
+    if (const MetricsReport* source_metrics = m_signal_source->metrics()) {
+        source_metrics->log_summary();
+    }
+}
+
+template <DataProvider DataP, SignalSource SignalS, RiskManager RiskM, ExecutionHandler ExecH>
+void BasicEventLoop<DataP, SignalS, RiskM, ExecH>::write_metrics_json(const std::string& path) const {
+    nlohmann::json document = {{"performance", m_analytics.summary().to_json()}, {"engine", m_metrics.to_json()}};
+    if (const MetricsReport* provider_metrics = m_data_provider->metrics()) {
+        document["data_provider"] = provider_metrics->to_json();
+    }
+    if (const MetricsReport* source_metrics = m_signal_source->metrics()) {
+        document["signal_source"] = source_metrics->to_json();
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open metrics output " + path);
+    }
+    file << document.dump(2) << '\n';
+}
@@ -0,0 +1,209 @@
+// include/checkpoint/Checkpoint.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file Checkpoint.h
+ * @brief Binary engine snapshots: the state serializer and the checkpoint file.
+ *
+ * A snapshot is a sequence of sections, one per component, each tagged with
+ * a four-character code and prefixed with its length, so a checkpoint taken
+ * with a different component (eg another execution handler) is rejected
+ * instead of misread. Values are stored in native byte order and layout:
+ * a checkpoint is meant to be resumed by the same engine build.
+ *
+ * File layout: CheckpointFileHeader, then the snapshot bytes. The header
+ * carries the payload size and its CRC32. Files are written to a temporary
+ * name and renamed into place, so a crash mid-write leaves the previous
+ * checkpoint intact.
+ */
+
+inline constexpr char kCheckpointMagic[4] = {'E', 'C', 'K', 'P'};
+inline constexpr std::uint32_t kCheckpointVersion = 1;
+
+struct CheckpointFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t payload_size;
+    std::uint32_t payload_crc32;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(CheckpointFileHeader) == 24, "CheckpointFileHeader must match the checkpoint layout");
+
+// A section tag from four characters, eg section_tag("PORT").
+constexpr std::uint32_t section_tag(const char (&code)[5]) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(code[0])) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(code[1])) << 8 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(code[2])) << 16 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(code[3])) << 24;
+}
+
+/**
+ * @class StateWriter
+ * @brief Appends component state to a snapshot buffer.
+ */
+class StateWriter {
+public:
+    // Appends to `buffer`, whose existing capacity is reused.
+    explicit StateWriter(std::vector<std::uint8_t>& buffer) : m_buffer(buffer) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateWriter::write needs a trivially copyable type");
+        append(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void write_vector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateWriter::write_vector needs a trivially copyable type");
+        write<std::uint64_t>(values.size());
+        append(values.data(), values.size() * sizeof(T));
+    }
+
+    void write_vector(const std::vector<bool>& values) {
+        write<std::uint64_t>(values.size());
+        for (bool value : values) {
+            write<std::uint8_t>(value ? 1 : 0);
+        }
+    }
+
+    void write_string(std::string_view value) {
+        write<std::uint64_t>(value.size());
+        append(value.data(), value.size());
+    }
+
+    // Starts a tagged section; every write up to end_section() belongs to it.
+    void begin_section(std::uint32_t tag) {
+        write(tag);
+        m_section_start = m_buffer.size();
+        write<std::uint64_t>(0); // Length, patched by end_section()
+    }
+
+    void end_section() {
+        const std::uint64_t length = m_buffer.size() - m_section_start - sizeof(std::uint64_t);
+        std::memcpy(m_buffer.data() + m_section_start, &length, sizeof(length));
+    }
+
+private:
+    void append(const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    std::vector<std::uint8_t>& m_buffer;
+    std::size_t m_section_start = 0;
+};
+
+/**
+ * @class StateReader
+ * @brief Reads component state back from a snapshot, in the order it was written.
+ * Every read is bounds-checked.
+ * @throws std::runtime_error On a truncated snapshot or an unexpected section.
+ */
+class StateReader {
+public:
+    explicit StateReader(std::span<const std::uint8_t> data) : m_data(data) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "StateReader::read needs a trivially copyable type");
+        T value;
+        copy_out(&value, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void read(T& value) { value = read<T>(); }
+
+    template <typename T>
+    void read_vector(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateReader::read_vector needs a trivially copyable type");
+        const std::uint64_t count = read_count(sizeof(T));
+        values.resize(count);
+        copy_out(values.data(), count * sizeof(T));
+    }
+
+    void read_vector(std::vector<bool>& values) {
+        const std::uint64_t count = read_count(1);
+        values.resize(count);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            values[i] = read<std::uint8_t>() != 0;
+        }
+    }
+
+    std::string read_string() {
+        const std::uint64_t size = read_count(1);
+        std::string value(size, '\0');
+        copy_out(value.data(), size);
+        return value;
+    }
+
+    /**
+     * @brief Returns a reader over the next section, which must carry `tag`.
+     * @param name Used in the error message.
+     */
+    StateReader section(std::uint32_t tag, std::string_view name) {
+        if (read<std::uint32_t>() != tag) {
+            throw std::runtime_error("Checkpoint has no " + std::string(name) + " state where expected "
+                                     "(was it taken with other components?)");
+        }
+        const std::uint64_t length = read_count(1);
+        StateReader inner(m_data.subspan(m_offset, length));
+        m_offset += length;
+        return inner;
+    }
+
+    // Throws unless everything was read: the state's writer and reader disagree otherwise.
+    void expect_end(std::string_view name) const {
+        if (m_offset != m_data.size()) {
+            throw std::runtime_error("Checkpoint " + std::string(name) + " state has " +
+                                     std::to_string(m_data.size() - m_offset) + " unread bytes");
+        }
+    }
+
+private:
+    std::uint64_t read_count(std::size_t element_size) {
+        const auto count = read<std::uint64_t>();
+        if (count > (m_data.size() - m_offset) / element_size) {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        return count;
+    }
+
+    void copy_out(void* destination, std::size_t size) {
+        if (size > m_data.size() - m_offset) {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        if (size > 0) {
+            std::memcpy(destination, m_data.data() + m_offset, size);
+        }
+        m_offset += size;
+    }
+
+    std::span<const std::uint8_t> m_data;
+    std::size_t m_offset = 0;
+};
+
+/**
+ * @brief Writes `snapshot` as the checkpoint at `path`, replacing any previous one atomically.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void write_checkpoint_file(const std::string& path, std::span<const std::uint8_t> snapshot);
+
+/**
+ * @brief Reads and validates (magic, version, size, CRC32) the checkpoint at `path`.
+ * @return The snapshot bytes.
+ * @throws std::runtime_error If the file is missing, truncated or corrupt.
+ */
+std::vector<std::uint8_t> read_checkpoint_file(const std::string& path);
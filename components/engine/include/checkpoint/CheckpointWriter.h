@@ -0,0 +1,63 @@
+// include/checkpoint/CheckpointWriter.h
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class CheckpointWriter
+ * @brief Writes snapshots to a checkpoint file on a background thread.
+ *
+ * The engine serializes its state into memory (a copy of a few vectors) and
+ * hands the buffer over with submit(); the file I/O happens on this class's
+ * thread. submit() never waits for the disk: if the previous snapshot is
+ * still queued it is replaced by the newer one, since only the latest
+ * checkpoint matters. Write errors are logged, and the next snapshot tries again.
+ */
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::string path);
+
+    // Writes the queued snapshot, if any, then stops.
+    ~CheckpointWriter();
+
+    /**
+     * @brief Queues `snapshot` for writing. Swaps buffers with the writer, so
+     * `snapshot` comes back holding an older buffer (cleared) whose capacity
+     * the next snapshot can reuse.
+     */
+    void submit(std::vector<std::uint8_t>& snapshot);
+
+    // Blocks until every submitted snapshot has been written or replaced.
+    void flush();
+
+    const std::string& path() const { return m_path; }
+    std::uint64_t written() const;
+    std::uint64_t replaced() const; // Superseded before they were written
+
+    // --- Safety: Disallow copy/move ---
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+private:
+    void writer_loop();
+
+    const std::string m_path;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_idle;
+    std::vector<std::uint8_t> m_queued;
+    bool m_has_queued = false;
+    bool m_writing = false;
+    bool m_stop = false;
+    std::uint64_t m_written = 0;
+    std::uint64_t m_replaced = 0;
+
+    std::thread m_thread;
+};
@@ -0,0 +1,11 @@
+// include/core/CpuAffinity.h
+
+#pragma once
+
+/**
+ * @brief Pins the calling thread to one CPU, eg the engine thread of a live
+ * run to a core isolated from the scheduler (isolcpus), so busy-polling
+ * never migrates or shares its cache.
+ * @return false if pinning failed or is not supported on this platform (logged).
+ */
+bool pin_current_thread(int cpu);
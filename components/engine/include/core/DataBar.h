@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "core/SymbolId.h"
 #include <string>
 #include <cstdint>
 #include <chrono>
@@ -14,8 +15,10 @@ struct DataBar {
     double low;
     double close;
     uint64_t volume;                                                 // Volume
+    SymbolId symbol_id;                                              // Interned id, or kInvalidSymbolId if unresolved
 
-    DataBar(const std::string& sym, std::chrono::time_point<std::chrono::system_clock> ts, double o, double h, double l, double c, uint64_t vol)
-        : symbol(sym), timestamp(ts), open(o), high(h), low(l), close(c), volume(vol) {}
+    DataBar(const std::string& sym, std::chrono::time_point<std::chrono::system_clock> ts, double o, double h, double l, double c, uint64_t vol,
+            SymbolId id = kInvalidSymbolId)
+        : symbol(sym), timestamp(ts), open(o), high(h), low(l), close(c), volume(vol), symbol_id(id) {}
 
-};
\ No newline at end of file
+};
@@ -2,27 +2,181 @@
 
 #pragma once
 
+#include "core/SymbolRegistry.h"
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
-#include <mutex>
+#include <vector>
 
+class StateWriter;
+class StateReader;
+
+/**
+ * @brief A consistent copy of a Portfolio as of its latest publish.
+ */
+struct PortfolioSnapshot {
+    std::uint64_t version = 0;         // Number of publishes so far; equal versions mean equal state
+    double cash = 0.0;
+    double total_value = 0.0;
+    std::vector<long long> positions;  // Shares held, indexed by SymbolId
+};
+
+/**
+ * @class Portfolio
+ * @brief Tracks cash, holdings and the mark-to-market value of the account.
+ *
+ * Market value is kept incrementally. Every position is valued at its
+ * symbol's last marked price: mark_price() applies one symbol's price delta
+ * and update_holding() applies a fill's quantity delta, both in O(1), so the
+ * total value is always current without walking the holdings. Every
+ * `revalue_interval` marks the market value is re-summed from scratch to keep
+ * floating-point drift bounded; recalculate_total_value() does the same
+ * against a full price set.
+ *
+ * Single writer: the mutators and the plain getters belong to the engine
+ * thread and take no locks. Any other thread (monitoring, reporting) must read
+ * through snapshot() instead. Snapshots come from a seqlock-protected copy that
+ * the writer republishes with publish() (the EventLoop does so at the end of
+ * every bar) and in recalculate_total_value(), so they are always taken at a
+ * bar boundary. Readers never block the writer; a reader that overlaps a
+ * publish simply retries.
+ */
 class Portfolio {
 public:
     explicit Portfolio(double initial_cash);
 
-    double get_cash() const;
-    double get_total_value() const;
+    /**
+     * @brief Constructs a portfolio whose positions are keyed by `registry` ids.
+     * Share the registry with the data provider so both agree on ids.
+     */
+    Portfolio(double initial_cash, std::shared_ptr<SymbolRegistry> registry);
+
+    static constexpr std::size_t kDefaultRevalueInterval = 4096;
+
+    // --- Writer thread only ---
+    double get_cash() const { return m_cash; }
+    double get_total_value() const { return m_cash + m_market_value; }
+    double get_market_value() const { return m_market_value; }
+    double get_gross_exposure() const { return m_gross_exposure; } // Sum of |position| x mark, kept like the market value
     std::map<std::string, long long> get_holdings() const;
     long long get_position(const std::string& symbol) const;
+    long long get_position(SymbolId id) const { return id < m_positions.size() ? m_positions[id] : 0; }
 
-    void update_cash(double amount);
+    // Ids with a non-zero position, in no particular order. Kept up to date by update_holding().
+    const std::vector<SymbolId>& held_ids() const { return m_held_ids; }
+
+    /**
+     * @brief Writes the ids a trade toward `target_weights` can touch into `out`:
+     * every held id and every id with a non-zero weight, ascending. Reuses `out`.
+     */
+    void tradable_ids(const WeightVector& target_weights, std::vector<SymbolId>& out) const;
+
+    void update_cash(double amount) { m_cash += amount; }
     void update_holding(const std::string& symbol, long long quantity);
+    void update_holding(SymbolId id, long long quantity);
+
+    // Fills applied through update_holding() so far, and their value at the mark (slippage excluded).
+    std::uint64_t get_fill_count() const { return m_fill_count; }
+    double get_traded_notional() const { return m_traded_notional; }
+
+    /**
+     * @brief Marks one symbol to a new price, adjusting the market value by the
+     * position times the price change. O(1).
+     */
+    void mark_price(SymbolId id, double price);
+
+    // Full mark-to-market: adopts every given price, then re-sums the market value.
     void recalculate_total_value(const std::map<std::string, double>& latest_prices);
+    void recalculate_total_value(const PriceVector& latest_prices);
+
+    // Re-sums the market value from the current marks, discarding accumulated rounding.
+    void revalue();
+
+    // How many mark_price() calls between automatic revalue()s (0 = never).
+    void set_revalue_interval(std::size_t marks) { m_revalue_interval = marks; }
+
+    /**
+     * @brief Makes the current state visible to snapshot(). Called automatically
+     * by recalculate_total_value(); call it directly after other mutations only.
+     */
+    void publish();
+
+    /**
+     * @brief Checkpointing: cash, positions, marks and the incremental sums,
+     * exactly, so a restored portfolio continues bit for bit. restore_state()
+     * publishes the restored state.
+     */
+    void save_state(StateWriter& writer) const;
+    void restore_state(StateReader& reader);
+
+    // --- Any thread ---
+    /**
+     * @brief Copies the latest published state into `out`, reusing its storage.
+     * Lock-free; retries while a publish is in progress.
+     */
+    void snapshot(PortfolioSnapshot& out) const;
+    PortfolioSnapshot snapshot() const;
+
+    const std::shared_ptr<SymbolRegistry>& registry() const { return m_registry; }
+
+    // --- Safety: Disallow copy/move ---
+    Portfolio(const Portfolio&) = delete;
+    Portfolio& operator=(const Portfolio&) = delete;
+    Portfolio(Portfolio&&) = delete;
+    Portfolio& operator=(Portfolio&&) = delete;
 
 private:
-    mutable std::mutex m_mutex;
+    // Fixed-size position storage readers copy from. Replaced (never resized)
+    // when the universe outgrows it.
+    void mark_dirty(SymbolId id);
+
+    struct PublishedPositions {
+        explicit PublishedPositions(std::size_t size)
+            : capacity(size), positions(new std::atomic<long long>[size]()) {}
+
+        const std::size_t capacity;
+        std::unique_ptr<std::atomic<long long>[]> positions;
+    };
+
+    // Grows the per-symbol arrays to hold `id`.
+    void ensure_symbol(SymbolId id);
+
+    // Adds `id` to or removes it from the held list after its position changed.
+    void update_held(SymbolId id);
 
+    // Writer state
     double m_cash;
-    double m_total_value;
-    std::map<std::string, long long> m_holdings;
-};
\ No newline at end of file
+    double m_market_value = 0.0;
+    double m_gross_exposure = 0.0;
+    std::uint64_t m_fill_count = 0;
+    double m_traded_notional = 0.0;
+
+    std::shared_ptr<SymbolRegistry> m_registry;
+    std::vector<long long> m_positions;  // Shares held, indexed by SymbolId
+    std::vector<double> m_marked_prices; // Price each position is valued at, 0.0 = never marked
+
+    // Non-zero positions, so trading touches only them and the targeted symbols
+    std::vector<SymbolId> m_held_ids;
+    std::vector<std::size_t> m_held_slots; // Index into m_held_ids + 1, 0 = not held
+
+    std::size_t m_revalue_interval = kDefaultRevalueInterval;
+    std::size_t m_marks_since_revalue = 0;
+
+    // Positions changed since the last publish, so publish() copies only those
+    std::vector<SymbolId> m_dirty_ids;
+    std::vector<bool> m_dirty;
+
+    // Published state: written by publish(), read by snapshot()
+    std::atomic<std::uint64_t> m_sequence{0}; // Odd while a publish is in progress
+    std::atomic<double> m_published_cash{0.0};
+    std::atomic<double> m_published_total_value{0.0};
+    std::atomic<std::size_t> m_published_count{0};
+    std::atomic<PublishedPositions*> m_published_positions{nullptr};
+
+    // Owns every buffer ever published. Replaced buffers are kept because a
+    // reader may still be copying from them; growth doubles, so they cost at
+    // most as much as the live one.
+    std::vector<std::unique_ptr<PublishedPositions>> m_position_buffers;
+};
@@ -0,0 +1,116 @@
+// include/core/SpscQueue.h
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @class SpscQueue
+ * @brief A bounded, lock-free single-producer/single-consumer ring buffer.
+ *
+ * Exactly one thread may push and exactly one (other) thread may pop. The
+ * capacity is rounded up to a power of two so index wrapping is a mask. The
+ * head and tail indices live on separate cache lines, and each side keeps a
+ * cached copy of the other side's index to avoid needless cross-core traffic.
+ * A full queue makes `try_push` fail, which is how producers observe backpressure.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscQueue capacity must be positive");
+        }
+        std::size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        m_mask = rounded - 1;
+        m_slots = std::make_unique<Slot[]>(rounded);
+    }
+
+    ~SpscQueue() {
+        while (try_pop()) {
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // --- Producer side ---
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head > m_mask) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head > m_mask) {
+                return false; // Full
+            }
+        }
+        new (m_slots[tail & m_mask].storage) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+    bool try_push(const T& value) { return try_emplace(value); }
+
+    // --- Consumer side ---
+    std::optional<T> try_pop() {
+        T* front_slot = front();
+        if (!front_slot) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(*front_slot));
+        pop();
+        return value;
+    }
+
+    // Peeks at the oldest element without removing it; nullptr when empty.
+    T* front() {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail) {
+                return nullptr; // Empty
+            }
+        }
+        return std::launder(reinterpret_cast<T*>(m_slots[head & m_mask].storage));
+    }
+
+    // Removes the element returned by a successful front().
+    void pop() {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        std::launder(reinterpret_cast<T*>(m_slots[head & m_mask].storage))->~T();
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // Approximate when called concurrently with the other side.
+    std::size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    std::size_t capacity() const { return m_mask + 1; }
+
+private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask = 0;
+
+    alignas(kCacheLine) std::atomic<std::size_t> m_head{0}; // Written by the consumer
+    std::size_t m_cached_tail = 0;                          // Consumer's view of m_tail
+
+    alignas(kCacheLine) std::atomic<std::size_t> m_tail{0}; // Written by the producer
+    std::size_t m_cached_head = 0;                          // Producer's view of m_head
+};
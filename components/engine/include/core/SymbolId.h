@@ -0,0 +1,12 @@
+// include/core/SymbolId.h
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Dense integer handle for an interned symbol (see SymbolRegistry).
+using SymbolId = std::uint32_t;
+
+// Marks a bar or packet whose symbol has not been resolved to an id yet.
+inline constexpr SymbolId kInvalidSymbolId = std::numeric_limits<SymbolId>::max();
@@ -0,0 +1,58 @@
+// include/core/SymbolRegistry.h
+
+#pragma once
+
+#include "core/SymbolId.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Dense per-symbol vectors, indexed by SymbolId. Missing entries read as 0.0.
+using WeightVector = std::vector<double>;
+using PriceVector = std::vector<double>;
+
+/**
+ * @class SymbolRegistry
+ * @brief Interns symbol strings into dense, stable `SymbolId`s.
+ *
+ * Symbols are interned once, at load time, by the data providers. From then
+ * on the hot path works on `SymbolId`-indexed vectors instead of string-keyed
+ * maps. Ids are assigned in insertion order starting at 0 and never change.
+ *
+ * Not thread-safe for interning: register the universe before handing the
+ * registry to other threads. Concurrent `find`/`name` calls are fine as long
+ * as nobody interns at the same time.
+ */
+class SymbolRegistry {
+public:
+    /**
+     * @brief Returns the id of `symbol`, assigning the next free id if it is new.
+     */
+    SymbolId intern(std::string_view symbol);
+
+    /**
+     * @brief Looks up a symbol without interning it.
+     * @return The id, or kInvalidSymbolId if the symbol was never interned.
+     */
+    SymbolId find(std::string_view symbol) const;
+
+    // The symbol string for a valid id. References stay valid as the registry grows.
+    const std::string& name(SymbolId id) const { return m_names[id]; }
+
+    std::size_t size() const { return m_names.size(); }
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    std::unordered_map<std::string, SymbolId, StringHash, std::equal_to<>> m_ids;
+    std::deque<std::string> m_names; // Deque keeps name() references stable
+};
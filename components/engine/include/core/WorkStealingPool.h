@@ -0,0 +1,70 @@
+// include/core/WorkStealingPool.h
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief A fixed-size thread pool where idle workers steal from busy ones.
+ *
+ * Every worker owns a task deque. Submissions are spread round-robin over the
+ * deques; a worker pops from the back of its own deque and, when that is empty,
+ * steals from the front of the others. With coarse tasks (eg one backtest per
+ * task) this keeps every core busy even when task durations vary widely.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @param thread_count Number of workers; 0 means one per hardware thread.
+     */
+    explicit WorkStealingPool(std::size_t thread_count = 0);
+
+    // Finishes every submitted task, then joins the workers.
+    ~WorkStealingPool();
+
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     * @throws The first exception thrown by a task since the last call.
+     */
+    void wait_idle();
+
+    std::size_t thread_count() const { return m_threads.size(); }
+
+    // --- Safety: owns running threads ---
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void worker_loop(std::size_t index);
+    bool try_take(std::size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_next_queue{0};
+
+    // Guarded by m_state_mutex
+    std::mutex m_state_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_idle;
+    std::size_t m_queued = 0;       // Tasks sitting in a deque
+    std::size_t m_unfinished = 0;   // Tasks submitted but not finished
+    bool m_stop = false;
+    std::exception_ptr m_first_error;
+};
@@ -0,0 +1,58 @@
+// include/data/BarReplayPublisher.h
+
+#pragma once
+
+#include "interfaces/IDataProvider.h"
+#include "data/LiveBarMessage.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <zmq.hpp>
+
+struct ReplayOptions {
+    double bars_per_second = 0.0;           // Send rate; 0 = as fast as possible
+    std::chrono::milliseconds warmup{500};  // Pause after binding, so subscribers can connect first
+    bool send_end_of_feed = true;           // Close the feed with an empty message
+};
+
+/**
+ * @class BarReplayPublisher
+ * @brief Serves stored bars as a live ZeroMQ PUB feed (see LiveBarMessage), for offline testing.
+ *
+ * Bars are taken from any data provider (eg a MergedBarProvider over the
+ * data directory) in stream order and sent at a fixed rate. Sends are
+ * scheduled on the steady clock against the start of the replay, not the
+ * previous send, so the rate does not drift; the last stretch before each
+ * send is spun, not slept, to keep the spacing accurate at high rates. PUB
+ * drops messages for a subscriber that is not connected yet, hence the
+ * warm-up pause; once connected, nothing is dropped (no high-water mark).
+ */
+class BarReplayPublisher {
+public:
+    // Binds a PUB socket to `endpoint`, eg tcp://*:5560.
+    BarReplayPublisher(const std::string& endpoint, ReplayOptions options = {});
+
+    /**
+     * @brief Sends every bar of `source`, then the end-of-feed message.
+     * Returns early, without the end-of-feed message, if stop() is called.
+     * @return The number of bars sent.
+     */
+    std::uint64_t publish(IDataProvider& source);
+
+    // Makes a running publish() return; callable from any thread.
+    void stop() { m_stop.store(true, std::memory_order_relaxed); }
+
+    // --- Safety: Disallow copy/move ---
+    BarReplayPublisher(const BarReplayPublisher&) = delete;
+    BarReplayPublisher& operator=(const BarReplayPublisher&) = delete;
+
+private:
+    // Sleeps, then spins, until `deadline`. Returns false if stopped meanwhile.
+    bool wait_until(std::chrono::steady_clock::time_point deadline);
+
+    ReplayOptions m_options;
+    zmq::context_t m_context;
+    zmq::socket_t m_socket;
+    std::atomic<bool> m_stop{false};
+};
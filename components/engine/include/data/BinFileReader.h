@@ -3,16 +3,33 @@
 #pragma once
 
 #include "interfaces/IDataProvider.h"
+#include "data/TimeRange.h"
+#include <cstdint>
 #include <string>
 #include <fstream>
 
 class BinFileReader : public IDataProvider {
     public:
-        explicit BinFileReader(const std::string& file_path);
+        /**
+         * @param file_path A `.bin` file: an optional `BarFileHeader`, then time-ordered 64-byte records.
+         * @param range Only bars in `[start, end)` are returned; the reader seeks
+         *              straight to the start instead of reading the prefix.
+         */
+        explicit BinFileReader(const std::string& file_path, TimeRange range = {});
         ~BinFileReader() override;
 
         std::optional<DataBar> get_next_bar() override;
+        void resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) override;
+
+        /**
+         * @brief Moves to the first record at or after `timestamp_ns`.
+         * Binary search with one small read per step: O(log n) reads, not a scan.
+         */
+        void seek(std::uint64_t timestamp_ns);
     
     private:
         std::ifstream m_file_stream;
-};
\ No newline at end of file
+        std::uint64_t m_records_offset = 0; // Past the header, if the file has one
+        std::uint64_t m_record_count = 0;
+        std::uint64_t m_end_ns;
+};
@@ -0,0 +1,61 @@
+// include/data/BincodeBarReader.h
+
+#pragma once
+
+#include "interfaces/IDataProvider.h"
+#include "data/DataBarRecord.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+/**
+ * @class BincodeBarReader
+ * @brief Streams the `rust_data_fetcher` output: a bincode-encoded `Vec<PriceBar>`.
+ *
+ * The fetcher writes with bincode 2's standard configuration: lengths are
+ * varints, the `date` is a string ("YYYY-MM-DD HH:MM:SS", read as UTC) and
+ * every price and the volume are little-endian `f64`s. The file does not name
+ * its symbol, so the caller passes it in (the fetcher names files after it).
+ *
+ * Bars are decoded one at a time from a buffered stream, so converting a file
+ * never holds more than one bar in memory.
+ */
+class BincodeBarReader : public IDataProvider {
+public:
+    BincodeBarReader(const std::string& file_path, const std::string& symbol);
+
+    std::optional<DataBar> get_next_bar() override;
+
+    /**
+     * @brief Decodes the next bar into a record owned by the reader.
+     * @return nullptr after the last bar; the record is overwritten by the next call.
+     * @throws std::runtime_error If the file is truncated or a field is malformed.
+     */
+    const DataBarRecord* next_record();
+
+    std::uint64_t size() const { return m_bar_count; }
+
+    // --- Safety: Disallow copy/move ---
+    BincodeBarReader(const BincodeBarReader&) = delete;
+    BincodeBarReader& operator=(const BincodeBarReader&) = delete;
+
+private:
+    std::uint64_t read_varint();
+    double read_f64();
+    void read_bytes(void* out, std::size_t size);
+
+    std::string m_file_path;
+    std::ifstream m_in;
+    std::uint64_t m_bar_count = 0;
+    std::uint64_t m_position = 0;
+    DataBarRecord m_record{};
+    std::string m_date; // Scratch, reused across bars
+};
+
+/**
+ * @brief Parses "YYYY-MM-DD HH:MM:SS" or "YYYY-MM-DD" as UTC.
+ * @return Nanoseconds since the Unix epoch.
+ * @throws std::invalid_argument If the text is not in either form.
+ */
+std::uint64_t parse_bar_timestamp(std::string_view text);
@@ -0,0 +1,44 @@
+// include/data/BookEventReader.h
+
+#pragma once
+
+#include "data/BookEventRecord.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+/**
+ * @class BookEventReader
+ * @brief Zero-copy reader for `.book` replay files of `BookEventRecord`s.
+ *
+ * Same approach as MmapBarReader: the file is memory-mapped read-only, its
+ * size is validated once, and events are handed out as spans into the mapping.
+ */
+class BookEventReader {
+public:
+    explicit BookEventReader(const std::string& file_path);
+    ~BookEventReader();
+
+    /**
+     * @brief Returns the events with a timestamp at or before `timestamp_epoch_ns`
+     * that were not returned yet, and advances past them.
+     */
+    std::span<const BookEventRecord> next_until(std::uint64_t timestamp_epoch_ns);
+
+    std::span<const BookEventRecord> records() const { return {m_records, m_record_count}; }
+    std::size_t size() const { return m_record_count; }
+    std::size_t position() const { return m_position; }
+
+    // --- Safety: the mapping is owned exclusively ---
+    BookEventReader(const BookEventReader&) = delete;
+    BookEventReader& operator=(const BookEventReader&) = delete;
+
+private:
+    void* m_mapping = nullptr;
+    std::size_t m_mapping_size = 0;
+
+    const BookEventRecord* m_records = nullptr;
+    std::size_t m_record_count = 0;
+    std::size_t m_position = 0;
+};
@@ -0,0 +1,38 @@
+// include/data/BookEventRecord.h
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Kind of one order book event in a replay file.
+ * L3 feeds use Add/Cancel/Execute per order; L2 feeds use Level, which sets
+ * the aggregate quantity resting at one price.
+ */
+enum class BookEventType : std::uint8_t {
+    Add = 0,     // New order: order_id, side, price_ticks, quantity
+    Cancel = 1,  // Remove an order entirely: order_id
+    Execute = 2, // An order traded (or was partially cancelled): order_id, quantity taken off it
+    Level = 3,   // L2 update: side, price_ticks, quantity now resting there (0 clears the level)
+    Clear = 4,   // Book reset, eg at a session start
+};
+
+/**
+ * @struct BookEventRecord
+ * @brief The fixed 40-byte on-disk layout of one event in a `.book` replay file.
+ *
+ * A file holds the events of one symbol in time order. Prices are integer
+ * multiples of the symbol's tick size.
+ */
+struct BookEventRecord {
+    std::uint64_t timestamp_epoch_ns; // Exchange timestamp, nanoseconds since the Unix epoch
+    std::uint64_t order_id;           // L3 only
+    std::int64_t price_ticks;
+    std::int64_t quantity;
+    BookEventType type;
+    std::uint8_t side;                // 0 = bid, 1 = ask
+    std::uint8_t reserved[6];
+};
+
+static_assert(sizeof(BookEventRecord) == 40, "BookEventRecord must match the 40-byte .book layout");
+static_assert(alignof(BookEventRecord) == 8, "BookEventRecord must be 8-byte aligned");
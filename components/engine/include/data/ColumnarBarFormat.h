@@ -0,0 +1,88 @@
+// include/data/ColumnarBarFormat.h
+
+#pragma once
+
+#include "data/DataBarRecord.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @file ColumnarBarFormat.h
+ * @brief The compressed, block-indexed `.cbar` layout for one symbol's bars.
+ *
+ * File layout (all integers little-endian):
+ *
+ *     ColumnarFileHeader          magic, version, the symbol (stored once)
+ *     block 0 .. block N-1        compressed payloads, up to `bars_per_block` bars each
+ *     ColumnarBlockIndexEntry[N]  offset, size, bar count, time range and CRC32 of each block
+ *     ColumnarFileTrailer         where the index starts, its CRC32, totals
+ *
+ * Each block is self-contained, so any block can be decoded on its own. Its
+ * payload is one bit stream holding the block's columns back to back:
+ *
+ * - timestamps: the first raw, then delta-of-deltas in variable-width buckets
+ *   (a single `0` bit for evenly spaced bars);
+ * - open, high, low, close: when every price of the column in the block is
+ *   exactly a decimal with at most 6 places (eg quotes parsed from text), the
+ *   scaled integers' deltas in variable-width buckets; otherwise Gorilla XOR
+ *   encoding against the previous value. Either way an unchanged price is a
+ *   single `0` bit;
+ * - volume: 7-bit groups with a continuation bit.
+ *
+ * The payload is followed by 8 zero bytes so the decoder can load whole
+ * 64-bit words without bounds checks per bit. Floating-point values
+ * round-trip bit-exactly.
+ */
+
+inline constexpr char kColumnarMagic[4] = {'C', 'B', 'A', 'R'};
+inline constexpr std::uint32_t kColumnarVersion = 1;
+inline constexpr std::size_t kColumnarBlockPadding = 8;
+
+struct ColumnarFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    char symbol[16];                // NUL-padded, as in DataBarRecord
+    std::uint32_t bars_per_block;   // Upper bound on ColumnarBlockIndexEntry::bar_count
+    std::uint32_t reserved;
+};
+
+struct ColumnarBlockIndexEntry {
+    std::uint64_t offset;           // Of the payload, from the start of the file
+    std::uint32_t size;             // Payload bytes, padding included
+    std::uint32_t bar_count;
+    std::uint64_t first_timestamp_ns;
+    std::uint64_t last_timestamp_ns;
+    std::uint32_t crc32;            // Of the payload
+    std::uint32_t reserved;
+};
+
+struct ColumnarFileTrailer {
+    std::uint64_t index_offset;
+    std::uint64_t bar_count;
+    std::uint32_t block_count;
+    std::uint32_t index_crc32;      // Of the block index entries
+    std::uint32_t reserved;
+    char magic[4];
+};
+
+static_assert(sizeof(ColumnarFileHeader) == 32, "ColumnarFileHeader must match the .cbar layout");
+static_assert(sizeof(ColumnarBlockIndexEntry) == 40, "ColumnarBlockIndexEntry must match the .cbar layout");
+static_assert(sizeof(ColumnarFileTrailer) == 32, "ColumnarFileTrailer must match the .cbar layout");
+
+// CRC-32 (IEEE 802.3, as used by zlib), continuing from `crc`.
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+/**
+ * @brief Appends one compressed block holding `bars` to `out`, padding included.
+ * The symbol fields of the records are not stored.
+ */
+void encode_columnar_block(std::span<const DataBarRecord> bars, std::vector<std::uint8_t>& out);
+
+/**
+ * @brief Decodes one block payload into `bars`, which must hold exactly the block's bar count.
+ * Only the timestamp, price and volume fields are written.
+ * @throws std::runtime_error If the payload is truncated.
+ */
+void decode_columnar_block(std::span<const std::uint8_t> payload, std::span<DataBarRecord> bars);
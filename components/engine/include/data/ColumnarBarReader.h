@@ -0,0 +1,94 @@
+// include/data/ColumnarBarReader.h
+
+#pragma once
+
+#include "interfaces/IDataProvider.h"
+#include "interfaces/IBarRecordSource.h"
+#include "data/ColumnarBarFormat.h"
+#include "core/SymbolRegistry.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ColumnarBarReader
+ * @brief Reads a compressed `.cbar` file (see ColumnarBarFormat.h) one block at a time.
+ *
+ * The file is memory-mapped read-only; the header, trailer and block index
+ * are validated at construction. Blocks are decoded on demand into a reused
+ * buffer of `DataBarRecord`s, so consumers get the same record view as from
+ * MmapBarReader while only touching the compressed bytes on disk. Each
+ * block's CRC32 is checked before it is decoded, and the kernel is asked to
+ * read the following block ahead while the current one is consumed.
+ *
+ * When given a registry, the file's symbol is interned at construction and
+ * every bar is tagged with its id.
+ */
+class ColumnarBarReader : public IDataProvider, public IBarRecordSource {
+    public:
+        explicit ColumnarBarReader(const std::string& file_path,
+                                   const std::shared_ptr<SymbolRegistry>& registry = nullptr);
+        ~ColumnarBarReader() override;
+
+        std::optional<DataBar> get_next_bar() override;
+        void resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) override;
+
+        /**
+         * @brief Returns a view of the next record and advances the cursor.
+         * @return A pointer into the decoded block, valid until the next block is decoded;
+         *         nullptr at end of file.
+         * @throws std::runtime_error If a block fails its checksum.
+         */
+        const DataBarRecord* next_record() override;
+
+        /**
+         * @brief Returns up to `max_records` records, never crossing a block boundary.
+         * @return An empty span at end of file.
+         */
+        std::span<const DataBarRecord> next_batch(std::size_t max_records);
+
+        SymbolId symbol_id_of(const DataBarRecord& record) const override;
+
+        /**
+         * @brief Moves the cursor to the first record at or after `timestamp_ns`.
+         * Binary-searches the block index by time range and decodes only the block found.
+         */
+        void seek(std::uint64_t timestamp_ns) override;
+
+        // The block index, in file order.
+        std::span<const ColumnarBlockIndexEntry> blocks() const { return m_index; }
+
+        std::string_view symbol() const { return record_symbol(m_template); }
+        std::size_t size() const { return m_bar_count; }
+        std::size_t position() const { return m_position; }
+        void rewind();
+
+        // --- Safety: the mapping is owned exclusively ---
+        ColumnarBarReader(const ColumnarBarReader&) = delete;
+        ColumnarBarReader& operator=(const ColumnarBarReader&) = delete;
+
+    private:
+        // Decodes block `block` into m_decoded. Returns false past the last block.
+        bool load_block(std::size_t block);
+
+        std::string m_file_path;
+        void* m_mapping = nullptr;
+        std::size_t m_mapping_size = 0;
+
+        const std::uint8_t* m_bytes = nullptr;
+        std::vector<ColumnarBlockIndexEntry> m_index; // Copied out: the index need not be aligned
+        std::size_t m_bar_count = 0;
+
+        DataBarRecord m_template{};               // The symbol, copied into every decoded record
+        SymbolId m_symbol_id = kInvalidSymbolId;
+
+        std::vector<DataBarRecord> m_decoded;     // Holds the current block, sized for the largest
+        std::size_t m_decoded_count = 0;          // Bars of the current block
+        std::size_t m_next_block = 0;             // The block after the current one
+        std::size_t m_block_position = 0;         // Cursor within m_decoded
+        std::size_t m_position = 0;               // Bars handed out in total
+};
@@ -0,0 +1,65 @@
+// include/data/ColumnarBarWriter.h
+
+#pragma once
+
+#include "data/ColumnarBarFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class ColumnarBarWriter
+ * @brief Streams one symbol's bars into a `.cbar` file (see ColumnarBarFormat.h).
+ *
+ * Bars are buffered one block at a time, so memory use is bounded by the block
+ * size however long the input is. The block index and trailer are written by
+ * finish(); a writer destroyed without it (eg while an exception unwinds a
+ * conversion) leaves a file without a trailer, which readers reject.
+ */
+class ColumnarBarWriter {
+public:
+    static constexpr std::size_t kDefaultBarsPerBlock = 4096;
+
+    /**
+     * @param file_path The file to create (truncated if it exists).
+     * @param symbol The file's symbol, at most 15 characters.
+     * @param bars_per_block Bars per compressed block; the unit of decoding and seeking.
+     */
+    ColumnarBarWriter(const std::string& file_path, const std::string& symbol,
+                      std::size_t bars_per_block = kDefaultBarsPerBlock);
+
+    /**
+     * @brief Appends one bar. Its symbol field is ignored.
+     * @throws std::invalid_argument If the bar is older than the previous one.
+     */
+    void append(const DataBarRecord& bar);
+
+    // Writes the last block, the index and the trailer, and closes the file.
+    void finish();
+
+    std::uint64_t bar_count() const { return m_bar_count; }
+    std::uint64_t bytes_written() const { return m_offset; }
+
+    // --- Safety: Disallow copy/move ---
+    ColumnarBarWriter(const ColumnarBarWriter&) = delete;
+    ColumnarBarWriter& operator=(const ColumnarBarWriter&) = delete;
+
+private:
+    void flush_block();
+    void write(const void* data, std::size_t size);
+
+    std::string m_file_path;
+    std::ofstream m_out;
+    std::size_t m_bars_per_block;
+
+    std::vector<DataBarRecord> m_block;       // Bars of the block being filled
+    std::vector<std::uint8_t> m_payload;      // Scratch for the encoded block
+    std::vector<ColumnarBlockIndexEntry> m_index;
+
+    std::uint64_t m_offset = 0;
+    std::uint64_t m_bar_count = 0;
+    std::uint64_t m_last_timestamp_ns = 0;
+    bool m_finished = false;
+};
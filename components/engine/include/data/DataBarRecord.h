@@ -0,0 +1,110 @@
+// include/data/DataBarRecord.h
+
+#pragma once
+
+#include "core/DataBar.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @struct DataBarRecord
+ * @brief The fixed 64-byte on-disk layout of one bar in a `.bin` data file,
+ * after its `BarFileHeader` if it has one.
+ *
+ * Shared by every reader of the format so the layout is defined exactly once.
+ */
+struct DataBarRecord {
+    char symbol[16];                // NUL-padded asset identifier
+    uint64_t timestamp_epoch_ns;    // Bar timestamp, nanoseconds since the Unix epoch
+    double open;
+    double high;
+    double low;
+    double close;
+    uint64_t volume;
+};
+
+static_assert(sizeof(DataBarRecord) == 64, "DataBarRecord must match the 64-byte .bin layout");
+static_assert(alignof(DataBarRecord) == 8, "DataBarRecord must be 8-byte aligned");
+
+/**
+ * @struct BarFileHeader
+ * @brief Optionally starts a `.bin` record file, ahead of its records.
+ *
+ * `rust_data_fetcher` also writes `.bin` files (bincode, see BincodeBarReader),
+ * so new record files carry a magic instead of relying on the extension or
+ * the size. Files written before the header existed are plain records and
+ * are still read. The header is one record long, so the records stay 64-byte
+ * aligned in a mapping.
+ */
+inline constexpr char kBarFileMagic[4] = {'B', 'A', 'R', 'S'};
+inline constexpr std::uint32_t kBarFileVersion = 1;
+
+struct BarFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t record_size;      // sizeof(DataBarRecord)
+    std::uint8_t reserved[52];
+};
+
+static_assert(sizeof(BarFileHeader) == sizeof(DataBarRecord), "BarFileHeader must be one record long");
+
+inline BarFileHeader make_bar_file_header() {
+    BarFileHeader header{};
+    std::memcpy(header.magic, kBarFileMagic, sizeof(header.magic));
+    header.version = kBarFileVersion;
+    header.record_size = sizeof(DataBarRecord);
+    return header;
+}
+
+inline bool is_bar_file_header(const BarFileHeader& header) {
+    return std::memcmp(header.magic, kBarFileMagic, sizeof(header.magic)) == 0
+        && header.version == kBarFileVersion && header.record_size == sizeof(DataBarRecord);
+}
+
+/**
+ * @brief Where the records of a `.bin` file start: after the header if the file
+ * begins with the magic, otherwise at 0 (the headerless layout).
+ * @param first_bytes The first `size` bytes of the file; only the first 64 are read.
+ * @throws std::runtime_error If the magic is there but the header is not one this build reads.
+ */
+inline std::size_t bar_file_records_offset(const void* first_bytes, std::size_t size) {
+    if (size < sizeof(BarFileHeader) || std::memcmp(first_bytes, kBarFileMagic, sizeof(kBarFileMagic)) != 0) {
+        return 0;
+    }
+    BarFileHeader header;
+    std::memcpy(&header, first_bytes, sizeof(header));
+    if (!is_bar_file_header(header)) {
+        throw std::runtime_error("Unsupported bar file header (version " + std::to_string(header.version)
+                                 + ", " + std::to_string(header.record_size) + "-byte records)");
+    }
+    return sizeof(BarFileHeader);
+}
+
+// The symbol field is only NUL-terminated when shorter than 16 characters.
+inline std::string_view record_symbol(const DataBarRecord& record) {
+    return {record.symbol, strnlen(record.symbol, sizeof(record.symbol))};
+}
+
+inline std::chrono::system_clock::time_point record_timestamp(const DataBarRecord& record) {
+    auto timestamp_ns = std::chrono::system_clock::time_point{} +
+                        std::chrono::nanoseconds(record.timestamp_epoch_ns);
+    return std::chrono::time_point_cast<std::chrono::system_clock::duration>(timestamp_ns);
+}
+
+// Symbols fit in std::string's small buffer, so this does not touch the heap.
+inline DataBar to_data_bar(const DataBarRecord& record, SymbolId symbol_id = kInvalidSymbolId) {
+    return DataBar{
+        std::string(record_symbol(record)),
+        record_timestamp(record),
+        record.open,
+        record.high,
+        record.low,
+        record.close,
+        record.volume,
+        symbol_id
+    };
+}
@@ -0,0 +1,46 @@
+// include/data/InMemoryBarProvider.h
+
+#pragma once
+
+#include "interfaces/IDataProvider.h"
+#include "core/SymbolRegistry.h"
+#include "data/TimeRange.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// An immutable, shareable bar stream. Many providers can read one copy concurrently.
+using SharedBarStore = std::shared_ptr<const std::vector<DataBar>>;
+
+/**
+ * @class InMemoryBarProvider
+ * @brief Replays a shared, read-only vector of bars.
+ *
+ * Used when many backtests run over the same data (eg a parameter sweep): the
+ * data is loaded once with `load_all()`, and each run gets its own cursor over
+ * the shared copy. Walk-forward studies load the data once and give each
+ * window its own range; a window's first bar is found by binary search.
+ */
+class InMemoryBarProvider final : public IDataProvider {
+    public:
+        /**
+         * @param bars The shared store, in time order (as load_all() produces it).
+         * @param range Only bars in `[start, end)` are replayed.
+         */
+        explicit InMemoryBarProvider(SharedBarStore bars, TimeRange range = {});
+
+        std::optional<DataBar> get_next_bar() override;
+        void resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) override;
+
+        /**
+         * @brief Drains a provider into a store that can be shared across threads.
+         * @param registry If given, bars the provider left untagged are interned
+         *                 here, so consumers never need to intern concurrently.
+         */
+        static SharedBarStore load_all(IDataProvider& provider, SymbolRegistry* registry = nullptr);
+
+    private:
+        SharedBarStore m_bars;
+        std::size_t m_position = 0;
+        std::size_t m_end = 0;
+};
@@ -0,0 +1,30 @@
+// include/data/LiveBarMessage.h
+
+#pragma once
+
+#include "data/DataBarRecord.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @struct LiveBarMessage
+ * @brief One bar on the live market-data feed: a single 72-byte ZeroMQ PUB message.
+ *
+ * The bar is the 64-byte `.bin` record, so recorded data goes on the wire
+ * unchanged. Because the record starts with the symbol, a subscriber can
+ * filter symbols with ordinary ZeroMQ prefix subscriptions. `published_ns`
+ * is the publisher's steady clock at send time; publisher and engine on one
+ * host share that clock, so the feed's own latency can be measured. An empty
+ * message marks the end of the feed.
+ */
+struct LiveBarMessage {
+    DataBarRecord record;
+    std::uint64_t published_ns; // steady_clock, nanoseconds; 0 if unknown
+};
+
+static_assert(sizeof(LiveBarMessage) == 72, "LiveBarMessage must match the 72-byte feed layout");
+
+inline std::uint64_t steady_clock_ns(std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now()) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
@@ -0,0 +1,83 @@
+// include/data/MmapBarReader.h
+
+#pragma once
+
+#include "interfaces/IDataProvider.h"
+#include "interfaces/IBarRecordSource.h"
+#include "data/DataBarRecord.h"
+#include "core/SymbolRegistry.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+
+/**
+ * @class MmapBarReader
+ * @brief Zero-copy reader for `.bin` files of fixed-size `DataBarRecord`s.
+ *
+ * The whole file is memory-mapped read-only and its layout is validated once
+ * at construction: the `BarFileHeader` if the file starts with one, else the
+ * headerless record layout. After that, records are handed out as pointers/spans into
+ * the mapping: no read syscalls, no per-bar copies and no per-bar allocations.
+ * `get_next_bar()` is still provided so the reader is a drop-in replacement
+ * for `BinFileReader`.
+ *
+ * When given a registry, the file's symbol (taken from its first record) is
+ * interned at construction and bars of that symbol are tagged with its id.
+ */
+class MmapBarReader : public IDataProvider, public IBarRecordSource {
+    public:
+        explicit MmapBarReader(const std::string& file_path,
+                               const std::shared_ptr<SymbolRegistry>& registry = nullptr);
+        ~MmapBarReader() override;
+
+        std::optional<DataBar> get_next_bar() override;
+        void resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) override;
+
+        /**
+         * @brief Returns a view of the next record and advances the cursor.
+         * @return A pointer into the mapping, or nullptr at end of file.
+         */
+        const DataBarRecord* next_record() override;
+
+        /**
+         * @brief Returns a view of up to `max_records` records and advances the cursor.
+         * @return An empty span at end of file.
+         */
+        std::span<const DataBarRecord> next_batch(std::size_t max_records);
+
+        // The full file as a span; the cursor is unaffected.
+        std::span<const DataBarRecord> records() const { return {m_records, m_record_count}; }
+
+        /**
+         * @brief Resolves a record from this file to its interned id.
+         * Cheap and thread-safe: compares against the symbol interned at open.
+         * @return The id, or kInvalidSymbolId for records of any other symbol.
+         */
+        SymbolId symbol_id_of(const DataBarRecord& record) const override;
+
+        /**
+         * @brief Moves the cursor to the first record at or after `timestamp_ns`.
+         * A binary search over the mapping: the fixed record size makes the file its own index.
+         */
+        void seek(std::uint64_t timestamp_ns) override;
+
+        std::size_t size() const { return m_record_count; }
+        std::size_t position() const { return m_position; }
+        void rewind() { m_position = 0; }
+
+        // --- Safety: the mapping is owned exclusively ---
+        MmapBarReader(const MmapBarReader&) = delete;
+        MmapBarReader& operator=(const MmapBarReader&) = delete;
+
+    private:
+        void* m_mapping = nullptr;
+        std::size_t m_mapping_size = 0;
+
+        const DataBarRecord* m_records = nullptr;
+        std::size_t m_record_count = 0;
+        std::size_t m_position = 0;
+
+        char m_symbol[sizeof(DataBarRecord::symbol)] = {};
+        SymbolId m_symbol_id = kInvalidSymbolId;
+};
@@ -0,0 +1,30 @@
+// include/data/TimeRange.h
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @struct TimeRange
+ * @brief A half-open `[start, end)` window of bar timestamps, in nanoseconds since the Unix epoch.
+ *
+ * The default range is unbounded, so providers given no range replay everything.
+ */
+struct TimeRange {
+    std::uint64_t start_ns = 0;
+    std::uint64_t end_ns = std::numeric_limits<std::uint64_t>::max();
+
+    static TimeRange between(std::chrono::system_clock::time_point start, std::chrono::system_clock::time_point end) {
+        return {to_epoch_ns(start), to_epoch_ns(end)};
+    }
+
+    static std::uint64_t to_epoch_ns(std::chrono::system_clock::time_point time) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    }
+
+    bool contains(std::uint64_t timestamp_ns) const { return timestamp_ns >= start_ns && timestamp_ns < end_ns; }
+    bool bounded() const { return start_ns != 0 || end_ns != std::numeric_limits<std::uint64_t>::max(); }
+};
@@ -0,0 +1,87 @@
+// include/data/ZmqBarSubscriber.h
+
+#pragma once
+
+#include "interfaces/IDataProvider.h"
+#include "core/SymbolRegistry.h"
+#include "data/LiveBarMessage.h"
+#include "metrics/MetricsReport.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+/**
+ * @brief How ZmqBarSubscriber waits for the next bar.
+ */
+enum class FeedWaitPolicy {
+    BusyPoll,      // Non-blocking receives in a loop: lowest latency, burns the core
+    SpinThenBlock  // Busy-poll for `spin_time`, then block in zmq::poll until a bar arrives
+};
+
+struct LiveFeedOptions {
+    FeedWaitPolicy wait_policy = FeedWaitPolicy::SpinThenBlock;
+    std::chrono::microseconds spin_time{200};  // SpinThenBlock only
+    std::chrono::milliseconds idle_timeout{0}; // End the stream after this long without a bar; 0 = never
+    std::vector<std::string> symbols;          // Subscribe to these only; empty = every symbol
+};
+
+/**
+ * @class ZmqBarSubscriber
+ * @brief A data provider fed live by a ZeroMQ PUB market-data feed (see LiveBarMessage).
+ *
+ * get_next_bar() waits for the next message according to the wait policy and
+ * returns the bar the moment it is received; the stream ends at the feed's
+ * end-of-feed message or after `idle_timeout` without a bar. Nothing is
+ * buffered beyond ZeroMQ's own queue, whose high-water mark is lifted so a
+ * burst is never dropped. All of it runs on the calling (engine) thread:
+ * pin that thread to an isolated core (pin_current_thread()) and use
+ * BusyPoll for the lowest and steadiest latency.
+ *
+ * Each received bar's arrival time is kept for last_arrival(). metrics()
+ * reports publish-to-receive latency (publisher and engine on one host)
+ * and how often the wait had to block.
+ */
+class ZmqBarSubscriber : public IDataProvider {
+public:
+    /**
+     * @param endpoint The feed's PUB endpoint, eg tcp://localhost:5560.
+     * @param registry Optional registry to intern the symbols into.
+     * @param options Wait policy, idle timeout and symbol filter.
+     */
+    ZmqBarSubscriber(const std::string& endpoint, std::shared_ptr<SymbolRegistry> registry = nullptr,
+                     LiveFeedOptions options = {});
+
+    std::optional<DataBar> get_next_bar() override;
+    std::optional<std::chrono::steady_clock::time_point> last_arrival() const override { return m_last_arrival; }
+    const MetricsReport* metrics() const override { return &m_metrics; }
+
+    std::uint64_t bars_received() const { return m_bars_received; }
+
+    // --- Safety: Disallow copy/move ---
+    ZmqBarSubscriber(const ZmqBarSubscriber&) = delete;
+    ZmqBarSubscriber& operator=(const ZmqBarSubscriber&) = delete;
+
+private:
+    // One non-blocking receive. Returns false if nothing was waiting.
+    bool try_receive();
+
+    // Blocks until a message is waiting or `timeout` passes (-1 = forever). Returns false on timeout.
+    bool wait_readable(std::chrono::milliseconds timeout);
+
+    LiveFeedOptions m_options;
+    std::shared_ptr<SymbolRegistry> m_registry;
+
+    zmq::context_t m_context;
+    zmq::socket_t m_socket;
+    zmq::message_t m_message; // Reused by every receive
+    bool m_finished = false;
+    std::chrono::steady_clock::time_point m_last_arrival{};
+
+    std::uint64_t m_bars_received = 0;
+    MetricsReport m_metrics{"Live feed"};
+    LatencyHistogram& m_feed_latency = m_metrics.histogram("publish_to_receive");
+    std::uint64_t& m_blocking_waits = m_metrics.counter("blocking_waits");
+    std::uint64_t& m_malformed_messages = m_metrics.counter("malformed_messages");
+};
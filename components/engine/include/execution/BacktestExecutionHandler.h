@@ -3,7 +3,7 @@
 #pragma once
 #include "interfaces/IExecutionHandler.h"
 
-class BacktestExecutionHandler : public IExecutionHandler {
+class BacktestExecutionHandler final : public IExecutionHandler {
 public:
     /**
      * @brief Constructs the handler with specific backtest parameters.
@@ -14,13 +14,30 @@ public:
 
     ~BacktestExecutionHandler() override = default;
 
+    void set_results_recorder(std::shared_ptr<ResultsRecorder> recorder) override { m_results = std::move(recorder); }
+
     void execute_trades(
         Portfolio& portfolio,
         const std::map<std::string, double>& approved_target,
         const std::map<std::string, double>& latest_prices
     ) override;
 
+    void execute_target_weights(
+        Portfolio& portfolio,
+        const SymbolRegistry& registry,
+        const WeightVector& approved_weights,
+        const PriceVector& latest_prices
+    ) override;
+
 private:
+    // Price paid or received per share, slippage included.
+    double execution_price(long long shares_to_trade, double latest_price) const;
+
+    // Cash change from trading `shares_to_trade` shares, including slippage and commission.
+    double cash_delta_for_fill(long long shares_to_trade, double latest_price) const;
+
     double m_commission_per_trade;
     double m_slippage_percentage;
+    std::shared_ptr<ResultsRecorder> m_results; // Optional
+    std::vector<SymbolId> m_trade_ids;          // Held or targeted this bar; reused
 };
\ No newline at end of file
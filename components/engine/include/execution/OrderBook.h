@@ -0,0 +1,135 @@
+// include/execution/OrderBook.h
+
+#pragma once
+
+#include "data/BookEventRecord.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+enum class BookSide : std::uint8_t { Bid = 0, Ask = 1 };
+
+/**
+ * @class OrderBook
+ * @brief In-memory limit order book for one symbol, built for replaying feeds.
+ *
+ * - Each side is a flat ladder: a vector of price levels indexed by
+ *   `price_ticks - base`, so finding a level is an index, not a tree search.
+ * - Orders live in one pool (a vector with a free list) and are chained into
+ *   their level's FIFO through intrusive prev/next indices, so adding,
+ *   cancelling and executing an order are O(1) and allocate nothing once the
+ *   pool and ladders have grown to the feed's working size.
+ * - Order ids are found through an open-addressing hash table.
+ *
+ * A level's quantity is the sum of its orders plus any L2 quantity set with
+ * set_level(), so the same book serves L3 and L2 feeds.
+ *
+ * Not thread-safe: one book is owned by one replay.
+ */
+class OrderBook {
+public:
+    static constexpr std::int64_t kNoBid = std::numeric_limits<std::int64_t>::min();
+    static constexpr std::int64_t kNoAsk = std::numeric_limits<std::int64_t>::max();
+
+    // Largest price range one side may span, in ticks. Events beyond it are rejected.
+    static constexpr std::int64_t kMaxLadderTicks = 1 << 20;
+
+    explicit OrderBook(std::size_t expected_orders = 1024);
+
+    // --- L3 ---
+    // Each returns false (and changes nothing) if the event does not apply,
+    // eg an unknown or duplicate order id, or a price outside the ladder span.
+    bool add_order(std::uint64_t order_id, BookSide side, std::int64_t price_ticks, std::int64_t quantity);
+    bool cancel_order(std::uint64_t order_id);
+    // Takes `quantity` off an order; the order is removed once nothing is left.
+    bool execute_order(std::uint64_t order_id, std::int64_t quantity);
+
+    // --- L2 ---
+    bool set_level(BookSide side, std::int64_t price_ticks, std::int64_t quantity);
+
+    // Applies one replay event. Returns false if it was rejected.
+    bool apply(const BookEventRecord& event);
+
+    // Removes every order and level; keeps the allocated capacity.
+    void clear();
+
+    // --- Queries ---
+    std::int64_t best_bid() const;
+    std::int64_t best_ask() const;
+    std::int64_t level_quantity(BookSide side, std::int64_t price_ticks) const;
+    std::size_t order_count() const { return m_order_count; }
+    // The side and price of a resting order. Returns false if the id is unknown.
+    bool order_level(std::uint64_t order_id, BookSide& side, std::int64_t& price_ticks) const;
+
+    /**
+     * @brief Visits the non-empty levels of one side from the best price outwards.
+     * @param fn Called as fn(price_ticks, quantity); return false to stop.
+     */
+    template <typename Fn>
+    void for_each_level(BookSide side, Fn&& fn) const {
+        const Ladder& ladder = m_ladders[static_cast<int>(side)];
+        if (ladder.best < 0) {
+            return;
+        }
+        const std::int64_t step = side == BookSide::Bid ? -1 : 1;
+        const auto size = static_cast<std::int64_t>(ladder.levels.size());
+        for (std::int64_t index = ladder.best; index >= 0 && index < size; index += step) {
+            const Level& level = ladder.levels[static_cast<std::size_t>(index)];
+            if (level.quantity > 0 && !fn(ladder.base + index, level.quantity)) {
+                return;
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+    struct Order {
+        std::uint64_t id;
+        std::int64_t quantity;
+        std::int64_t price_ticks;
+        std::uint32_t prev;  // Within the level FIFO, or the next free slot when unused
+        std::uint32_t next;
+        BookSide side;
+    };
+
+    struct Level {
+        std::int64_t quantity = 0;   // Orders plus L2 quantity
+        std::int64_t l2_quantity = 0;
+        std::uint32_t head = kNone;  // Oldest order
+        std::uint32_t tail = kNone;
+    };
+
+    struct Ladder {
+        std::vector<Level> levels;
+        std::int64_t base = 0;     // Price of levels[0]
+        std::int64_t best = -1;    // Index of the best non-empty level, -1 if the side is empty
+    };
+
+    // Returns the level for a price, growing the ladder if needed; nullptr if out of span.
+    Level* level_for(BookSide side, std::int64_t price_ticks);
+    // Updates `best` after a level at `index` gained quantity.
+    void level_filled(BookSide side, std::int64_t index);
+    // Updates `best` after a level at `index` may have become empty.
+    void level_drained(BookSide side, std::int64_t index);
+    void unlink(std::uint32_t slot);
+
+    // --- Order id -> pool slot, open addressing with linear probing ---
+    std::uint32_t find_slot(std::uint64_t order_id) const;
+    void insert_id(std::uint64_t order_id, std::uint32_t slot);
+    void erase_id(std::uint64_t order_id);
+    void grow_ids();
+
+    Ladder m_ladders[2];
+    std::vector<Order> m_orders;
+    std::uint32_t m_free = kNone;
+    std::size_t m_order_count = 0;
+
+    struct IdEntry {
+        std::uint64_t id;
+        std::uint32_t slot; // kNone marks an empty bucket
+    };
+    std::vector<IdEntry> m_ids;
+    std::size_t m_id_mask = 0;
+};
@@ -0,0 +1,139 @@
+// include/execution/OrderBookExecutionHandler.h
+
+#pragma once
+
+#include "interfaces/IExecutionHandler.h"
+#include "data/BookEventReader.h"
+#include "execution/OrderBook.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class OrderBookExecutionHandler
+ * @brief Fills trades against replayed limit order books instead of the bar close.
+ *
+ * Every symbol with a `<book_directory>/<SYMBOL>.book` file (see
+ * BookEventRecord) gets an OrderBook. Books are replayed lazily: before a
+ * symbol trades, its book is brought forward to the latest bar time seen.
+ *
+ * Each trade is sent as one immediate-or-cancel child order: it walks the
+ * opposite side from the best price outwards, up to a limit of the latest
+ * price +/- `max_slippage`, and fills at the levels it crosses. Whatever
+ * the book cannot absorb within the limit is left unfilled; the next bar's
+ * target tries again. Our fills do not modify the replayed book, but what they
+ * take from a level is not offered again until the feed next updates that
+ * level (an add, cancel, execution or L2 update at its price, or a clear).
+ *
+ * Symbols without a book file are filled at the latest price +/-
+ * `fallback_slippage`, like BacktestExecutionHandler.
+ */
+class OrderBookExecutionHandler : public IExecutionHandler {
+public:
+    /**
+     * @param book_directory Where the `.book` files live.
+     * @param tick_size The price of one tick in the files.
+     * @param commission The cost per fill.
+     * @param max_slippage The limit price of each child order, as a fraction of the latest price.
+     * @param fallback_slippage The slippage for symbols without a book.
+     */
+    OrderBookExecutionHandler(std::string book_directory, double tick_size, double commission,
+                              double max_slippage, double fallback_slippage);
+
+    ~OrderBookExecutionHandler() override = default;
+
+    // Tracks the replay clock.
+    void on_market_bar(SymbolId symbol, const DataBar& bar) override;
+
+    void set_results_recorder(std::shared_ptr<ResultsRecorder> recorder) override { m_results = std::move(recorder); }
+
+    // The replay clock, the unfilled count and, for each book we have taken
+    // liquidity from, its replay position and what was taken. Books are
+    // rebuilt from their files on first use.
+    void save_state(StateWriter& out) const override;
+    void restore_state(StateReader& in) override;
+
+    void execute_trades(
+        Portfolio& portfolio,
+        const std::map<std::string, double>& approved_target,
+        const std::map<std::string, double>& latest_prices
+    ) override;
+
+    void execute_target_weights(
+        Portfolio& portfolio,
+        const SymbolRegistry& registry,
+        const WeightVector& approved_weights,
+        const PriceVector& latest_prices
+    ) override;
+
+    // --- Diagnostics ---
+    std::uint64_t replayed_events() const { return m_replayed_events; }
+    std::uint64_t rejected_events() const { return m_rejected_events; } // Did not apply to the book
+    std::uint64_t unfilled_shares() const { return m_unfilled_shares; } // Left over by the IOC limit
+
+    // --- Safety: Disallow copy/move ---
+    OrderBookExecutionHandler(const OrderBookExecutionHandler&) = delete;
+    OrderBookExecutionHandler& operator=(const OrderBookExecutionHandler&) = delete;
+
+private:
+    // Quantity our fills took from one level since the feed last updated it
+    struct ConsumedLevel {
+        std::int64_t price_ticks;
+        std::int64_t quantity;
+        BookSide side;
+    };
+
+    struct SymbolBook {
+        explicit SymbolBook(const std::string& path) : events(path) {}
+        BookEventReader events;
+        OrderBook book;
+        std::vector<ConsumedLevel> consumed; // A few levels at most; searched linearly
+    };
+
+    // A book's state from a checkpoint, applied when the book is first opened
+    struct RestoredBook {
+        std::uint64_t position = 0; // Events replayed
+        std::vector<ConsumedLevel> consumed;
+    };
+
+    struct Fill {
+        long long shares = 0;     // Signed, like the request
+        double cash_delta = 0.0;  // Including commission
+        double price = 0.0;       // Average per share
+    };
+
+    // The book for a symbol, or nullptr if it has no file. Opened on first use.
+    SymbolBook* open_book(const std::string& symbol);
+
+    // Applies the book's events up to the latest bar time.
+    void replay(SymbolBook* book);
+
+    // Forgets what our fills took from the level `event` updates. Called before the event is applied.
+    static void release_level(SymbolBook& book, const BookEventRecord& event);
+
+    // What our fills have taken from a level, or nullptr if nothing.
+    static ConsumedLevel* find_consumed(SymbolBook& book, BookSide side, std::int64_t price_ticks);
+
+    // Trades up to `shares_to_trade` (signed) and returns what was filled.
+    Fill fill(SymbolBook* book, long long shares_to_trade, double latest_price);
+
+    std::string m_book_directory;
+    double m_tick_size;
+    double m_commission_per_trade;
+    double m_max_slippage;
+    double m_fallback_slippage;
+
+    std::shared_ptr<ResultsRecorder> m_results; // Optional
+    std::uint64_t m_now_ns = 0; // Latest bar time seen
+    std::unordered_map<std::string, std::unique_ptr<SymbolBook>> m_books; // nullptr: no file
+    std::vector<SymbolBook*> m_books_by_id;
+    std::vector<bool> m_resolved_ids;
+    std::vector<SymbolId> m_trade_ids; // Held or targeted this bar; reused
+    std::unordered_map<std::string, RestoredBook> m_restored_books;
+
+    std::uint64_t m_replayed_events = 0;
+    std::uint64_t m_rejected_events = 0;
+    std::uint64_t m_unfilled_shares = 0;
+};
@@ -0,0 +1,67 @@
+// include/interfaces/ComponentConcepts.h
+
+#pragma once
+
+#include "core/DataBar.h"
+#include "core/SymbolRegistry.h"
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+class MetricsReport;
+class Portfolio;
+class ResultsRecorder;
+class StateWriter;
+class StateReader;
+
+// What BasicEventLoop calls on each component. The interfaces in this directory
+// satisfy these, and so does any class derived from them; a class that does not
+// derive from them only has to provide the same members.
+
+// See IDataProvider.
+template <typename T>
+concept DataProvider = requires(T& provider, const T& const_provider, std::uint64_t value) {
+    { provider.get_next_bar() } -> std::same_as<std::optional<DataBar>>;
+    provider.resume_after(value, value);
+    { const_provider.last_arrival() } -> std::convertible_to<std::optional<std::chrono::steady_clock::time_point>>;
+    { const_provider.metrics() } -> std::convertible_to<const MetricsReport*>;
+};
+
+// See ISignalSource.
+template <typename T>
+concept SignalSource = requires(T& source, const T& const_source, const DataBar& bar, const SymbolRegistry& registry,
+                                WeightVector& weights, StateWriter& out, StateReader& in) {
+    source.update_market_bar(bar);
+    source.get_target_weights(registry, weights);
+    { const_source.pipeline_depth() } -> std::convertible_to<std::size_t>;
+    { const_source.metrics() } -> std::convertible_to<const MetricsReport*>;
+    const_source.save_state(out);
+    source.restore_state(in);
+};
+
+// See IRiskManager.
+template <typename T>
+concept RiskManager = requires(T& risk, const T& const_risk, SymbolId symbol, const DataBar& bar,
+                               const Portfolio& portfolio, double peak, const SymbolRegistry& registry,
+                               WeightVector& weights, StateWriter& out, StateReader& in) {
+    risk.on_market_bar(symbol, bar);
+    risk.validate_target_weights(portfolio, peak, registry, weights);
+    const_risk.save_state(out);
+    risk.restore_state(in);
+};
+
+// See IExecutionHandler.
+template <typename T>
+concept ExecutionHandler = requires(T& execution, const T& const_execution, SymbolId symbol, const DataBar& bar,
+                                    std::shared_ptr<ResultsRecorder> recorder, Portfolio& portfolio,
+                                    const SymbolRegistry& registry, const WeightVector& weights,
+                                    const PriceVector& prices, StateWriter& out, StateReader& in) {
+    execution.on_market_bar(symbol, bar);
+    execution.set_results_recorder(recorder);
+    execution.execute_target_weights(portfolio, registry, weights, prices);
+    const_execution.save_state(out);
+    execution.restore_state(in);
+};
@@ -0,0 +1,37 @@
+// include/interfaces/IBarRecordSource.h
+
+#pragma once
+
+#include "core/SymbolId.h"
+#include "data/DataBarRecord.h"
+#include <cstdint>
+
+/**
+ * @class IBarRecordSource
+ * @brief A per-symbol bar file read as raw `DataBarRecord`s, whatever its on-disk format.
+ *
+ * Lets MergedBarProvider merge plain `.bin` files and compressed `.cbar`
+ * files alike without converting each record to a DataBar first.
+ */
+class IBarRecordSource {
+public:
+    virtual ~IBarRecordSource() = default;
+
+    /**
+     * @brief Returns the next record and advances the cursor.
+     * @return nullptr at end of file. The record stays valid until the next call.
+     */
+    virtual const DataBarRecord* next_record() = 0;
+
+    /**
+     * @brief Moves the cursor to the first record at or after `timestamp_ns`.
+     * Records are time-ordered, so this is a search, not a scan.
+     */
+    virtual void seek(std::uint64_t timestamp_ns) = 0;
+
+    /**
+     * @brief Resolves a record from this source to the id interned at open.
+     * @return The id, or kInvalidSymbolId if no registry was given.
+     */
+    virtual SymbolId symbol_id_of(const DataBarRecord& record) const = 0;
+};
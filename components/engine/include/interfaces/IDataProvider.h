@@ -2,10 +2,16 @@
 
 #pragma once
 #include "core/DataBar.h"
+#include "data/TimeRange.h"
+#include <chrono>
+#include <cstdint>
 #include <optional>
 #include <map>
+#include <stdexcept>
 #include <string>
 
+class MetricsReport;
+
 /**
  * @class IDataProvider
  * @brief An abstract interface for any class that provides sequential market data.
@@ -21,4 +27,40 @@ public:
 
     // The core function of the interface.
     virtual std::optional<DataBar> get_next_bar() = 0;
+
+    /**
+     * @brief Positions the stream right after the first `bars_at_timestamp` bars
+     * stamped `timestamp_ns`: where a run that processed them carries on.
+     * Used to resume from a checkpoint; call before the first get_next_bar().
+     * @throws std::runtime_error If the provider cannot seek, or the data does not match.
+     */
+    virtual void resume_after([[maybe_unused]] std::uint64_t timestamp_ns,
+                              [[maybe_unused]] std::uint64_t bars_at_timestamp) {
+        throw std::runtime_error("This data provider cannot resume from a checkpoint");
+    }
+
+    /**
+     * @brief When the bar last returned by get_next_bar() reached the process,
+     * for live feeds; the EventLoop measures tick-to-decision latency from it.
+     * @return std::nullopt for stored data (the default).
+     */
+    virtual std::optional<std::chrono::steady_clock::time_point> last_arrival() const { return std::nullopt; }
+
+    /**
+     * @brief Latency histograms and counters the provider records (eg feed latency).
+     * The EventLoop reports them alongside its own at the end of a run.
+     * @return nullptr if the provider records none.
+     */
+    virtual const MetricsReport* metrics() const { return nullptr; }
+
+protected:
+    // Reads past the `count` bars at `timestamp_ns` that follow a seek to it.
+    void skip_bars_at(std::uint64_t timestamp_ns, std::uint64_t count) {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            auto bar = get_next_bar();
+            if (!bar || TimeRange::to_epoch_ns(bar->timestamp) != timestamp_ns) {
+                throw std::runtime_error("The market data does not match the checkpoint: fewer bars at its resume time");
+            }
+        }
+    }
 };
\ No newline at end of file
@@ -2,17 +2,47 @@
 
 #pragma once
 
+#include "core/DataBar.h"
+#include "core/Portfolio.h"
+#include "core/SymbolRegistry.h"
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 
-class Portfolio;
 class TradeOrder;
+class ResultsRecorder;
+class StateWriter;
+class StateReader;
 
 class IExecutionHandler {
 public:
     virtual ~IExecutionHandler() = default;
 
+    /**
+     * @brief Sees every bar before any trade for it is executed.
+     * For handlers that simulate the market between bars (eg order book
+     * replay); the default ignores it.
+     * @param symbol The bar's resolved id.
+     * @param bar The bar itself.
+     */
+    virtual void on_market_bar([[maybe_unused]] SymbolId symbol, [[maybe_unused]] const DataBar& bar) {}
+
+    /**
+     * @brief Gives the handler the run's results recorder, to record every fill into.
+     * The default records nothing.
+     */
+    virtual void set_results_recorder([[maybe_unused]] std::shared_ptr<ResultsRecorder> recorder) {}
+
+    /**
+     * @brief Appends the state a resumed run needs to `out`, for checkpoints.
+     * The default has none.
+     */
+    virtual void save_state([[maybe_unused]] StateWriter& out) const {}
+
+    // Restores what save_state() wrote.
+    virtual void restore_state([[maybe_unused]] StateReader& in) {}
+
     /**
      * @brief Executes trades to align the portfolio with the target.
      * This method directly modifies the portfolio object to reflect the
@@ -26,4 +56,35 @@ public:
         const std::map<std::string, double>& approved_target,
         const std::map<std::string, double>& latest_prices
     ) = 0;
-};
\ No newline at end of file
+
+    /**
+     * @brief Dense variant of execute_trades(), used on the hot path.
+     * The default adapts the map-based call, which allocates its maps every bar;
+     * they hold only the held or targeted symbols. Override this for speed.
+     * @param registry Resolves ids to symbols.
+     * @param approved_weights The risk-approved weights, indexed by SymbolId.
+     * @param latest_prices The latest prices, indexed by SymbolId (0.0 = no price yet).
+     */
+    virtual void execute_target_weights(
+        Portfolio& portfolio,
+        const SymbolRegistry& registry,
+        const WeightVector& approved_weights,
+        const PriceVector& latest_prices
+    ) {
+        std::vector<SymbolId> trade_ids;
+        portfolio.tradable_ids(approved_weights, trade_ids);
+
+        std::map<std::string, double> approved_target;
+        std::map<std::string, double> price_map;
+        for (SymbolId id : trade_ids) {
+            if (id < approved_weights.size() && approved_weights[id] != 0.0) {
+                approved_target.emplace(registry.name(id), approved_weights[id]);
+            }
+            if (id < latest_prices.size() && latest_prices[id] != 0.0) {
+                price_map.emplace(registry.name(id), latest_prices[id]);
+            }
+        }
+
+        execute_trades(portfolio, approved_target, price_map);
+    }
+};
@@ -2,11 +2,15 @@
 
 #pragma once
 
+#include "core/DataBar.h"
+#include "core/SymbolRegistry.h"
 #include <map>
 #include <string>
 
 // Forward-declaration of the Portfolio class.
 class Portfolio;
+class StateWriter;
+class StateReader;
 
 /**
  * @class IRiskManager
@@ -20,6 +24,23 @@ class IRiskManager {
 public:
     virtual ~IRiskManager() = default;
 
+    /**
+     * @brief Sees every bar before the target for it is validated.
+     * For rules that need market history (eg volatility); the default ignores it.
+     * @param symbol The bar's resolved id.
+     * @param bar The bar itself.
+     */
+    virtual void on_market_bar([[maybe_unused]] SymbolId symbol, [[maybe_unused]] const DataBar& bar) {}
+
+    /**
+     * @brief Appends the state a resumed run needs to `out`, for checkpoints.
+     * The default has none.
+     */
+    virtual void save_state([[maybe_unused]] StateWriter& out) const {}
+
+    // Restores what save_state() wrote.
+    virtual void restore_state([[maybe_unused]] StateReader& in) {}
+
     /**
      * @brief Validates a target portfolio against risk rules.
      * This function takes the current portfolio and the proposed target, and
@@ -33,4 +54,35 @@ public:
         const Portfolio& current_portfolio,
         double peak_portfolio_value,
         const std::map<std::string, double>& target_portfolio) = 0;
-};
\ No newline at end of file
+
+    /**
+     * @brief Dense variant of validate_target(), used on the hot path.
+     * Rewrites `target_weights` in place into the risk-approved target.
+     * The default adapts the map-based call, which allocates its maps every bar;
+     * override this for speed.
+     * @param registry Resolves ids to symbols.
+     * @param target_weights The proposed weights on input, the approved weights on output.
+     */
+    virtual void validate_target_weights(
+        const Portfolio& current_portfolio,
+        double peak_portfolio_value,
+        const SymbolRegistry& registry,
+        WeightVector& target_weights) {
+        std::map<std::string, double> target_portfolio;
+        for (SymbolId id = 0; id < target_weights.size(); ++id) {
+            if (target_weights[id] != 0.0) {
+                target_portfolio.emplace(registry.name(id), target_weights[id]);
+            }
+        }
+
+        auto approved = validate_target(current_portfolio, peak_portfolio_value, target_portfolio);
+
+        target_weights.assign(registry.size(), 0.0);
+        for (const auto& [symbol, weight] : approved) {
+            SymbolId id = registry.find(symbol);
+            if (id != kInvalidSymbolId) {
+                target_weights[id] = weight;
+            }
+        }
+    }
+};
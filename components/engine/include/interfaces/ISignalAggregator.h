@@ -0,0 +1,28 @@
+// include/interfaces/ISignalAggregator.h
+
+#pragma once
+
+#include "core/SymbolRegistry.h"
+#include "signals/SignalMatrix.h"
+
+/**
+ * @class ISignalAggregator
+ * @brief Combines the signals of every model into one target weight per symbol.
+ *
+ * Signal sources decode the models' replies into a SignalMatrix and hand it
+ * to their aggregator, so the combining rule can be swapped without touching
+ * the transport. Implementations may keep scratch buffers, so one instance
+ * must not be shared between sources.
+ */
+class ISignalAggregator {
+public:
+    virtual ~ISignalAggregator() = default;
+
+    /**
+     * @brief Aggregates the rows of the models that replied.
+     * @param signals One row per model; only active_models() may be read.
+     * @param target_weights Output, resized to signals.symbols() and indexed by SymbolId.
+     *                       Symbols no model has an opinion on get 0.
+     */
+    virtual void aggregate(const SignalMatrix& signals, WeightVector& target_weights) = 0;
+};
@@ -2,10 +2,17 @@
 
 #pragma once
 
+#include "core/DataBar.h"
+#include "core/SymbolRegistry.h"
+#include "metrics/MetricsReport.h"
+#include <cstddef>
 #include <map>
 #include <string>
 #include <nlohmann/json.hpp>
 
+class StateWriter;
+class StateReader;
+
 class ISignalSource {
 public:
     virtual ~ISignalSource() = default;
@@ -17,10 +24,86 @@ public:
      */
     virtual void update_market_data(const nlohmann::json& market_data) = 0;
 
+    /**
+     * @brief Structured variant of update_market_data(), used by the EventLoop.
+     * Sources with a binary transport override this to skip JSON entirely.
+     * The default builds the JSON message the models have always received.
+     * @param bar The latest bar.
+     */
+    virtual void update_market_bar(const DataBar& bar) {
+        update_market_data({
+            {"symbol", bar.symbol},
+            {"close", bar.close}
+            // Add other data points if models need them
+        });
+    }
+
     /**
      * @brief Triggers communication and returns the aggregated portfolio.
      * The EventLoop calls this second, after updating the market data.
      * @return A map defining the final, aggregated target portfolio.
      */
     virtual std::map<std::string, double> get_target_portfolio() = 0;
-};
\ No newline at end of file
+
+    /**
+     * @brief How many bars may be in flight inside the source.
+     * The EventLoop may call update_market_bar() up to this many times before
+     * collecting a result; each get_target_* call then returns the result for
+     * the oldest bar not collected yet. The default of 1 is strict lock-step:
+     * one update, then one get.
+     */
+    virtual std::size_t pipeline_depth() const { return 1; }
+
+    /**
+     * @brief Latency histograms and counters the source records (eg per model).
+     * The EventLoop reports them alongside its own at the end of a run.
+     * @return nullptr if the source records none.
+     */
+    virtual const MetricsReport* metrics() const { return nullptr; }
+
+    /**
+     * @brief Whether the result last returned by a get_target_* call had every
+     * model's answer. False when a model timed out, was skipped or sent a reply
+     * that could not be parsed, and was masked out of that bar. Decorators that
+     * keep results (eg CachedSignalSource) must not keep such a one. The
+     * default, for sources without models, is true.
+     */
+    virtual bool last_result_complete() const { return true; }
+
+    /**
+     * @brief Whether every model has declared that it keeps no state between
+     * bars (`wire::kFlagCausal` on its binary replies), so a recorded answer
+     * can stand in for a bar the models never see. Until then
+     * CachedSignalSource keeps sending them every bar. The default, for sources
+     * that cannot tell, is false.
+     */
+    virtual bool models_stateless() const { return false; }
+
+    /**
+     * @brief Appends the state a resumed run needs (eg request sequence numbers)
+     * to `out`, for checkpoints. Bars sent but not yet processed are not part of
+     * it: a resumed run sends them again. The default has no state.
+     */
+    virtual void save_state([[maybe_unused]] StateWriter& out) const {}
+
+    // Restores what save_state() wrote.
+    virtual void restore_state([[maybe_unused]] StateReader& in) {}
+
+    /**
+     * @brief Dense variant of get_target_portfolio(), used on the hot path.
+     * The default adapts the map-based call, whose map is allocated every bar.
+     * Symbols the registry has never seen are dropped, since there is no price
+     * to trade them at.
+     * @param registry Resolves symbols to ids.
+     * @param target_weights Output, resized to the registry and indexed by SymbolId.
+     */
+    virtual void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) {
+        target_weights.assign(registry.size(), 0.0);
+        for (const auto& [symbol, weight] : get_target_portfolio()) {
+            SymbolId id = registry.find(symbol);
+            if (id != kInvalidSymbolId) {
+                target_weights[id] = weight;
+            }
+        }
+    }
+};
@@ -0,0 +1,268 @@
+// include/logging/Logger.h
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// --- Compile-time log levels ---
+// Log sites below ENGINE_LOG_LEVEL compile to nothing: their arguments are
+// never evaluated. Set with -DENGINE_LOG_LEVEL=ENGINE_LOG_LEVEL_DEBUG (see CMakeLists.txt).
+#define ENGINE_LOG_LEVEL_DEBUG 0
+#define ENGINE_LOG_LEVEL_INFO  1
+#define ENGINE_LOG_LEVEL_WARN  2
+#define ENGINE_LOG_LEVEL_ERROR 3
+#define ENGINE_LOG_LEVEL_OFF   4
+
+#ifndef ENGINE_LOG_LEVEL
+#define ENGINE_LOG_LEVEL ENGINE_LOG_LEVEL_INFO
+#endif
+
+namespace logging {
+
+    inline std::uint64_t now_ns() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    enum class Level : std::uint8_t { Debug, Info, Warn, Error };
+
+    // Type tag written before every argument of a record.
+    enum class ArgType : std::uint8_t { Int, UInt, Double, Bool, String };
+
+    /**
+     * @brief Fixed part of a binary log record. The encoded arguments follow it.
+     * `tag` and `format` must point to string literals: only the pointers are stored.
+     */
+    struct RecordHeader {
+        std::uint32_t size;        // Whole record in bytes, a multiple of 8. 0 marks a wrap.
+        Level level;
+        std::uint8_t arg_count;
+        std::uint16_t reserved;
+        std::uint64_t timestamp_ns; // steady_clock
+        const char* tag;
+        const char* format;
+    };
+
+    /**
+     * @class LogRing
+     * @brief Single-producer/single-consumer byte ring holding one thread's records.
+     *
+     * Records never straddle the end of the buffer: when one does not fit, the
+     * producer writes a wrap marker and starts again at offset 0.
+     */
+    class LogRing {
+    public:
+        explicit LogRing(std::size_t capacity);
+
+        // --- Producer (the owning thread) ---
+        // Returns space for `size` bytes, or nullptr if the ring is full.
+        std::byte* try_reserve(std::size_t size) {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            const std::size_t offset = head & m_mask;
+            const std::size_t contiguous = m_capacity - offset;
+            m_skip = size > contiguous ? contiguous : 0;
+
+            const std::size_t needed = m_skip + size;
+            if (m_capacity - (head - m_cached_tail) < needed) {
+                m_cached_tail = m_tail.load(std::memory_order_acquire);
+                if (m_capacity - (head - m_cached_tail) < needed) {
+                    return nullptr;
+                }
+            }
+
+            if (m_skip) {
+                const std::uint32_t wrap_marker = 0;
+                std::memcpy(m_buffer.get() + offset, &wrap_marker, sizeof(wrap_marker));
+                return m_buffer.get();
+            }
+            return m_buffer.get() + offset;
+        }
+
+        // Publishes the record written into the last reservation.
+        void commit(std::size_t size) {
+            m_head.store(m_head.load(std::memory_order_relaxed) + m_skip + size, std::memory_order_release);
+        }
+
+        // --- Consumer (the logger thread) ---
+        // Returns the oldest unread record, or nullptr if there is none.
+        const std::byte* peek();
+        void release(std::size_t size);
+
+        // Set when the owning thread exits; the ring is dropped once drained.
+        std::atomic<bool> retired{false};
+
+    private:
+        const std::size_t m_capacity;
+        const std::size_t m_mask;
+        std::unique_ptr<std::byte[]> m_buffer;
+
+        alignas(64) std::atomic<std::size_t> m_head{0}; // Written by the producer
+        std::size_t m_cached_tail = 0;
+        std::size_t m_skip = 0;
+
+        alignas(64) std::atomic<std::size_t> m_tail{0}; // Written by the consumer
+    };
+
+    /**
+     * @class Logger
+     * @brief Asynchronous logger: callers encode, a background thread formats.
+     *
+     * A log call copies its level, two literal pointers, a timestamp and its
+     * arguments (numbers as-is, strings by value) into the calling thread's
+     * ring and returns; it never formats, locks or makes a syscall. The logger
+     * thread decodes the records, substitutes them into `{}` placeholders and
+     * writes Info and Debug lines to stdout, Warn and Error lines to stderr.
+     * When a ring is full the record is dropped and counted rather than
+     * blocking the caller. Records from one thread stay in order.
+     *
+     * Use the LOG_* macros rather than write() so that compiled-out levels cost nothing.
+     */
+    class Logger {
+    public:
+        static constexpr std::size_t kRingCapacity = 1 << 20; // Bytes per thread
+
+        static Logger& instance();
+
+        ~Logger();
+
+        // Runtime threshold, on top of ENGINE_LOG_LEVEL.
+        void set_min_level(Level level) { m_min_level.store(level, std::memory_order_relaxed); }
+
+        // Redirects output. Both streams stay owned by the caller.
+        void set_output(std::FILE* out, std::FILE* err);
+
+        // Blocks until everything logged before the call has been written.
+        void flush();
+
+        std::uint64_t dropped_records() const { return m_dropped.load(std::memory_order_relaxed); }
+
+        template <typename... Args>
+        void write(Level level, const char* tag, const char* format, const Args&... args) {
+            if (level < m_min_level.load(std::memory_order_relaxed)) {
+                return;
+            }
+            static_assert(sizeof...(Args) < 256, "Too many log arguments");
+
+            const std::size_t size = (sizeof(RecordHeader) + (encoded_size(args) + ... + 0) + 7) & ~std::size_t{7};
+            LogRing& ring = thread_ring();
+            std::byte* record = ring.try_reserve(size);
+            if (!record) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            const RecordHeader header{
+                static_cast<std::uint32_t>(size), level, static_cast<std::uint8_t>(sizeof...(Args)), 0,
+                now_ns(), tag, format
+            };
+            std::memcpy(record, &header, sizeof(header));
+            [[maybe_unused]] std::byte* cursor = record + sizeof(header); // Unused when there are no arguments
+            (encode(cursor, args), ...);
+            ring.commit(size);
+        }
+
+        // --- Safety: Disallow copy/move ---
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+        Logger(Logger&&) = delete;
+        Logger& operator=(Logger&&) = delete;
+
+    private:
+        Logger();
+
+        LogRing& thread_ring();
+        void run();
+        void format_record(const std::byte* record, std::string& line) const;
+
+        template <typename T>
+        static std::size_t encoded_size(const T& value) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return 1 + sizeof(std::uint64_t);
+            } else {
+                static_assert(std::is_convertible_v<const T&, std::string_view>,
+                              "Log arguments must be numbers or strings");
+                return 1 + sizeof(std::uint32_t) + std::string_view(value).size();
+            }
+        }
+
+        template <typename T>
+        static void encode(std::byte*& cursor, const T& value) {
+            auto put = [&cursor](const void* data, std::size_t size) {
+                std::memcpy(cursor, data, size);
+                cursor += size;
+            };
+            ArgType type;
+            if constexpr (std::is_same_v<T, bool>) {
+                type = ArgType::Bool;
+                const std::uint64_t raw = value;
+                put(&type, 1);
+                put(&raw, sizeof(raw));
+            } else if constexpr (std::is_floating_point_v<T>) {
+                type = ArgType::Double;
+                const double raw = value;
+                put(&type, 1);
+                put(&raw, sizeof(raw));
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                type = ArgType::Int;
+                const std::int64_t raw = value;
+                put(&type, 1);
+                put(&raw, sizeof(raw));
+            } else if constexpr (std::is_integral_v<T>) {
+                type = ArgType::UInt;
+                const std::uint64_t raw = value;
+                put(&type, 1);
+                put(&raw, sizeof(raw));
+            } else {
+                type = ArgType::String;
+                const std::string_view text(value);
+                const auto length = static_cast<std::uint32_t>(text.size());
+                put(&type, 1);
+                put(&length, sizeof(length));
+                put(text.data(), text.size());
+            }
+        }
+
+        std::atomic<Level> m_min_level{Level::Debug};
+        std::atomic<std::uint64_t> m_dropped{0};
+        const std::uint64_t m_start_ns;
+
+        std::mutex m_mutex; // Guards everything below; never taken on the logging path
+        std::condition_variable m_wake;
+        std::condition_variable m_flushed;
+        std::vector<std::shared_ptr<LogRing>> m_rings;
+        std::uint64_t m_flush_requested = 0;
+        std::uint64_t m_flush_completed = 0;
+        bool m_stop = false;
+        std::FILE* m_out = stdout;
+        std::FILE* m_err = stderr;
+
+        std::thread m_thread;
+    };
+
+} // namespace logging
+
+#define ENGINE_LOG(level_value, level, tag, ...)                                         \
+    do {                                                                                  \
+        if constexpr ((level_value) >= ENGINE_LOG_LEVEL) {                               \
+            ::logging::Logger::instance().write((level), (tag), __VA_ARGS__);            \
+        }                                                                                 \
+    } while (0)
+
+// Usage: LOG_INFO("RiskManager", "Scaled {} to {}%", symbol, weight * 100);
+#define LOG_DEBUG(tag, ...) ENGINE_LOG(ENGINE_LOG_LEVEL_DEBUG, ::logging::Level::Debug, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  ENGINE_LOG(ENGINE_LOG_LEVEL_INFO,  ::logging::Level::Info,  tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  ENGINE_LOG(ENGINE_LOG_LEVEL_WARN,  ::logging::Level::Warn,  tag, __VA_ARGS__)
+#define LOG_ERROR(tag, ...) ENGINE_LOG(ENGINE_LOG_LEVEL_ERROR, ::logging::Level::Error, tag, __VA_ARGS__)
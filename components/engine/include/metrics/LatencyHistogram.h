@@ -0,0 +1,75 @@
+// include/metrics/LatencyHistogram.h
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class LatencyHistogram
+ * @brief Fixed-size, log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values (nanoseconds) below 64 are counted exactly. Above that, every power
+ * of two is split into 32 equal sub-buckets, so any recorded value is
+ * reported to within about 1.6% (bucket midpoint) over the whole uint64 range.
+ * Recording is a bit scan and an increment: no allocation, no branches on
+ * the data beyond the small-value check.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr std::uint64_t kSubBuckets = 1ull << kSubBucketBits;       // Per power of two
+    static constexpr std::uint64_t kExactLimit = 2 * kSubBuckets;              // Counted exactly below this
+    static constexpr std::size_t kBucketCount =
+        kExactLimit + (64 - kSubBucketBits - 1) * kSubBuckets;
+
+    void record(std::uint64_t value_ns) {
+        ++m_buckets[bucket_index(value_ns)];
+        ++m_count;
+        m_sum += value_ns;
+        m_min = std::min(m_min, value_ns);
+        m_max = std::max(m_max, value_ns);
+    }
+
+    void record(std::chrono::nanoseconds duration) {
+        record(static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(0, duration.count())));
+    }
+
+    /**
+     * @brief The value at or below which `quantile` (0..1) of the samples fall.
+     * @return 0 if nothing was recorded.
+     */
+    std::uint64_t percentile(double quantile) const;
+
+    std::uint64_t count() const { return m_count; }
+    std::uint64_t min() const { return m_count ? m_min : 0; }
+    std::uint64_t max() const { return m_max; }
+    double mean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+    void merge(const LatencyHistogram& other);
+    void reset() { *this = LatencyHistogram(); }
+
+    static std::size_t bucket_index(std::uint64_t value) {
+        if (value < kExactLimit) {
+            return static_cast<std::size_t>(value);
+        }
+        const unsigned shift = std::bit_width(value) - 1 - kSubBucketBits; // >= 1
+        const std::uint64_t sub_bucket = (value >> shift) - kSubBuckets;   // 0 .. kSubBuckets-1
+        return static_cast<std::size_t>(kExactLimit + (shift - 1) * kSubBuckets + sub_bucket);
+    }
+
+    // Midpoint of the values that map to `index`.
+    static std::uint64_t bucket_value(std::size_t index);
+
+private:
+    std::array<std::uint64_t, kBucketCount> m_buckets{};
+    std::uint64_t m_count = 0;
+    std::uint64_t m_sum = 0;
+    std::uint64_t m_min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t m_max = 0;
+};
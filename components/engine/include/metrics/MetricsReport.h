@@ -0,0 +1,55 @@
+// include/metrics/MetricsReport.h
+
+#pragma once
+
+#include "metrics/LatencyHistogram.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+/**
+ * @class MetricsReport
+ * @brief A named set of latency histograms and counters.
+ *
+ * Components look their histograms and counters up once, at construction,
+ * and keep the returned references (they stay valid for the report's
+ * lifetime), so recording never touches the names. Entries keep the order in
+ * which they were first requested, which is the order they are reported in.
+ */
+class MetricsReport {
+public:
+    explicit MetricsReport(std::string title) : m_title(std::move(title)) {}
+
+    LatencyHistogram& histogram(std::string_view name);
+    std::uint64_t& counter(std::string_view name);
+
+    const std::string& title() const { return m_title; }
+
+    // Logs one line per entry (count, mean, p50/p99/p99.9, max in microseconds).
+    void log_summary() const;
+
+    // {"histograms": {name: {count, mean_ns, min_ns, p50_ns, p99_ns, p999_ns, max_ns}}, "counters": {name: n}}
+    nlohmann::json to_json() const;
+
+    // --- Safety: Disallow copy/move (components hold references into it) ---
+    MetricsReport(const MetricsReport&) = delete;
+    MetricsReport& operator=(const MetricsReport&) = delete;
+    MetricsReport(MetricsReport&&) = delete;
+    MetricsReport& operator=(MetricsReport&&) = delete;
+
+private:
+    struct NamedHistogram {
+        std::string name;
+        LatencyHistogram histogram;
+    };
+    struct NamedCounter {
+        std::string name;
+        std::uint64_t value = 0;
+    };
+
+    std::string m_title;
+    std::deque<NamedHistogram> m_histograms; // Deque: references survive growth
+    std::deque<NamedCounter> m_counters;
+};
@@ -0,0 +1,141 @@
+// include/metrics/PerformanceAnalytics.h
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+class Portfolio;
+class StateWriter;
+class StateReader;
+
+/**
+ * @brief The performance statistics of one run, as of the latest finish().
+ *
+ * Returns are per period, where a period is one bar timestamp (all symbols'
+ * bars at that time). Ratios use a zero risk-free rate and are annualized
+ * with `periods_per_year`; when that is 0 (fewer than two periods to infer
+ * it from) they are per period.
+ */
+struct PerformanceSummary {
+    std::uint64_t periods = 0;
+    double periods_per_year = 0.0;
+
+    double initial_equity = 0.0;
+    double final_equity = 0.0;
+    double total_return = 0.0;
+
+    double mean_return = 0.0;               // Per period
+    double return_volatility = 0.0;         // Per period, sample standard deviation
+    double downside_deviation = 0.0;        // Per period, root mean square of the negative returns
+    double best_return = 0.0;
+    double worst_return = 0.0;
+    double sharpe_ratio = 0.0;              // Annualized
+    double sortino_ratio = 0.0;             // Annualized
+
+    double max_drawdown = 0.0;              // Fraction of the peak
+    std::uint64_t max_drawdown_periods = 0; // Longest stretch below a previous peak
+    double max_drawdown_seconds = 0.0;      // The same stretch in wall-clock time
+
+    double average_gross_exposure = 0.0;    // Sum of |position value| / equity, averaged over periods
+    double max_gross_exposure = 0.0;
+    double average_net_exposure = 0.0;      // Market value / equity
+    double time_in_market = 0.0;            // Fraction of periods holding any position
+
+    std::uint64_t fills = 0;
+    std::uint64_t periods_with_fills = 0;
+    double traded_notional = 0.0;
+    double turnover = 0.0;                  // Traded notional / average equity over the run
+    double annual_turnover = 0.0;
+
+    // Logs the summary, one group of statistics per line.
+    void log_summary() const;
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @class PerformanceAnalytics
+ * @brief Return, risk, drawdown, exposure and trading statistics kept while a run progresses.
+ *
+ * Fed once per bar by the EventLoop; everything is a running sum (Welford
+ * for the return variance), so memory is constant however long the run and
+ * no equity curve has to be kept or post-processed. A period closes when
+ * the first bar of a later timestamp arrives, and at finish().
+ */
+class PerformanceAnalytics {
+public:
+    /**
+     * @param initial_equity The portfolio value before the first bar.
+     * @param periods_per_year Annualization factor; 0 infers it from the
+     *        timestamps (periods observed per year of elapsed time).
+     */
+    explicit PerformanceAnalytics(double initial_equity, double periods_per_year = 0.0);
+
+    /**
+     * @brief Records the state after one bar's trades.
+     * @param timestamp The bar's timestamp.
+     * @param portfolio The portfolio after the bar's trades.
+     * @param peak_equity The run's historical peak value, as used by the risk manager.
+     */
+    void on_bar(std::chrono::system_clock::time_point timestamp, const Portfolio& portfolio, double peak_equity);
+
+    /**
+     * @brief Closes the open period and computes the summary.
+     * Recording may continue afterwards; call it again for an updated summary.
+     */
+    const PerformanceSummary& finish();
+
+    const PerformanceSummary& summary() const { return m_summary; }
+
+    // Checkpointing: the open period and every running sum.
+    void save_state(StateWriter& writer) const;
+    void restore_state(StateReader& reader);
+
+private:
+    // Folds the period ending with the latest recorded bar into the running sums.
+    void close_period();
+
+    // Calls `visit` with every field of the running state, for save_state() and restore_state().
+    template <typename Self, typename Visit>
+    static void visit_state(Self& self, Visit&& visit);
+
+    double m_initial_equity;
+    double m_periods_per_year;
+
+    // The open period: the latest bar's values
+    bool m_has_open_period = false;
+    std::int64_t m_period_ns = 0;
+    double m_equity = 0.0;
+    double m_peak = 0.0;
+    double m_gross_exposure = 0.0;
+    double m_market_value = 0.0;
+    std::uint64_t m_fills = 0;
+    double m_traded_notional = 0.0;
+
+    // Running sums over closed periods
+    std::uint64_t m_periods = 0;
+    std::int64_t m_first_period_ns = 0;
+    double m_previous_equity;
+    std::uint64_t m_previous_fills = 0;
+    double m_mean = 0.0;                // Welford
+    double m_m2 = 0.0;
+    double m_downside_sum_squares = 0.0;
+    double m_best_return = 0.0;
+    double m_worst_return = 0.0;
+    double m_equity_sum = 0.0;
+    double m_running_peak;
+    double m_max_drawdown = 0.0;
+    std::uint64_t m_drawdown_periods = 0;   // Current stretch below the peak
+    std::int64_t m_drawdown_start_ns = 0;   // Period of the peak it is below
+    std::uint64_t m_max_drawdown_periods = 0;
+    std::int64_t m_max_drawdown_ns = 0;
+    double m_gross_exposure_sum = 0.0;
+    double m_max_gross_exposure = 0.0;
+    double m_net_exposure_sum = 0.0;
+    std::uint64_t m_invested_periods = 0;
+    std::uint64_t m_periods_with_fills = 0;
+
+    PerformanceSummary m_summary;
+};
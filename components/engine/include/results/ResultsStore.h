@@ -0,0 +1,227 @@
+// include/results/ResultsStore.h
+
+#pragma once
+
+#include "core/SpscQueue.h"
+#include "core/SymbolRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+/**
+ * @brief One row on its way to the database: a fill or a bar's equity snapshot.
+ * Plain data, so queuing it is a copy of a few words.
+ */
+struct ResultRow {
+    enum class Kind : std::uint8_t { Fill, Equity };
+
+    struct FillFields {
+        SymbolId symbol;
+        long long shares;       // Signed: positive bought, negative sold
+        double price;           // Average execution price, slippage included
+        double commission;
+    };
+
+    struct EquityFields {
+        double equity;          // Total portfolio value after the bar's trades
+        double cash;
+        double peak;            // Historical peak used for the drawdown limit
+    };
+
+    Kind kind;
+    std::uint64_t bar_index;
+    std::uint64_t timestamp_ns;
+    union {
+        FillFields fill;
+        EquityFields equity;
+    };
+};
+
+/**
+ * @class ResultsRecorder
+ * @brief The per-run handle the engine records into; one run, one producer thread.
+ *
+ * Recording is a push onto the run's own lock-free ring, which the store's
+ * writer thread drains. When the writer falls behind and the ring is full
+ * the producer waits rather than dropping rows; `stalls()` counts how often.
+ * Obtain one from ResultsStore::begin_run().
+ */
+class ResultsRecorder {
+public:
+    ResultsRecorder(std::uint32_t run_id, std::string label, std::size_t capacity);
+
+    // --- Producer side (the run's thread) ---
+
+    // Sets the bar the following rows belong to.
+    void begin_bar(std::chrono::system_clock::time_point timestamp);
+
+    void record_fill(SymbolId symbol, long long shares, double price, double commission) {
+        ResultRow row{ResultRow::Kind::Fill, m_bar_index, m_timestamp_ns, {}};
+        row.fill = {symbol, shares, price, commission};
+        push(row);
+        ++m_fills;
+    }
+
+    void record_equity(double equity, double cash, double peak) {
+        ResultRow row{ResultRow::Kind::Equity, m_bar_index, m_timestamp_ns, {}};
+        row.equity = {equity, cash, peak};
+        push(row);
+        m_final_equity = equity;
+        m_final_cash = cash;
+        m_peak_equity = peak;
+    }
+
+    /**
+     * @brief Ends the run: no rows may be recorded afterwards.
+     * Copies the names of `registry`'s symbols so fills can be joined to them.
+     */
+    void finish(const SymbolRegistry& registry);
+
+    std::uint32_t run_id() const { return m_run_id; }
+    const std::string& label() const { return m_label; }
+    std::uint64_t stalls() const { return m_stalls; }
+
+    // --- Safety: Disallow copy/move ---
+    ResultsRecorder(const ResultsRecorder&) = delete;
+    ResultsRecorder& operator=(const ResultsRecorder&) = delete;
+
+private:
+    friend class ResultsStore;
+
+    void push(const ResultRow& row) {
+        if (!m_rows.try_push(row)) {
+            push_slow(row);
+        }
+    }
+    void push_slow(const ResultRow& row);
+
+    const std::uint32_t m_run_id;
+    const std::string m_label;
+    SpscQueue<ResultRow> m_rows;
+
+    // Producer state
+    std::uint64_t m_bar_index = 0;
+    std::uint64_t m_timestamp_ns = 0;
+    bool m_started = false;
+    std::uint64_t m_stalls = 0;
+
+    // Written by finish() before m_finished is set; read by the writer after
+    std::uint64_t m_fills = 0;
+    double m_final_equity = 0.0;
+    double m_final_cash = 0.0;
+    double m_peak_equity = 0.0;
+    std::vector<std::string> m_symbol_names;
+    std::atomic<bool> m_finished{false};
+};
+
+/**
+ * @class ResultsStore
+ * @brief Persists every run's fills and per-bar equity curve to SQLite in the background.
+ *
+ * Tables (created if missing, appended to otherwise):
+ *
+ *     runs(run_id, label, bars, fills, final_equity, final_cash, peak_equity)
+ *     symbols(run_id, symbol_id, name)
+ *     fills(run_id, bar_index, timestamp_ns, symbol_id, shares, price, commission)
+ *     equity(run_id, bar_index, timestamp_ns, equity, cash, peak)
+ *
+ * The bar loop never touches SQLite: each run records into its own SPSC
+ * ring (see ResultsRecorder), and a single writer thread drains all rings
+ * through prepared statements, committing in large transactions on a WAL
+ * journal. Runs of a sweep may record concurrently from different threads.
+ *
+ * SQLite errors after construction are logged once; later rows are then
+ * discarded (and counted) so a full disk never stalls a backtest. The store
+ * must outlive the recording of every run it handed out.
+ */
+class ResultsStore {
+public:
+    static constexpr std::size_t kDefaultRingCapacity = 1 << 16;
+    static constexpr std::size_t kDefaultRowsPerTransaction = 50'000;
+
+    /**
+     * @param db_path The database file; created if it does not exist.
+     * @param ring_capacity Rows each run can queue before its producer waits.
+     * @param rows_per_transaction Rows committed together while the writer is busy.
+     * @throws std::runtime_error If the database cannot be opened or its schema created.
+     */
+    explicit ResultsStore(const std::string& db_path,
+                          std::size_t ring_capacity = kDefaultRingCapacity,
+                          std::size_t rows_per_transaction = kDefaultRowsPerTransaction);
+
+    // Writes everything still queued, then closes the database.
+    ~ResultsStore();
+
+    /**
+     * @brief Starts a run and returns the handle to record it with. Thread-safe.
+     * Run ids continue from the largest already in the database.
+     */
+    std::shared_ptr<ResultsRecorder> begin_run(const std::string& label);
+
+    // Blocks until every row recorded before the call is committed.
+    void flush();
+
+    // --- Diagnostics ---
+    std::uint64_t rows_written() const { return m_rows_written.load(std::memory_order_relaxed); }
+    std::uint64_t rows_discarded() const { return m_rows_discarded.load(std::memory_order_relaxed); }
+
+    // --- Safety: Disallow copy/move ---
+    ResultsStore(const ResultsStore&) = delete;
+    ResultsStore& operator=(const ResultsStore&) = delete;
+
+private:
+    void writer_loop();
+    // Moves up to `limit` rows of one run into the open transaction; returns how many.
+    std::size_t drain(ResultsRecorder& recorder, std::size_t limit);
+    void write_row(std::uint32_t run_id, const ResultRow& row);
+    void write_run_start(const ResultsRecorder& recorder);
+    void write_run_end(const ResultsRecorder& recorder);
+    void begin_transaction();
+    void commit();
+    void exec(const char* sql);
+    // Runs a prepared statement once and resets it.
+    void step(sqlite3_stmt* statement);
+    // Logs the error, rolls back the open transaction and stops writing.
+    void fail(const char* message);
+    void close_database();
+
+    sqlite3* m_db = nullptr;
+    sqlite3_stmt* m_insert_fill = nullptr;
+    sqlite3_stmt* m_insert_equity = nullptr;
+    sqlite3_stmt* m_insert_run = nullptr;
+    sqlite3_stmt* m_update_run = nullptr;
+    sqlite3_stmt* m_insert_symbol = nullptr;
+
+    const std::size_t m_ring_capacity;
+    const std::size_t m_rows_per_transaction;
+
+    // Runs handed out but not yet fully written; guarded by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup_cv;
+    std::condition_variable m_flushed_cv;
+    std::vector<std::shared_ptr<ResultsRecorder>> m_new_runs;
+    std::uint64_t m_flush_requested = 0;
+    std::uint64_t m_flush_completed = 0;
+    std::uint32_t m_next_run_id = 1;
+    bool m_stop = false;
+
+    // Writer thread state
+    std::vector<std::shared_ptr<ResultsRecorder>> m_active_runs;
+    bool m_in_transaction = false;
+    std::size_t m_rows_in_transaction = 0;
+    bool m_failed = false;
+
+    std::atomic<std::uint64_t> m_rows_written{0};
+    std::atomic<std::uint64_t> m_rows_discarded{0};
+    std::thread m_writer;
+};
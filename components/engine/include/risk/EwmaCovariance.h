@@ -0,0 +1,76 @@
+// include/risk/EwmaCovariance.h
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class StateWriter;
+class StateReader;
+
+/**
+ * @class EwmaCovariance
+ * @brief Exponentially weighted covariance of returns, updated one period at a time.
+ *
+ * Each update is the rank-1 step  C = decay * C + (1 - decay) * r r^T.
+ * The decay is not applied to the matrix: a running scale factor absorbs it,
+ * so an update only touches the rows of symbols whose return is non-zero,
+ * and the matrix is rescaled once every few hundred periods to stay in range.
+ *
+ * The matrix is dense and row-major with one row per SymbolId. Both kernels
+ * (the update and the quadratic form) are row-wise axpy loops with no
+ * reductions across a row, so the compiler vectorizes them.
+ *
+ * The quadratic form keeps C w between calls: while the matrix is unchanged,
+ * the next call only adds the rows of the weights that changed. Within one
+ * bar timestamp, when only the ticking symbol's target moves, that is O(N)
+ * instead of O(N^2).
+ */
+class EwmaCovariance {
+public:
+    /**
+     * @param decay Weight kept by the previous estimate each period, in (0, 1)
+     *              (eg 0.94, the RiskMetrics daily value).
+     * @throws std::invalid_argument if it is out of range.
+     */
+    explicit EwmaCovariance(double decay);
+
+    /**
+     * @brief Grows the matrix to `symbols` rows. New symbols start with no (co)variance.
+     */
+    void resize(std::size_t symbols);
+
+    /**
+     * @brief Folds one period's returns into the estimate.
+     * @param returns One entry per symbol (at most symbols() long); 0 for symbols that did not move.
+     */
+    void update(const std::vector<double>& returns);
+
+    /**
+     * @brief The variance of a portfolio's one-period return, w^T C w.
+     * @param weights One entry per symbol (at most symbols() long).
+     */
+    double portfolio_variance(const std::vector<double>& weights);
+
+    double covariance(std::size_t i, std::size_t j) const { return m_scale * m_matrix[i * m_symbols + j]; }
+    std::size_t symbols() const { return m_symbols; }
+    std::size_t observations() const { return m_observations; }
+
+    // Checkpointing: the matrix as stored (with its scale) and the cached C w.
+    void save_state(StateWriter& writer) const;
+    void restore_state(StateReader& reader);
+
+private:
+    // Multiplies the scale back into the matrix.
+    void normalize();
+
+    double m_decay;
+    double m_scale = 1.0;        // The true matrix is m_scale * m_matrix
+    std::size_t m_symbols = 0;
+    std::size_t m_observations = 0;
+    std::vector<double> m_matrix;
+    // C w for the weights of the last portfolio_variance() call
+    std::vector<double> m_product;
+    std::vector<double> m_product_weights;
+    bool m_product_valid = false;
+};
@@ -3,25 +3,88 @@
 #pragma once
 
 #include "interfaces/IRiskManager.h"
+#include "risk/EwmaCovariance.h"
+#include <chrono>
+#include <cstddef>
+#include <vector>
 
-class PortfolioRiskManager : public IRiskManager {
+/**
+ * @brief Portfolio-level volatility rules for PortfolioRiskManager. Both are off by default.
+ * A period is one bar timestamp: the returns of all symbols that traded at it
+ * are folded into the covariance together when the next timestamp arrives.
+ */
+struct VolatilityLimits {
+    double target_volatility = 0.0;     // Annualized volatility budget; 0 disables the rule
+    double max_value_at_risk = 0.0;     // One-period parametric VaR, as a fraction of equity; 0 disables
+    double var_z_score = 2.326;         // Normal quantile of the VaR (2.326 = 99%)
+    double periods_per_year = 252.0;    // Bar timestamps per year, to annualize the volatility
+    double ewma_decay = 0.94;           // See EwmaCovariance
+    std::size_t min_observations = 20;  // Periods seen before either rule applies
+};
+
+class PortfolioRiskManager final : public IRiskManager {
     public:
         /**
          * @brief Constructs the risk manager with specific risk parameters.
          * @param max_pos_weight The max allocation to any single asset (e.g., 0.25 for 25%).
          * @param max_leverage The max total portfolio weight (e.g., 1.0 for no leverage).
          * @param max_drawdown The max allowed loss from the peak portfolio value (e.g., 0.15 for 15%).
+         * @param volatility_limits Optional volatility budget and VaR limit. validate_target()
+         *        resolves its symbols through the portfolio's registry to apply them.
          */
 
-        PortfolioRiskManager(double max_pos_weight, double max_leverage, double max_drawdown);
+        PortfolioRiskManager(double max_pos_weight, double max_leverage, double max_drawdown,
+                             const VolatilityLimits& volatility_limits = {});
+
+        // Tracks closes per timestamp and updates the return covariance when one completes.
+        void on_market_bar(SymbolId symbol, const DataBar& bar) override;
+
+        // The covariance estimate and the open period's closes.
+        void save_state(StateWriter& out) const override;
+        void restore_state(StateReader& in) override;
+
         std::map<std::string, double> validate_target(
             const Portfolio& current_portfolio,
             double peak_portfolio_value,
             const std::map<std::string, double>& target_portfolio
         ) override;
 
+        void validate_target_weights(
+            const Portfolio& current_portfolio,
+            double peak_portfolio_value,
+            const SymbolRegistry& registry,
+            WeightVector& target_weights
+        ) override;
+
+        // The predicted one-period volatility of `target_weights` (0 until enough periods were seen).
+        double predicted_volatility(const WeightVector& target_weights);
+
+        const EwmaCovariance& covariance() const { return m_covariance; }
+
     private:
+        // Folds the returns of the finished period into the covariance.
+        void close_period();
+
+        // True while the drawdown from the peak exceeds the limit. Logs once per breach.
+        bool drawdown_exceeded(const Portfolio& current_portfolio, double peak_portfolio_value);
+
+        // The factor (at most 1) that brings `target_weights` within the volatility budget and VaR limit.
+        double volatility_scaling(const WeightVector& target_weights);
+
         double m_max_pos_weight;
         double m_max_leverage;
         double m_max_drawdown;
-};
\ No newline at end of file
+        bool m_drawdown_breached = false; // Already logged; reset once back under the limit
+
+        // --- Volatility rules ---
+        VolatilityLimits m_volatility_limits;
+        bool m_volatility_enabled;
+        EwmaCovariance m_covariance;
+        std::chrono::system_clock::time_point m_period_timestamp{};
+        std::vector<double> m_last_close;   // Latest close per symbol, this period included
+        std::vector<double> m_period_close; // Close per symbol at the end of the previous period
+        std::vector<SymbolId> m_period_symbols; // Symbols that traded this period
+        std::vector<bool> m_in_period;          // Per symbol: listed in m_period_symbols
+        std::vector<double> m_returns;      // Scratch, one log return per symbol
+        WeightVector m_map_weights;         // Scratch, validate_target()'s target by SymbolId
+};
@@ -4,22 +4,69 @@
 
 #include "interfaces/ISignalSource.h"
 #include "core/SignalPacket.h"
+#include "signals/SignalAggregation.h"
+#include "signals/WireProtocol.h"
+#include "metrics/MetricsReport.h"
 #include <zmq.hpp>
 #include <nlohmann/json.hpp>
 #include <chrono>
+#include <memory>
 #include <vector>
 #include <string>
 
+/**
+ * @class AggregatedIPCSource
+ * @brief Queries every model over ZeroMQ and aggregates their signals.
+ *
+ * Each model is spoken to in the binary wire format (see WireProtocol.h) once
+ * it has answered in binary, and in JSON until then, so old JSON-only models
+ * keep working unchanged.
+ *
+ * Batched mode (`batch_size` > 1): the source advertises a pipeline depth of
+ * `batch_size`, so the EventLoop hands it that many bars up front. Once every
+ * model has declared itself causal (binary replies carrying `kFlagCausal`),
+ * all queued bars go out in one request per model and the per-bar results are
+ * served locally. Until then, and whenever a model is not causal, the queued
+ * bars are sent one at a time, so results are the same either way.
+ *
+ * Each model's reply latency (send to receive) and the number of replies it
+ * failed to deliver within the timeout are recorded in metrics().
+ *
+ * Replies are combined by an ISignalAggregator (confidence-weighted mean by
+ * default); models that miss the timeout are masked out of that bar.
+ *
+ * Models are reached over DEALER sockets with the same `[request_id, <empty>,
+ * payload]` envelope as PipelinedIPCSource, so a model that misses a timeout
+ * does not wedge its socket: its late reply is recognised by id and dropped.
+ */
 class AggregatedIPCSource : public ISignalSource {
 public:
+    /**
+     * @param model_endpoints One ZeroMQ endpoint per model.
+     * @param reply_timeout How long to wait for replies to one bar. A batch waits
+     *                      this long per bar it carries.
+     * @param batch_size The maximum number of bars per request (1 = one bar per request).
+     * @param aggregator Combines the models' signals. nullptr selects WeightedMeanAggregator.
+     */
     AggregatedIPCSource(const std::vector<std::string>& model_endpoints,
-                        std::chrono::milliseconds reply_timeout);
+                        std::chrono::milliseconds reply_timeout,
+                        std::size_t batch_size = 1,
+                        std::unique_ptr<ISignalAggregator> aggregator = nullptr);
 
     ~AggregatedIPCSource() override = default;
 
     // Implements a two-step interface contract
     void update_market_data(const nlohmann::json& market_data) override;
+    void update_market_bar(const DataBar& bar) override;
     std::map<std::string, double> get_target_portfolio() override;
+    void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override;
+    std::size_t pipeline_depth() const override { return m_batch_size; }
+    const MetricsReport* metrics() const override { return &m_metrics; }
+    bool last_result_complete() const override { return m_last_result_complete; }
+    bool models_stateless() const override; // Every model speaks binary and has declared itself causal
+
+    // --- Diagnostics ---
+    std::uint64_t late_replies() const { return m_late_replies; } // To requests that already timed out
 
     // --- Safety: Disallow copy/move ---
     AggregatedIPCSource(const AggregatedIPCSource&) = delete;
@@ -28,10 +75,76 @@ public:
     AggregatedIPCSource& operator=(AggregatedIPCSource&&) = delete;
 
 private:
+    // Returns the replies for the oldest submitted bar, batching requests when possible.
+    // Valid until the next call: the buffers are reused.
+    const ModelReplies& next_signals();
+
+    // Sends one bar (or, if null, the raw JSON market data) to every model and
+    // collects the replies that arrive in time into m_replies.
+    const ModelReplies& collect_signals(const DataBar* bar);
+
+    // True once batching is enabled and models_stateless().
+    bool can_batch() const;
+
+    // Sends all queued bars (up to m_batch_size) as one request per model and
+    // leaves their per-bar results in m_batch_replies, to be served in order.
+    void collect_signal_batch();
+
+    // Stores one reply (binary or JSON) as a Signals message and records which format the model speaks.
+    void parse_reply(std::size_t model_index, const zmq::message_t& reply, std::string& out);
+
+    // Sends [request_id, <empty>, payload] to one model. False if its queue is full.
+    bool send_request(std::size_t model_index, std::uint64_t request_id, const std::string& payload);
+
+    // Reads one model's queued replies until the one to `request_id` is in m_reply.
+    // Replies to older requests and malformed envelopes are dropped.
+    bool receive_reply(std::size_t model_index, std::uint64_t request_id);
+
+    // Polls until every model has replied to `request_id` or `deadline` passes, calling
+    // `on_reply(model_index, reply)` once per model. Records latency and timeouts.
+    template <typename OnReply>
+    std::size_t poll_replies(std::uint64_t request_id,
+                             std::chrono::steady_clock::time_point sent_at,
+                             std::chrono::steady_clock::time_point deadline,
+                             OnReply&& on_reply);
+
     zmq::context_t m_context;
     std::vector<zmq::socket_t> m_sockets;
+    std::vector<wire::ReplyFormat> m_wire_formats; // Negotiated format, one per model
+    std::vector<bool> m_causal_models;             // Declared via kFlagCausal, one per model
     std::chrono::milliseconds m_reply_timeout;
+    std::size_t m_batch_size;
+    std::uint64_t m_next_request_id = 0;
 
-    // Holds the data passed in from the update_market_data call
+    // Holds the data passed in from the update_market_data/update_market_bar call
     nlohmann::json m_latest_market_data;
+    std::vector<DataBar> m_queued_bars;                  // Submitted, not yet sent
+    std::vector<ModelReplies> m_batch_replies;          // One entry per bar of the last batch
+    std::size_t m_batch_size_sent = 0;                  // Entries of m_batch_replies in use
+    std::size_t m_batch_next = 0;                       // Next to serve; older than m_queued_bars
+    std::vector<std::string> m_batch_split;             // Scratch, one model's reply to a batch, per bar
+
+    // Encoded requests, reused across bars
+    std::string m_binary_request;
+    std::string m_json_request;
+
+    std::unique_ptr<ISignalAggregator> m_aggregator;
+
+    // Scratch buffers, reused across bars
+    ModelReplies m_replies; // Replies to the last single-bar request
+    SignalMatrix m_signal_matrix;
+    std::vector<zmq::pollitem_t> m_poll_items;
+    std::vector<bool> m_replied;
+    zmq::message_t m_id_frame;
+    zmq::message_t m_delimiter_frame;
+    zmq::message_t m_reply;
+    zmq::message_t m_extra_frame; // Anything past a well-formed envelope
+
+    bool m_last_result_complete = true;
+    std::uint64_t m_late_replies = 0;
+
+    // --- Instrumentation, one entry per model ---
+    MetricsReport m_metrics{"AggregatedIPCSource models"};
+    std::vector<LatencyHistogram*> m_reply_latency;
+    std::vector<std::uint64_t*> m_timeouts;
 };
\ No newline at end of file
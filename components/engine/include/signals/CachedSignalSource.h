@@ -0,0 +1,96 @@
+// include/signals/CachedSignalSource.h
+
+#pragma once
+
+#include "interfaces/ISignalSource.h"
+#include "core/SignalPacket.h"
+#include "signals/SignalReplyCache.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class CachedSignalSource
+ * @brief Decorator that answers repeated requests from a SignalReplyCache.
+ *
+ * Each bar is keyed by the cache's model key and the bar's binary request
+ * payload (or, for update_market_data(), the JSON message). On a hit the
+ * recorded target weights are returned. Once every model has declared itself
+ * stateless (see ISignalSource::models_stateless()) the wrapped source is
+ * never told about a hit, so no request goes to the models; until then it is
+ * still sent the bar, so stateful models stay in step, and its answer is
+ * discarded. On a miss the bar goes to the wrapped source and its answer is
+ * recorded. Rerunning the same data through the same stateless models, eg to
+ * tune risk or execution parameters, is then served from the cache alone.
+ *
+ * The recorded value is the wrapped source's combined output, in the binary
+ * Signals encoding (one packet per symbol with a nonzero weight). The weights
+ * are stored bit for bit, so a cached run ends exactly where an uncached one
+ * would. A result that is missing a model's answer (see last_result_complete())
+ * is passed on but not recorded, so a later run asks the models again. Hits
+ * and misses may interleave with the wrapped source's pipeline: results are
+ * still returned in bar order.
+ */
+class CachedSignalSource final : public ISignalSource {
+public:
+    /**
+     * @param inner The source asked on a miss.
+     * @param cache Shared, eg by all runs of a sweep.
+     */
+    CachedSignalSource(std::unique_ptr<ISignalSource> inner, std::shared_ptr<SignalReplyCache> cache);
+
+    void update_market_data(const nlohmann::json& market_data) override;
+    void update_market_bar(const DataBar& bar) override;
+    std::map<std::string, double> get_target_portfolio() override;
+    void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override;
+
+    // The wrapped source's: the bars it is sent are what reach the models
+    std::size_t pipeline_depth() const override { return m_inner->pipeline_depth(); }
+    const MetricsReport* metrics() const override { return m_inner->metrics(); }
+    bool last_result_complete() const override { return m_last_result_complete; }
+    bool models_stateless() const override { return m_inner->models_stateless(); }
+    void save_state(StateWriter& out) const override { m_inner->save_state(out); }
+    void restore_state(StateReader& in) override { m_inner->restore_state(in); }
+
+    // --- Safety: Disallow copy/move ---
+    CachedSignalSource(const CachedSignalSource&) = delete;
+    CachedSignalSource& operator=(const CachedSignalSource&) = delete;
+    CachedSignalSource(CachedSignalSource&&) = delete;
+    CachedSignalSource& operator=(CachedSignalSource&&) = delete;
+
+private:
+    struct PendingBar {
+        SignalCacheKey key;
+        bool hit = false;
+        bool forwarded = false; // Sent to the wrapped source, whose answer must be collected
+        std::string value; // The recorded reply, on a hit
+    };
+
+    // Looks the request in m_payload up and queues its slot.
+    // @return true if the bar must also go to the wrapped source.
+    bool submit();
+
+    // The oldest bar's slot, removed from the queue. Valid until the next submit().
+    PendingBar& take_oldest();
+
+    // Decodes a recorded value into m_packets.
+    void decode(const std::string& value);
+
+    // Encodes m_packets and records it under `key`.
+    void record(const SignalCacheKey& key);
+
+    std::unique_ptr<ISignalSource> m_inner;
+    std::shared_ptr<SignalReplyCache> m_cache;
+
+    // Bars submitted and not yet collected, a ring like PipelinedIPCSource's
+    std::vector<PendingBar> m_pending;
+    std::size_t m_pending_head = 0;
+    std::size_t m_pending_count = 0;
+    bool m_last_result_complete = true;
+
+    // Scratch buffers, reused across bars
+    std::string m_payload;
+    std::string m_value;
+    std::vector<SignalPacket> m_packets;
+};
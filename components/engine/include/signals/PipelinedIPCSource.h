@@ -0,0 +1,135 @@
+// include/signals/PipelinedIPCSource.h
+
+#pragma once
+
+#include "interfaces/ISignalSource.h"
+#include "core/SignalPacket.h"
+#include "signals/SignalAggregation.h"
+#include "signals/WireProtocol.h"
+#include "metrics/MetricsReport.h"
+#include <zmq.hpp>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class PipelinedIPCSource
+ * @brief Signal source that keeps several bars in flight to every model.
+ *
+ * Uses one DEALER socket per model instead of a lock-step REQ socket. Every
+ * request is sent as `[request_id, <empty>, payload]`. A REP model echoes that
+ * envelope back unchanged, so existing models work as they are, and replies can
+ * be matched to their bar by id. That means:
+ *   - up to `max_in_flight` bars are outstanding to each model at once, so
+ *     throughput is bound by model compute rather than round-trip latency;
+ *   - a reply that arrives after its bar timed out is recognised by its id and
+ *     dropped, and the socket stays usable (a REQ socket would be stuck);
+ *   - results are returned strictly in bar order, whatever order replies arrive in.
+ * Wire-format negotiation (binary vs JSON) is the same as AggregatedIPCSource.
+ * Per-model reply latency and timeout counts are recorded in metrics().
+ * Replies are combined by an ISignalAggregator; models that did not reply in
+ * time are masked out of that bar.
+ */
+class PipelinedIPCSource : public ISignalSource {
+public:
+    /**
+     * @param model_endpoints One ZeroMQ endpoint per model.
+     * @param reply_timeout How long after sending a bar its replies are awaited.
+     * @param max_in_flight The number of bars that may be outstanding at once.
+     * @param aggregator Combines the models' signals. nullptr selects WeightedMeanAggregator.
+     */
+    PipelinedIPCSource(const std::vector<std::string>& model_endpoints,
+                       std::chrono::milliseconds reply_timeout,
+                       std::size_t max_in_flight,
+                       std::unique_ptr<ISignalAggregator> aggregator = nullptr);
+
+    ~PipelinedIPCSource() override = default;
+
+    // Each update sends a new request; each get returns the oldest outstanding result
+    void update_market_data(const nlohmann::json& market_data) override;
+    void update_market_bar(const DataBar& bar) override;
+    std::map<std::string, double> get_target_portfolio() override;
+    void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override;
+    std::size_t pipeline_depth() const override { return m_max_in_flight; }
+    const MetricsReport* metrics() const override { return &m_metrics; }
+    bool last_result_complete() const override { return m_last_result_complete; }
+    bool models_stateless() const override;
+
+    // The request sequence, so a resumed run never reuses an id.
+    void save_state(StateWriter& out) const override;
+    void restore_state(StateReader& in) override;
+
+    // --- Diagnostics ---
+    std::uint64_t timed_out_replies() const { return m_timed_out_replies; }
+    std::uint64_t late_replies() const { return m_late_replies; } // After a timeout, or duplicates
+
+    // --- Safety: Disallow copy/move ---
+    PipelinedIPCSource(const PipelinedIPCSource&) = delete;
+    PipelinedIPCSource& operator=(const PipelinedIPCSource&) = delete;
+    PipelinedIPCSource(PipelinedIPCSource&&) = delete;
+    PipelinedIPCSource& operator=(PipelinedIPCSource&&) = delete;
+
+private:
+    struct PendingRequest {
+        std::uint64_t request_id;
+        std::chrono::steady_clock::time_point sent_at;
+        std::chrono::steady_clock::time_point deadline;
+        std::vector<bool> awaiting; // Per model: sent, no reply yet
+        std::size_t replies_expected;
+        std::size_t replies_received;
+        ModelReplies replies; // One Signals message per model
+    };
+
+    // Sends one request to every model, picking each model's negotiated encoding.
+    void send_request(const DataBar* bar);
+
+    // Receives every reply that is ready on one model's socket.
+    void drain_socket(std::size_t model_index);
+
+    // Appends a slot to m_pending, growing the ring only when it is full.
+    PendingRequest& push_pending();
+
+    // Blocks until the oldest request is complete or timed out, then removes it.
+    // The signals stay valid until the next request is sent.
+    const ModelReplies& collect_oldest();
+
+    zmq::context_t m_context;
+    std::vector<zmq::socket_t> m_sockets;
+    std::vector<zmq::pollitem_t> m_poll_items;
+    std::vector<wire::ReplyFormat> m_wire_formats;  // Negotiated format, one per model
+    std::vector<bool> m_causal_models;             // Declared via kFlagCausal, one per model
+    std::chrono::milliseconds m_reply_timeout;
+    std::size_t m_max_in_flight;
+
+    // Outstanding requests, a ring of m_pending_count slots starting at
+    // m_pending_head. Ids are consecutive, so a reply's slot is found by
+    // subtracting the oldest id. Slots are reused, buffers and all.
+    std::vector<PendingRequest> m_pending;
+    std::size_t m_pending_head = 0;
+    std::size_t m_pending_count = 0;
+    std::uint64_t m_next_request_id = 0;
+
+    // Encoded requests and scratch buffers, reused across bars
+    nlohmann::json m_latest_market_data;
+    std::string m_binary_request;
+    std::string m_json_request;
+    SignalMatrix m_signal_matrix;
+    std::unique_ptr<ISignalAggregator> m_aggregator;
+    zmq::message_t m_id_frame;
+    zmq::message_t m_delimiter_frame;
+    zmq::message_t m_payload_frame;
+    zmq::message_t m_extra_frame; // Anything past a well-formed envelope
+    const ModelReplies m_no_signals;
+
+    bool m_last_result_complete = true;
+    std::uint64_t m_timed_out_replies = 0;
+    std::uint64_t m_late_replies = 0;
+
+    // --- Instrumentation, one entry per model ---
+    MetricsReport m_metrics{"PipelinedIPCSource models"};
+    std::vector<LatencyHistogram*> m_reply_latency;
+    std::vector<std::uint64_t*> m_timeouts;
+};
@@ -0,0 +1,97 @@
+// include/signals/SignalAggregation.h
+
+#pragma once
+
+#include "core/SignalPacket.h"
+#include "core/SymbolRegistry.h"
+#include "interfaces/ISignalAggregator.h"
+#include "signals/SignalMatrix.h"
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Confidence-weighted mean of the models' target weights (the default).
+ * Symbols whose total confidence is (near-)zero get 0.
+ */
+class WeightedMeanAggregator : public ISignalAggregator {
+public:
+    void aggregate(const SignalMatrix& signals, WeightVector& target_weights) override;
+
+private:
+    std::vector<double> m_total_confidences; // Scratch, reused across bars
+};
+
+/**
+ * @class RankAggregator
+ * @brief Base for aggregators that look at each symbol's weights in order.
+ *
+ * Gathers, per symbol, the weights of the active models with a non-zero
+ * confidence and hands them to combine(). Confidence only decides whether a
+ * model counts; it does not weight the result. Rows are read in blocks of
+ * symbols, so the gather stays sequential in memory.
+ */
+class RankAggregator : public ISignalAggregator {
+public:
+    void aggregate(const SignalMatrix& signals, WeightVector& target_weights) final;
+
+protected:
+    // Reduces one symbol's weights (at least one, in no particular order; may be reordered).
+    virtual double combine(std::span<double> values) const = 0;
+
+private:
+    std::vector<double> m_values;       // Scratch: kBlockSymbols columns of up to `models` weights
+    std::vector<std::uint32_t> m_counts; // Scratch: weights gathered per column
+};
+
+/**
+ * @brief Median of the models' weights; robust to a single runaway model.
+ */
+class MedianAggregator : public RankAggregator {
+protected:
+    double combine(std::span<double> values) const override;
+};
+
+/**
+ * @brief Mean of the models' weights after dropping the `trim_fraction`
+ * lowest and highest ones (rounded down, per side).
+ */
+class TrimmedMeanAggregator : public RankAggregator {
+public:
+    /**
+     * @param trim_fraction Share of models dropped from each end, in [0, 0.5).
+     * @throws std::invalid_argument if it is out of range.
+     */
+    explicit TrimmedMeanAggregator(double trim_fraction);
+
+protected:
+    double combine(std::span<double> values) const override;
+
+private:
+    double m_trim_fraction;
+};
+
+/**
+ * @brief Builds an aggregator by name: "mean", "median" or "trimmed_mean".
+ * @param trim_fraction Only used by "trimmed_mean".
+ * @throws std::invalid_argument for an unknown name.
+ */
+std::unique_ptr<ISignalAggregator> make_signal_aggregator(std::string_view method, double trim_fraction = 0.1);
+
+/**
+ * @brief Map-based aggregation, for callers without a registry.
+ * Interns the symbols into a local registry and runs `aggregator` on them.
+ * Symbols no model has an opinion on are left out.
+ */
+std::map<std::string, double> aggregate_signals(const ModelSignals& signals, ISignalAggregator& aggregator);
+std::map<std::string, double> aggregate_signals(const ModelReplies& replies, ISignalAggregator& aggregator);
+
+/**
+ * @brief Reference implementation of the confidence-weighted mean, one
+ * packet at a time into string-keyed maps. Kept to cross-check the
+ * matrix kernels; assets with (near-)zero total confidence are left out.
+ */
+std::map<std::string, double> aggregate_signals(const std::vector<SignalPacket>& packets);
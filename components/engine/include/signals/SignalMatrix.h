@@ -0,0 +1,122 @@
+// include/signals/SignalMatrix.h
+
+#pragma once
+
+#include "core/SignalPacket.h"
+#include "core/SymbolRegistry.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// The packets of one bar, one entry per model. A model with no packets did not reply.
+using ModelSignals = std::vector<std::vector<SignalPacket>>;
+
+// The replies of one bar as binary Signals messages (see wire::store_reply), one
+// entry per model. An empty message means the model did not reply, or its reply
+// could not be parsed.
+using ModelReplies = std::vector<std::string>;
+
+// Sizes `signals` to `models` entries and empties each, keeping their buffers for the next bar.
+inline void reset_model_signals(ModelSignals& signals, std::size_t models) {
+    signals.resize(models);
+    for (auto& packets : signals) {
+        packets.clear();
+    }
+}
+
+inline void reset_model_replies(ModelReplies& replies, std::size_t models) {
+    replies.resize(models);
+    for (auto& reply : replies) {
+        reply.clear();
+    }
+}
+
+// True if no model's reply is missing from `replies`.
+inline bool all_models_replied(const ModelReplies& replies) {
+    return std::none_of(replies.begin(), replies.end(), [](const std::string& reply) { return reply.empty(); });
+}
+
+/**
+ * @class SignalMatrix
+ * @brief The signals of one bar as a models x symbols structure of arrays.
+ *
+ * Weights and confidences live in two row-major arrays, one row per model and
+ * one column per SymbolId, so aggregators stream through contiguous rows.
+ * A cell with zero confidence means the model said nothing about that symbol.
+ *
+ * Models that did not reply are masked rather than cleared: reset() only
+ * empties the list of active rows, and a row is overwritten when its model's
+ * reply is loaded. Aggregators must only read the rows in active_models().
+ */
+class SignalMatrix {
+public:
+    /**
+     * @brief Resizes to `models` x `symbols` and marks every model as silent.
+     * Keeps the allocation when the shape does not grow.
+     */
+    void reset(std::size_t models, std::size_t symbols);
+
+    /**
+     * @brief Writes one model's reply into its row and marks the model active.
+     * Packets for unknown symbols and with non-positive confidence are ignored.
+     * Duplicate packets for a symbol are merged into their confidence-weighted
+     * mean, so the weighted-mean aggregate equals a packet-by-packet one.
+     */
+    void set_model(std::size_t model, const std::vector<SignalPacket>& packets, const SymbolRegistry& registry);
+
+    /**
+     * @brief set_model() from a binary Signals message, decoding each record
+     * straight into the row: no SignalPacket or symbol string is built.
+     * @throws std::runtime_error if `reply` is not a Signals message.
+     */
+    void set_model(std::size_t model, const std::string& reply, const SymbolRegistry& registry);
+
+    /**
+     * @brief reset() to the registry's size, then set_model() for every model that replied.
+     */
+    void load(const ModelSignals& signals, const SymbolRegistry& registry);
+    void load(const ModelReplies& replies, const SymbolRegistry& registry);
+
+    std::size_t models() const { return m_models; }
+    std::size_t symbols() const { return m_symbols; }
+
+    // Indices of the models whose rows hold this bar's reply, in ascending order.
+    std::span<const std::uint32_t> active_models() const { return m_active_models; }
+
+    // One row each, `symbols()` long, indexed by SymbolId.
+    const double* weights(std::size_t model) const { return m_weights.data() + model * m_symbols; }
+    const double* confidences(std::size_t model) const { return m_confidences.data() + model * m_symbols; }
+
+private:
+    // A symbol field as it last appeared at one record position of a binary reply.
+    struct RecordSymbol {
+        char symbol[16];
+        SymbolId id = kInvalidSymbolId;
+    };
+
+    // Zeroes `model`'s row.
+    void clear_row(std::size_t model);
+
+    // Merges one signal for the symbol `id` (possibly kInvalidSymbolId) into `model`'s row.
+    void add_signal(std::size_t model, SymbolId id, double target_weight, double confidence);
+
+    std::size_t m_models = 0;
+    std::size_t m_symbols = 0;
+    std::vector<double> m_weights;
+    std::vector<double> m_confidences;
+    std::vector<std::uint32_t> m_active_models;
+
+    // Per model, the ids its previous reply resolved to, in packet order. Models
+    // tend to list the same symbols in the same order every bar, so a name
+    // comparison usually replaces the hash lookup.
+    std::vector<std::vector<SymbolId>> m_symbol_cache;
+
+    // The same for binary replies, keyed by the raw 16-byte field so that a hit
+    // is one fixed-size compare. Ids stay valid because a registry only grows;
+    // the cache is dropped when a different registry is passed in.
+    std::vector<std::vector<RecordSymbol>> m_record_cache;
+    const SymbolRegistry* m_record_cache_registry = nullptr;
+};
@@ -0,0 +1,152 @@
+// include/signals/SignalReplyCache.h
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @file SignalReplyCache.h
+ * @brief Persistent log of signal replies, keyed by the models and the request.
+ *
+ * File layout: SignalCacheFileHeader, then one record per cached reply:
+ * SignalCacheRecordHeader, the value bytes, and padding to 8 bytes. Records
+ * are only ever appended. The file header carries a hash of the model key
+ * (endpoints, version, aggregation), so a log recorded for other models is
+ * never served, nor overwritten: the cache then opens empty and read-only.
+ * Values are stored in native byte order, like checkpoints.
+ */
+
+inline constexpr char kSignalCacheMagic[4] = {'E', 'S', 'R', 'C'};
+inline constexpr std::uint32_t kSignalCacheVersion = 1;
+
+struct SignalCacheFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t model_key_hash;
+};
+
+struct SignalCacheRecordHeader {
+    std::uint64_t key_low;
+    std::uint64_t key_high;
+    std::uint32_t value_size;
+    std::uint32_t value_crc32;
+};
+
+static_assert(sizeof(SignalCacheFileHeader) == 16, "SignalCacheFileHeader must match the cache layout");
+static_assert(sizeof(SignalCacheRecordHeader) == 24, "SignalCacheRecordHeader must match the cache layout");
+
+// A 128-bit hash of the model key and one request payload.
+struct SignalCacheKey {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+    bool operator==(const SignalCacheKey&) const = default;
+};
+
+enum class SignalCacheMode {
+    ReadWrite,  // Serve recorded replies, record new ones
+    ReadOnly,   // Serve recorded replies, never write the file
+    Invalidate, // Discard the log at open, then record afresh
+};
+
+/**
+ * @class SignalReplyCache
+ * @brief Memory-mapped, append-only store of model replies.
+ *
+ * At open the existing log is mapped read-only and indexed once; lookups then
+ * copy straight out of the mapping, without locks, so one cache can be shared
+ * by all runs of a sweep. New replies are appended to the file (under a
+ * mutex) and served from the next open on. A record cut short by a
+ * crash, or failing its CRC, ends the log: it is truncated there and
+ * recording continues after the last good record.
+ *
+ * Replies are only correct to reuse when the models are deterministic: the
+ * same request, to the same model version, must always get the same reply.
+ * Bump the version in the model key whenever a model changes, and either
+ * record to a new file or open the old one with SignalCacheMode::Invalidate.
+ */
+class SignalReplyCache {
+public:
+    /**
+     * @param path The log file; created if missing.
+     * @param model_key Identifies the models, eg their endpoints and version.
+     * @param mode See SignalCacheMode.
+     * @throws std::runtime_error If the file cannot be opened, mapped or written.
+     */
+    SignalReplyCache(const std::string& path, std::string_view model_key,
+                     SignalCacheMode mode = SignalCacheMode::ReadWrite);
+    ~SignalReplyCache();
+
+    // The key of one request payload under this cache's model key.
+    SignalCacheKey key_of(std::string_view payload) const;
+
+    /**
+     * @brief Copies the recorded reply for `key` into `value` (whose capacity is reused).
+     * Thread-safe. Only replies recorded before this cache was opened are found.
+     * @return false on a miss.
+     */
+    bool find(const SignalCacheKey& key, std::string& value) const;
+
+    /**
+     * @brief Appends a reply to the log. Thread-safe; a key already in the log
+     * is not written again. Does nothing in SignalCacheMode::ReadOnly.
+     */
+    void insert(const SignalCacheKey& key, std::string_view value);
+
+    // Writes buffered records to the file. Also done at destruction.
+    void flush();
+
+    // --- Diagnostics ---
+    std::size_t recorded_entries() const { return m_index.size(); }
+    std::uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+    std::uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+    // --- Safety: Disallow copy/move (the mapping and the file are owned exclusively) ---
+    SignalReplyCache(const SignalReplyCache&) = delete;
+    SignalReplyCache& operator=(const SignalReplyCache&) = delete;
+    SignalReplyCache(SignalReplyCache&&) = delete;
+    SignalReplyCache& operator=(SignalReplyCache&&) = delete;
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const SignalCacheKey& key) const { return static_cast<std::size_t>(key.low); }
+    };
+
+    struct ValueLocation {
+        std::size_t offset; // Into the mapping
+        std::uint32_t size;
+    };
+
+    // Maps the log and indexes its records. Sets m_other_models if the log belongs to other models.
+    // @return The size of the valid prefix; 0 if the log belongs to other models.
+    std::size_t load(std::size_t file_size);
+
+    // Unmaps the log and forgets its records.
+    void unload();
+
+    std::string m_path;
+    SignalCacheMode m_mode;
+    std::uint64_t m_model_key_hash;
+    bool m_other_models = false;
+
+    // The log as it was at open, read-only and never modified
+    const std::uint8_t* m_mapping = nullptr;
+    std::size_t m_mapping_size = 0;
+    std::unordered_map<SignalCacheKey, ValueLocation, KeyHash> m_index;
+
+    // Records appended since open
+    std::mutex m_write_mutex;
+    std::unordered_set<SignalCacheKey, KeyHash> m_appended;
+    std::ofstream m_out; // Open unless read-only
+
+    mutable std::atomic<std::uint64_t> m_hits{0};
+    mutable std::atomic<std::uint64_t> m_misses{0};
+};
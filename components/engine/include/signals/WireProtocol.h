@@ -0,0 +1,168 @@
+// include/signals/WireProtocol.h
+
+#pragma once
+
+#include "core/DataBar.h"
+#include "core/SignalPacket.h"
+#include "data/DataBarRecord.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Versioned, fixed-layout binary encoding for model requests and replies.
+ *
+ * Every message is a `MessageHeader` followed by `count` fixed-size records:
+ *   - MarketData requests carry `MarketDataRecord`s (the same 64-byte layout as
+ *     the `.bin` files, so a bar goes on the wire without any reformatting).
+ *   - Signals replies carry `SignalRecord`s, one per `SignalPacket`.
+ * A MarketData request may carry a batch of consecutive bars; each reply
+ * record then names the bar it answers by its index in the batch.
+ * All fields are little-endian. `components/model_sdk/wire_protocol.py` is the
+ * Python-side reader/writer and must be kept in sync with this file.
+ *
+ * Negotiation: the engine keeps talking JSON to a model until that model sends
+ * back a binary reply. JSON requests advertise `"wire_version"` so upgraded
+ * models know they may switch; old models ignore the extra key. A model that
+ * sets `kFlagCausal` on its replies declares that its output for a bar depends
+ * only on that bar and earlier ones, so it may be sent whole batches, and that
+ * it keeps no state between bars, so a recorded reply may be replayed without
+ * it seeing the bar (see CachedSignalSource). A model with history must not set it.
+ */
+namespace wire {
+
+static_assert(std::endian::native == std::endian::little, "The wire format assumes a little-endian host");
+
+inline constexpr uint32_t kMagic = 0x50574554; // "TEWP" on the wire
+inline constexpr uint16_t kVersion = 1;
+
+// MessageHeader::flags bits
+inline constexpr uint32_t kFlagCausal = 1u << 0; // Reply only: the model accepts batched requests and replays
+
+enum class MessageType : uint16_t {
+    MarketData = 1,
+    Signals = 2,
+};
+
+struct MessageHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t type;      // MessageType
+    uint32_t count;     // Number of records that follow
+    uint32_t flags;     // kFlag* bits; unknown bits must be ignored
+};
+
+using MarketDataRecord = DataBarRecord;
+
+struct SignalRecord {
+    char symbol[16];        // NUL-padded asset identifier
+    double target_weight;
+    double confidence;
+    uint8_t signal_type;    // 0 = Long, 1 = Short, 2 = Flat
+    uint8_t reserved[3];
+    uint32_t bar_index;     // Index of the answered bar within a batched request, else 0
+};
+
+static_assert(sizeof(MessageHeader) == 16, "MessageHeader layout changed");
+static_assert(sizeof(SignalRecord) == 40, "SignalRecord layout changed");
+
+// The symbol field is only NUL-terminated when shorter than 16 characters.
+inline std::string_view record_symbol(const SignalRecord& record) {
+    return {record.symbol, strnlen(record.symbol, sizeof(record.symbol))};
+}
+
+// True if the buffer starts with a binary wire header (of any version).
+bool is_binary_message(const void* data, std::size_t size);
+
+// Reads the header flags of a binary message; 0 for anything else.
+uint32_t message_flags(const void* data, std::size_t size);
+
+/**
+ * @brief Encodes a single-bar MarketData request into `out`.
+ * `out` is overwritten; reusing it across bars avoids reallocating.
+ */
+void encode_market_data(const DataBar& bar, std::string& out);
+
+/**
+ * @brief Encodes a MarketData request carrying a batch of consecutive bars.
+ */
+void encode_market_data_batch(std::span<const DataBar> bars, std::string& out);
+
+/**
+ * @brief Encodes a Signals reply. Used by benchmarks and in-process models.
+ */
+void encode_signals(const std::vector<SignalPacket>& packets, std::string& out, uint32_t flags = 0);
+
+/**
+ * @brief Encodes a single-bar request as the legacy JSON message.
+ * The message also carries `"wire_version"`, inviting the model to reply in binary.
+ */
+void encode_json_market_data(const DataBar& bar, std::string& out);
+
+enum class ReplyFormat { Json, Binary };
+
+/**
+ * @brief Decodes a model reply in either format and appends its packets to `out`.
+ * @return The format the model replied in.
+ * @throws std::exception (runtime_error or nlohmann::json::exception) on a malformed reply.
+ */
+ReplyFormat decode_reply(const void* data, std::size_t size, std::vector<SignalPacket>& out);
+
+/**
+ * @brief Checks a model reply in either format and leaves it in `out` as a
+ * binary Signals message: a binary reply is copied as is, a JSON one is
+ * re-encoded. Nothing is built per packet for a binary reply, so readers
+ * (SignalMatrix) decode the records straight from `out`.
+ * @return The format the model replied in.
+ * @throws std::exception (runtime_error or nlohmann::json::exception) on a
+ *         malformed reply, leaving `out` empty.
+ */
+ReplyFormat store_reply(const void* data, std::size_t size, std::string& out);
+
+/**
+ * @brief Checks the header of a Signals message.
+ * @return The number of SignalRecords that follow it.
+ * @throws std::runtime_error if the message is truncated or of an unsupported version/type.
+ */
+uint32_t signal_count(const void* data, std::size_t size);
+
+// Where record `index` of a Signals message whose signal_count() is greater than `index` starts.
+// The record may be unaligned: copy it out with signal_record(), or read single fields with memcpy.
+inline const char* signal_record_at(const void* data, std::size_t index) {
+    return static_cast<const char*>(data) + sizeof(MessageHeader) + index * sizeof(SignalRecord);
+}
+
+inline SignalRecord signal_record(const void* data, std::size_t index) {
+    SignalRecord record;
+    std::memcpy(&record, signal_record_at(data, index), sizeof(record));
+    return record;
+}
+
+/**
+ * @brief Decodes a Signals reply and appends its packets to `out`.
+ * @throws std::runtime_error if the message is truncated or of an unsupported version/type.
+ */
+void decode_signals(const void* data, std::size_t size, std::vector<SignalPacket>& out);
+
+/**
+ * @brief Decodes the reply to a batched request, appending each packet to
+ * `per_bar[record.bar_index]`.
+ * @throws std::runtime_error on a malformed reply or an out-of-range bar index.
+ */
+void decode_signal_batch(const void* data, std::size_t size,
+                         std::vector<std::vector<SignalPacket>>& per_bar);
+
+/**
+ * @brief Splits the reply to a batched request into one Signals message per
+ * bar, copying the records as they are. `per_bar` must hold one entry per bar
+ * of the batch; a bar without records gets a message with no signals.
+ * @throws std::runtime_error on a malformed reply or an out-of-range bar index.
+ */
+void split_signal_batch(const void* data, std::size_t size, std::vector<std::string>& per_bar);
+
+} // namespace wire
@@ -0,0 +1,116 @@
+// include/sweep/ParameterSweep.h
+
+#pragma once
+
+#include "data/InMemoryBarProvider.h"
+#include "interfaces/ISignalSource.h"
+#include "metrics/PerformanceAnalytics.h"
+#include "core/SymbolRegistry.h"
+#include "results/ResultsStore.h"
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief One point of a sweep: the risk and execution parameters of one run.
+ */
+struct SweepParameters {
+    double max_position_weight = 0.25;
+    double max_leverage = 1.0;
+    double max_drawdown = 0.20;
+    double commission_per_trade = 1.00;
+    double slippage_percentage = 0.0005;
+    double target_volatility = 0.0; // Annualized volatility budget; 0 disables it
+};
+
+/**
+ * @brief The values to try for each parameter. The sweep runs the full cross product.
+ */
+struct ParameterGrid {
+    std::vector<double> max_position_weight;
+    std::vector<double> max_leverage;
+    std::vector<double> max_drawdown;
+    std::vector<double> commission_per_trade;
+    std::vector<double> slippage_percentage;
+    std::vector<double> target_volatility;
+
+    /**
+     * @brief Reads a grid such as `{"max_leverage": [1.0, 1.5], ...}`.
+     * Parameters that are missing take their single value from `defaults`.
+     */
+    static ParameterGrid from_json(const nlohmann::json& grid, const SweepParameters& defaults = {});
+
+    // Every combination, in a fixed (row-major) order.
+    std::vector<SweepParameters> expand() const;
+};
+
+/**
+ * @brief The outcome of one run.
+ */
+struct SweepResult {
+    std::size_t run_index;
+    SweepParameters parameters;
+    double final_value;
+    double peak_value;
+    double final_cash;
+    PerformanceSummary performance; // Computed during the run, no pass over the equity curve
+};
+
+/**
+ * @class ParameterSweep
+ * @brief Runs one independent backtest per parameter set across all cores.
+ *
+ * Each run gets its own EventLoop, Portfolio, PortfolioRiskManager and
+ * BacktestExecutionHandler, plus a fresh signal source from the factory.
+ * All runs read the same shared, read-only copy of the market data and the
+ * same symbol registry (which is never written to during the sweep), so the
+ * only per-run memory is the run's own state. Runs are scheduled on a
+ * work-stealing pool, so uneven run lengths do not leave cores idle.
+ */
+class ParameterSweep {
+public:
+    using SignalSourceFactory = std::function<std::unique_ptr<ISignalSource>()>;
+
+    /**
+     * @param bars The shared market data; every bar must carry a valid symbol id.
+     * @param registry The registry the bar ids refer to.
+     * @param initial_cash Starting cash of every run.
+     * @param make_signal_source Creates the signal source of one run. Called concurrently.
+     * @param thread_count Worker threads; 0 means one per hardware thread.
+     */
+    ParameterSweep(SharedBarStore bars,
+                   std::shared_ptr<SymbolRegistry> registry,
+                   double initial_cash,
+                   SignalSourceFactory make_signal_source,
+                   std::size_t thread_count = 0);
+
+    /**
+     * @brief Records every run's fills and equity curve into `store` as a run of its own,
+     * labelled with the run index and parameters.
+     */
+    void set_results_store(std::shared_ptr<ResultsStore> store) { m_results_store = std::move(store); }
+
+    /**
+     * @brief Runs every parameter set.
+     * @param on_result Optional; called (serialized) as each run finishes.
+     * @return One result per parameter set, in the order given.
+     */
+    std::vector<SweepResult> run(const std::vector<SweepParameters>& parameter_sets,
+                                 const std::function<void(const SweepResult&)>& on_result = nullptr);
+
+    static void write_csv_header(std::ostream& out);
+    static void write_csv_row(std::ostream& out, const SweepResult& result);
+
+private:
+    SweepResult run_one(std::size_t run_index, const SweepParameters& parameters) const;
+
+    SharedBarStore m_bars;
+    std::shared_ptr<SymbolRegistry> m_registry;
+    double m_initial_cash;
+    SignalSourceFactory m_make_signal_source;
+    std::size_t m_thread_count;
+    std::shared_ptr<ResultsStore> m_results_store; // Optional
+};
@@ -0,0 +1,64 @@
+// src/checkpoint/Checkpoint.cpp
+
+#include "checkpoint/Checkpoint.h"
+#include "data/ColumnarBarFormat.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+void write_checkpoint_file(const std::string& path, std::span<const std::uint8_t> snapshot) {
+    CheckpointFileHeader header{};
+    std::memcpy(header.magic, kCheckpointMagic, sizeof(header.magic));
+    header.version = kCheckpointVersion;
+    header.payload_size = snapshot.size();
+    header.payload_crc32 = crc32(snapshot.data(), snapshot.size());
+
+    // Write beside the target and rename over it: readers see the old file or the new one
+    const std::string temporary_path = path + ".tmp";
+    {
+        std::ofstream out(temporary_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+        out.flush();
+        if (!out) {
+            std::filesystem::remove(temporary_path);
+            throw std::runtime_error("Cannot write checkpoint " + temporary_path);
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error) {
+        std::filesystem::remove(temporary_path);
+        throw std::runtime_error("Cannot move checkpoint into place at " + path + ": " + error.message());
+    }
+}
+
+std::vector<std::uint8_t> read_checkpoint_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open checkpoint " + path);
+    }
+
+    CheckpointFileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kCheckpointMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a checkpoint");
+    }
+    if (header.version != kCheckpointVersion) {
+        throw std::runtime_error(path + " has checkpoint version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(kCheckpointVersion));
+    }
+
+    const auto file_size = std::filesystem::file_size(path);
+    if (header.payload_size != file_size - sizeof(header)) {
+        throw std::runtime_error("Checkpoint " + path + " is truncated");
+    }
+    std::vector<std::uint8_t> snapshot(header.payload_size);
+    if (!in.read(reinterpret_cast<char*>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()))) {
+        throw std::runtime_error("Cannot read checkpoint " + path);
+    }
+    if (crc32(snapshot.data(), snapshot.size()) != header.payload_crc32) {
+        throw std::runtime_error("Checkpoint " + path + " is corrupt (CRC mismatch)");
+    }
+    return snapshot;
+}
@@ -0,0 +1,79 @@
+// src/checkpoint/CheckpointWriter.cpp
+
+#include "checkpoint/CheckpointWriter.h"
+#include "checkpoint/Checkpoint.h"
+#include "logging/Logger.h"
+#include <utility>
+
+CheckpointWriter::CheckpointWriter(std::string path)
+    : m_path(std::move(path)),
+      m_thread(&CheckpointWriter::writer_loop, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CheckpointWriter::submit(std::vector<std::uint8_t>& snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_has_queued) {
+            ++m_replaced; // The disk is behind; only the newest snapshot matters
+        }
+        m_queued.swap(snapshot);
+        m_has_queued = true;
+    }
+    m_wakeup.notify_one();
+    snapshot.clear();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [&] { return !m_has_queued && !m_writing; });
+}
+
+std::uint64_t CheckpointWriter::written() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_written;
+}
+
+std::uint64_t CheckpointWriter::replaced() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_replaced;
+}
+
+void CheckpointWriter::writer_loop() {
+    std::vector<std::uint8_t> snapshot;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeup.wait(lock, [&] { return m_has_queued || m_stop; });
+        if (!m_has_queued) {
+            break; // Stopping with nothing left to write
+        }
+        snapshot.swap(m_queued); // m_queued gets the written buffer back, for reuse
+        m_has_queued = false;
+        m_writing = true;
+
+        lock.unlock();
+        bool ok = true;
+        try {
+            write_checkpoint_file(m_path, snapshot);
+        } catch (const std::exception& e) {
+            ok = false;
+            LOG_ERROR("Checkpoint", "Checkpoint not written: {}", e.what());
+        }
+        lock.lock();
+
+        m_writing = false;
+        if (ok) {
+            ++m_written;
+        }
+        m_idle.notify_all();
+    }
+}
@@ -0,0 +1,28 @@
+// src/core/CpuAffinity.cpp
+
+#include "core/CpuAffinity.h"
+#include "logging/Logger.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <cstring>
+#endif
+
+bool pin_current_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (error != 0) {
+        LOG_WARN("Affinity", "Cannot pin the thread to CPU {}: {}", cpu, std::strerror(error));
+        return false;
+    }
+    LOG_INFO("Affinity", "Thread pinned to CPU {}", cpu);
+    return true;
+#else
+    LOG_WARN("Affinity", "Thread pinning is not supported on this platform (CPU {} requested)", cpu);
+    return false;
+#endif
+}
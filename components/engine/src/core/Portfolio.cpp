@@ -1,59 +1,261 @@
 // src/core/Portfolio.cpp
 
 #include "core/Portfolio.h"
+#include "checkpoint/Checkpoint.h"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
 
 Portfolio::Portfolio(double initial_cash)
-    : m_cash(initial_cash), m_total_value(initial_cash) {
-    // No lock needed here, as the object hasn't been shared with other threads yet.
-}
-
-double Portfolio::get_cash() const {
-    std::lock_guard<std::mutex> lock(m_mutex); // Lock is acquired
-    return m_cash;
-} // Lock is automatically released
+    : Portfolio(initial_cash, std::make_shared<SymbolRegistry>()) {}
 
-double Portfolio::get_total_value() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_total_value;
+Portfolio::Portfolio(double initial_cash, std::shared_ptr<SymbolRegistry> registry)
+    : m_cash(initial_cash), m_registry(std::move(registry)) {
+    if (!m_registry) {
+        m_registry = std::make_shared<SymbolRegistry>();
+    }
+    m_positions.resize(m_registry->size(), 0);
+    m_marked_prices.resize(m_registry->size(), 0.0);
+    m_held_slots.resize(m_registry->size(), 0);
+    m_held_ids.reserve(m_registry->size());
+    publish(); // Snapshots are valid from the start
 }
 
 std::map<std::string, long long> Portfolio::get_holdings() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_holdings; // A copy is created and returned
+    std::map<std::string, long long> holdings; // A copy is created and returned
+    for (SymbolId id : m_held_ids) {
+        holdings.emplace(m_registry->name(id), m_positions[id]);
+    }
+    return holdings;
 }
 
 long long Portfolio::get_position(const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_holdings.find(symbol);
-    if (it != m_holdings.end()) {
-        return it->second;
+    return get_position(m_registry->find(symbol));
+}
+
+void Portfolio::ensure_symbol(SymbolId id) {
+    if (id >= m_positions.size()) {
+        const std::size_t size = std::max<std::size_t>(id + 1, m_registry->size());
+        m_positions.resize(size, 0);
+        m_marked_prices.resize(size, 0.0);
+        m_held_slots.resize(size, 0);
+        m_held_ids.reserve(size); // Never longer: no growth when a new symbol is first bought
+    }
+}
+
+void Portfolio::update_held(SymbolId id) {
+    const bool held = m_positions[id] != 0;
+    if (held && m_held_slots[id] == 0) {
+        m_held_ids.push_back(id);
+        m_held_slots[id] = m_held_ids.size();
+    } else if (!held && m_held_slots[id] != 0) {
+        // Swap-remove: the last id takes this one's slot
+        const SymbolId last = m_held_ids.back();
+        m_held_ids[m_held_slots[id] - 1] = last;
+        m_held_slots[last] = m_held_slots[id];
+        m_held_ids.pop_back();
+        m_held_slots[id] = 0;
     }
-    return 0;
 }
 
-void Portfolio::update_cash(double amount) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_cash += amount;
+void Portfolio::tradable_ids(const WeightVector& target_weights, std::vector<SymbolId>& out) const {
+    out.clear();
+    out.reserve(std::max(target_weights.size(), m_positions.size()));
+    for (SymbolId id = 0; id < target_weights.size(); ++id) {
+        if (target_weights[id] != 0.0) {
+            out.push_back(id);
+        }
+    }
+    const std::size_t targeted = out.size();
+    for (SymbolId id : m_held_ids) {
+        if (id >= target_weights.size() || target_weights[id] == 0.0) {
+            out.push_back(id);
+        }
+    }
+    if (out.size() > targeted) {
+        std::sort(out.begin(), out.end()); // Id order, as a walk over the whole universe would trade
+    }
 }
 
 void Portfolio::update_holding(const std::string& symbol, long long quantity) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_holdings[symbol] += quantity;
-    if (m_holdings[symbol] == 0) {
-        m_holdings.erase(symbol);
+    update_holding(m_registry->intern(symbol), quantity);
+}
+
+void Portfolio::update_holding(SymbolId id, long long quantity) {
+    ensure_symbol(id);
+    const long long previous = m_positions[id];
+    m_positions[id] += quantity;
+    m_market_value += quantity * m_marked_prices[id]; // The new shares at the current mark
+    m_gross_exposure += (std::llabs(m_positions[id]) - std::llabs(previous)) * m_marked_prices[id];
+    ++m_fill_count;
+    m_traded_notional += std::llabs(quantity) * m_marked_prices[id];
+    update_held(id);
+    mark_dirty(id);
+}
+
+void Portfolio::mark_dirty(SymbolId id) {
+    if (id >= m_dirty.size()) {
+        m_dirty.resize(m_positions.size(), false);
+        m_dirty_ids.reserve(m_positions.size()); // Never longer: no growth when a new symbol first trades
+    }
+    if (!m_dirty[id]) {
+        m_dirty[id] = true;
+        m_dirty_ids.push_back(id);
     }
 }
 
-void Portfolio::recalculate_total_value(const std::map<std::string, double>& latest_prices) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+void Portfolio::mark_price(SymbolId id, double price) {
+    ensure_symbol(id);
+    m_market_value += m_positions[id] * (price - m_marked_prices[id]);
+    m_gross_exposure += std::llabs(m_positions[id]) * (price - m_marked_prices[id]);
+    m_marked_prices[id] = price;
+
+    if (m_revalue_interval != 0 && ++m_marks_since_revalue >= m_revalue_interval) {
+        revalue();
+    }
+}
+
+void Portfolio::revalue() {
     double market_value = 0.0;
-    for (const auto& pair : m_holdings) {
-        const std::string& symbol = pair.first;
-        const long long quantity = pair.second;
-        auto price_it = latest_prices.find(symbol);
-        if (price_it != latest_prices.end()) {
-            market_value += quantity * price_it->second;
+    double gross_exposure = 0.0;
+    for (std::size_t id = 0; id < m_positions.size(); ++id) {
+        market_value += m_positions[id] * m_marked_prices[id]; // Never-marked symbols read as 0.0
+        gross_exposure += std::llabs(m_positions[id]) * m_marked_prices[id];
+    }
+    m_market_value = market_value;
+    m_gross_exposure = gross_exposure;
+    m_marks_since_revalue = 0;
+}
+
+void Portfolio::recalculate_total_value(const std::map<std::string, double>& latest_prices) {
+    // Symbols missing from the map keep their current mark
+    for (const auto& [symbol, price] : latest_prices) {
+        SymbolId id = m_registry->find(symbol);
+        if (id < m_marked_prices.size()) {
+            m_marked_prices[id] = price;
         }
     }
-    m_total_value = m_cash + market_value;
-}
\ No newline at end of file
+    revalue();
+    publish();
+}
+
+void Portfolio::recalculate_total_value(const PriceVector& latest_prices) {
+    // Symbols beyond the price vector keep their current mark
+    const std::size_t count = std::min(m_marked_prices.size(), latest_prices.size());
+    std::copy_n(latest_prices.begin(), count, m_marked_prices.begin());
+    revalue();
+    publish();
+}
+
+void Portfolio::publish() {
+    PublishedPositions* buffer = m_published_positions.load(std::memory_order_relaxed);
+    bool full_copy = false;
+    if (!buffer || buffer->capacity < m_positions.size()) {
+        const std::size_t capacity = std::max<std::size_t>(
+            {m_positions.size(), buffer ? buffer->capacity * 2 : 0, 16});
+        m_position_buffers.push_back(std::make_unique<PublishedPositions>(capacity));
+        buffer = m_position_buffers.back().get();
+        full_copy = true; // A fresh buffer holds none of the earlier positions
+    }
+
+    // Seqlock write: odd sequence, relaxed stores, even sequence
+    const std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (full_copy) {
+        for (std::size_t id = 0; id < m_positions.size(); ++id) {
+            buffer->positions[id].store(m_positions[id], std::memory_order_relaxed);
+        }
+    } else {
+        for (SymbolId id : m_dirty_ids) {
+            buffer->positions[id].store(m_positions[id], std::memory_order_relaxed);
+        }
+    }
+    m_published_positions.store(buffer, std::memory_order_release); // Publishes the buffer's construction
+    m_published_count.store(m_positions.size(), std::memory_order_relaxed);
+    m_published_cash.store(m_cash, std::memory_order_relaxed);
+    m_published_total_value.store(get_total_value(), std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+
+    for (SymbolId id : m_dirty_ids) {
+        m_dirty[id] = false;
+    }
+    m_dirty_ids.clear();
+}
+
+void Portfolio::save_state(StateWriter& writer) const {
+    writer.write(m_cash);
+    writer.write(m_market_value);
+    writer.write(m_gross_exposure);
+    writer.write(m_fill_count);
+    writer.write(m_traded_notional);
+    writer.write<std::uint64_t>(m_revalue_interval);
+    writer.write<std::uint64_t>(m_marks_since_revalue);
+    writer.write_vector(m_positions);
+    writer.write_vector(m_marked_prices);
+}
+
+void Portfolio::restore_state(StateReader& reader) {
+    reader.read(m_cash);
+    reader.read(m_market_value);
+    reader.read(m_gross_exposure);
+    reader.read(m_fill_count);
+    reader.read(m_traded_notional);
+    m_revalue_interval = reader.read<std::uint64_t>();
+    m_marks_since_revalue = reader.read<std::uint64_t>();
+    reader.read_vector(m_positions);
+    reader.read_vector(m_marked_prices);
+    if (m_marked_prices.size() != m_positions.size()) {
+        throw std::runtime_error("Checkpoint portfolio has mismatched position and price counts");
+    }
+
+    m_held_ids.clear();
+    m_held_ids.reserve(m_positions.size());
+    m_held_slots.assign(m_positions.size(), 0);
+    for (SymbolId id = 0; id < m_positions.size(); ++id) {
+        update_held(id);
+    }
+
+    // Every position may have changed, so the next publish copies them all
+    m_dirty.assign(m_positions.size(), true);
+    m_dirty_ids.resize(m_positions.size());
+    for (SymbolId id = 0; id < m_positions.size(); ++id) {
+        m_dirty_ids[id] = id;
+    }
+    publish();
+}
+
+void Portfolio::snapshot(PortfolioSnapshot& out) const {
+    while (true) {
+        const std::uint64_t begin = m_sequence.load(std::memory_order_acquire);
+        if (begin & 1) {
+            std::this_thread::yield(); // Publish in progress
+            continue;
+        }
+
+        // Buffers are never freed while the portfolio lives, and a torn
+        // count/buffer pair is clamped here and rejected by the check below.
+        const PublishedPositions* buffer = m_published_positions.load(std::memory_order_acquire);
+        const std::size_t count = std::min(m_published_count.load(std::memory_order_relaxed), buffer->capacity);
+        out.positions.resize(count);
+        for (std::size_t id = 0; id < count; ++id) {
+            out.positions[id] = buffer->positions[id].load(std::memory_order_relaxed);
+        }
+        out.cash = m_published_cash.load(std::memory_order_relaxed);
+        out.total_value = m_published_total_value.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == begin) {
+            out.version = begin / 2;
+            return;
+        }
+    }
+}
+
+PortfolioSnapshot Portfolio::snapshot() const {
+    PortfolioSnapshot out;
+    snapshot(out);
+    return out;
+}
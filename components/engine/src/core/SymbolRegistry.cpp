@@ -0,0 +1,25 @@
+// src/core/SymbolRegistry.cpp
+
+#include "core/SymbolRegistry.h"
+#include <stdexcept>
+
+SymbolId SymbolRegistry::intern(std::string_view symbol) {
+    auto it = m_ids.find(symbol);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    if (m_names.size() >= kInvalidSymbolId) {
+        throw std::overflow_error("SymbolRegistry is full");
+    }
+
+    auto id = static_cast<SymbolId>(m_names.size());
+    m_names.emplace_back(symbol);
+    m_ids.emplace(m_names.back(), id);
+    return id;
+}
+
+SymbolId SymbolRegistry::find(std::string_view symbol) const {
+    auto it = m_ids.find(symbol);
+    return it != m_ids.end() ? it->second : kInvalidSymbolId;
+}
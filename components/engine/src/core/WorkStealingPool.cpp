@@ -0,0 +1,121 @@
+// src/core/WorkStealingPool.cpp
+
+#include "core/WorkStealingPool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_queues.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        m_threads.emplace_back(&WorkStealingPool::worker_loop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::unique_lock<std::mutex> lock(m_state_mutex);
+        m_idle.wait(lock, [this] { return m_unfinished == 0; });
+        m_stop = true;
+    }
+    m_work_available.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    // Count the task first, so the counters never lag behind the deques
+    {
+        std::lock_guard<std::mutex> lock(m_state_mutex);
+        ++m_queued;
+        ++m_unfinished;
+    }
+
+    std::size_t index = m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_work_available.notify_one();
+}
+
+void WorkStealingPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(m_state_mutex);
+    m_idle.wait(lock, [this] { return m_unfinished == 0; });
+    if (m_first_error) {
+        std::exception_ptr error = m_first_error;
+        m_first_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::try_take(std::size_t index, std::function<void()>& task) {
+    // 1. Own deque, newest first (its data is most likely still in cache)
+    {
+        WorkerQueue& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // 2. Steal the oldest task from another worker
+    for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+        WorkerQueue& victim = *m_queues[(index + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::worker_loop(std::size_t index) {
+    std::function<void()> task;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_state_mutex);
+            m_work_available.wait(lock, [this] { return m_stop || m_queued > 0; });
+            if (m_stop && m_queued == 0) {
+                return;
+            }
+        }
+
+        if (!try_take(index, task)) {
+            std::this_thread::yield(); // Another worker got there first, or the push is in flight
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_state_mutex);
+            --m_queued;
+        }
+
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        task = nullptr;
+
+        std::lock_guard<std::mutex> lock(m_state_mutex);
+        if (error && !m_first_error) {
+            m_first_error = error;
+        }
+        if (--m_unfinished == 0) {
+            m_idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,77 @@
+// src/data/BarReplayPublisher.cpp
+
+#include "data/BarReplayPublisher.h"
+#include "logging/Logger.h"
+#include <cstring>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    // Sleeping is only accurate to tens of microseconds; spin through the last stretch
+    constexpr auto kSpinBeforeSend = std::chrono::microseconds(100);
+}
+
+BarReplayPublisher::BarReplayPublisher(const std::string& endpoint, ReplayOptions options)
+    : m_options(options),
+      m_socket(m_context, zmq::socket_type::pub)
+{
+    m_socket.set(zmq::sockopt::linger, 1000); // Let queued bars and the end marker go out on close
+    m_socket.set(zmq::sockopt::sndhwm, 0);
+    m_socket.bind(endpoint);
+    LOG_INFO("Replay", "Publishing on {}", endpoint);
+}
+
+bool BarReplayPublisher::wait_until(Clock::time_point deadline) {
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        const auto now = Clock::now();
+        if (now >= deadline) {
+            return true;
+        }
+        if (deadline - now > kSpinBeforeSend) {
+            std::this_thread::sleep_for(deadline - now - kSpinBeforeSend);
+        }
+    }
+    return false;
+}
+
+std::uint64_t BarReplayPublisher::publish(IDataProvider& source) {
+    if (!wait_until(Clock::now() + m_options.warmup)) {
+        return 0;
+    }
+
+    const bool paced = m_options.bars_per_second > 0.0;
+    const std::chrono::duration<double> interval(paced ? 1.0 / m_options.bars_per_second : 0.0);
+    const auto start = Clock::now();
+    std::uint64_t sent = 0;
+    LiveBarMessage message{};
+
+    while (auto bar = source.get_next_bar()) {
+        if (paced && !wait_until(start + std::chrono::duration_cast<Clock::duration>(interval * sent))) {
+            return sent;
+        }
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return sent;
+        }
+
+        message.record = DataBarRecord{};
+        std::strncpy(message.record.symbol, bar->symbol.c_str(), sizeof(message.record.symbol) - 1);
+        message.record.timestamp_epoch_ns = TimeRange::to_epoch_ns(bar->timestamp);
+        message.record.open = bar->open;
+        message.record.high = bar->high;
+        message.record.low = bar->low;
+        message.record.close = bar->close;
+        message.record.volume = bar->volume;
+        message.published_ns = steady_clock_ns();
+        m_socket.send(zmq::buffer(&message, sizeof(message)), zmq::send_flags::none);
+        ++sent;
+    }
+
+    if (m_options.send_end_of_feed) {
+        m_socket.send(zmq::message_t(), zmq::send_flags::none);
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    LOG_INFO("Replay", "Sent {} bars in {} s ({} bars/s)", sent, elapsed.count(),
+             elapsed.count() > 0.0 ? static_cast<double>(sent) / elapsed.count() : 0.0);
+    return sent;
+}
@@ -1,24 +1,32 @@
 // src/data/BinFileReader.cpp
 
 #include "data/BinFileReader.h"
+#include "data/DataBarRecord.h"
+#include <cstddef>
 #include <stdexcept>
-#include <chrono>
-
-struct DataBarRecord {
-    char symbol[16];
-    uint64_t timestamp_epoch_ns;
-    double open;
-    double high;
-    double low;
-    double close;
-    uint64_t volume;
-};
-
-BinFileReader::BinFileReader(const std::string& file_path)
-    : m_file_stream(file_path, std::ios::binary) {
+
+BinFileReader::BinFileReader(const std::string& file_path, TimeRange range)
+    : m_file_stream(file_path, std::ios::binary), m_end_ns(range.end_ns) {
     if (!m_file_stream.is_open()) {
         throw std::runtime_error("Failed to open file: " + file_path);
     }
+
+    BarFileHeader header{};
+    m_file_stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    try {
+        m_records_offset = bar_file_records_offset(&header, static_cast<std::size_t>(m_file_stream.gcount()));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("File " + file_path + ": " + e.what());
+    }
+
+    m_file_stream.clear(); // A headerless file may be shorter than a header
+    m_file_stream.seekg(0, std::ios::end);
+    m_record_count = (static_cast<std::uint64_t>(m_file_stream.tellg()) - m_records_offset) / sizeof(DataBarRecord);
+    m_file_stream.seekg(static_cast<std::streamoff>(m_records_offset), std::ios::beg);
+
+    if (range.start_ns > 0) {
+        seek(range.start_ns);
+    }
 }
 
 BinFileReader::~BinFileReader() {
@@ -27,6 +35,34 @@ BinFileReader::~BinFileReader() {
     }
 }
 
+void BinFileReader::seek(std::uint64_t timestamp_ns) {
+    // Find the first record with a timestamp >= timestamp_ns
+    constexpr auto kTimestampOffset = offsetof(DataBarRecord, timestamp_epoch_ns);
+    std::uint64_t low = 0;
+    std::uint64_t high = m_record_count;
+    while (low < high) {
+        const std::uint64_t mid = low + (high - low) / 2;
+        std::uint64_t timestamp = 0;
+        m_file_stream.clear();
+        m_file_stream.seekg(static_cast<std::streamoff>(m_records_offset + mid * sizeof(DataBarRecord) + kTimestampOffset));
+        if (!m_file_stream.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp))) {
+            throw std::runtime_error("Error reading from binary file");
+        }
+        if (timestamp < timestamp_ns) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    m_file_stream.clear();
+    m_file_stream.seekg(static_cast<std::streamoff>(m_records_offset + low * sizeof(DataBarRecord)));
+}
+
+void BinFileReader::resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) {
+    seek(timestamp_ns);
+    skip_bars_at(timestamp_ns, bars_at_timestamp);
+}
+
 std::optional<DataBar> BinFileReader::get_next_bar() {
     DataBarRecord record;
 
@@ -38,19 +74,8 @@ std::optional<DataBar> BinFileReader::get_next_bar() {
         }
     }
 
-    std::string symbol_str(record.symbol);
-
-    auto timestamp_ns = std::chrono::system_clock::time_point{} + 
-                        std::chrono::nanoseconds(record.timestamp_epoch_ns);
-    auto timestamp_for_databar = std::chrono::time_point_cast<std::chrono::system_clock::duration>(timestamp_ns);
-
-    return DataBar{
-        symbol_str,
-        timestamp_for_databar,
-        record.open,
-        record.high,
-        record.low,
-        record.close,
-        record.volume
-    };
-}
\ No newline at end of file
+    if (record.timestamp_epoch_ns >= m_end_ns) {
+        return std::nullopt; // Past the end of the range
+    }
+    return to_data_bar(record);
+}
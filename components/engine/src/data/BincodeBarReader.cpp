@@ -0,0 +1,131 @@
+// src/data/BincodeBarReader.cpp
+
+#include "data/BincodeBarReader.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // Bincode varint markers: smaller values are stored in the byte itself
+    constexpr std::uint8_t kVarintU16 = 251;
+    constexpr std::uint8_t kVarintU32 = 252;
+    constexpr std::uint8_t kVarintU64 = 253;
+
+    constexpr std::size_t kMaxDateLength = 64; // Far longer than any date the fetcher writes
+
+    // Parses exactly `width` digits at `pos`.
+    int parse_digits(std::string_view text, std::size_t pos, std::size_t width) {
+        int value = 0;
+        for (std::size_t i = pos; i < pos + width; ++i) {
+            if (text[i] < '0' || text[i] > '9') {
+                throw std::invalid_argument("Malformed bar timestamp: " + std::string(text));
+            }
+            value = value * 10 + (text[i] - '0');
+        }
+        return value;
+    }
+}
+
+std::uint64_t parse_bar_timestamp(std::string_view text) {
+    const bool has_time = text.size() == 19;
+    if ((text.size() != 10 && !has_time) || text[4] != '-' || text[7] != '-'
+        || (has_time && (text[10] != ' ' || text[13] != ':' || text[16] != ':'))) {
+        throw std::invalid_argument("Malformed bar timestamp: " + std::string(text));
+    }
+
+    using namespace std::chrono;
+    const year_month_day date{year{parse_digits(text, 0, 4)},
+                              month{static_cast<unsigned>(parse_digits(text, 5, 2))},
+                              day{static_cast<unsigned>(parse_digits(text, 8, 2))}};
+    if (!date.ok() || static_cast<int>(date.year()) < 1970) {
+        throw std::invalid_argument("Malformed bar timestamp: " + std::string(text));
+    }
+
+    nanoseconds time_of_day{0};
+    if (has_time) {
+        const int h = parse_digits(text, 11, 2);
+        const int m = parse_digits(text, 14, 2);
+        const int s = parse_digits(text, 17, 2);
+        if (h > 23 || m > 59 || s > 60) {
+            throw std::invalid_argument("Malformed bar timestamp: " + std::string(text));
+        }
+        time_of_day = hours{h} + minutes{m} + seconds{s};
+    }
+    const auto since_epoch = sys_days{date}.time_since_epoch() + time_of_day;
+    return static_cast<std::uint64_t>(duration_cast<nanoseconds>(since_epoch).count());
+}
+
+BincodeBarReader::BincodeBarReader(const std::string& file_path, const std::string& symbol)
+    : m_file_path(file_path), m_in(file_path, std::ios::binary) {
+    if (!m_in.is_open()) {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+    if (symbol.empty() || symbol.size() >= sizeof(m_record.symbol)) {
+        throw std::invalid_argument("Symbol '" + symbol + "' must be 1 to 15 characters");
+    }
+    std::memcpy(m_record.symbol, symbol.data(), symbol.size());
+    m_bar_count = read_varint(); // The Vec length
+}
+
+void BincodeBarReader::read_bytes(void* out, std::size_t size) {
+    if (!m_in.read(static_cast<char*>(out), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("Truncated bincode file " + m_file_path + " at bar " + std::to_string(m_position));
+    }
+}
+
+std::uint64_t BincodeBarReader::read_varint() {
+    std::uint8_t marker;
+    read_bytes(&marker, 1);
+    if (marker < kVarintU16) {
+        return marker;
+    }
+    // Wider values follow the marker, little-endian (as is the host)
+    std::uint64_t value = 0;
+    switch (marker) {
+        case kVarintU16: read_bytes(&value, 2); return value;
+        case kVarintU32: read_bytes(&value, 4); return value;
+        case kVarintU64: read_bytes(&value, 8); return value;
+        default:
+            throw std::runtime_error("Unsupported bincode varint in " + m_file_path);
+    }
+}
+
+double BincodeBarReader::read_f64() {
+    double value;
+    read_bytes(&value, sizeof(value));
+    return value;
+}
+
+const DataBarRecord* BincodeBarReader::next_record() {
+    if (m_position >= m_bar_count) {
+        return nullptr;
+    }
+
+    const std::uint64_t date_length = read_varint();
+    if (date_length > kMaxDateLength) {
+        throw std::runtime_error("Implausible date length in " + m_file_path + " at bar " + std::to_string(m_position));
+    }
+    m_date.resize(date_length);
+    read_bytes(m_date.data(), date_length);
+    m_record.timestamp_epoch_ns = parse_bar_timestamp(m_date);
+
+    // Field order of PriceBar: open, high, low, close, volume
+    m_record.open = read_f64();
+    m_record.high = read_f64();
+    m_record.low = read_f64();
+    m_record.close = read_f64();
+    const double volume = read_f64();
+    m_record.volume = volume > 0.0 ? static_cast<std::uint64_t>(std::llround(volume)) : 0;
+
+    ++m_position;
+    return &m_record;
+}
+
+std::optional<DataBar> BincodeBarReader::get_next_bar() {
+    const DataBarRecord* record = next_record();
+    if (!record) {
+        return std::nullopt;
+    }
+    return to_data_bar(*record);
+}
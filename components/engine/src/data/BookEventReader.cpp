@@ -0,0 +1,57 @@
+// src/data/BookEventReader.cpp
+
+#include "data/BookEventReader.h"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+BookEventReader::BookEventReader(const std::string& file_path) {
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + file_path);
+    }
+
+    const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+    if (file_size % sizeof(BookEventRecord) != 0) {
+        ::close(fd);
+        throw std::runtime_error("File size of " + file_path + " is not a multiple of the "
+                                 + std::to_string(sizeof(BookEventRecord)) + "-byte event layout");
+    }
+
+    if (file_size > 0) {
+        m_mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m_mapping == MAP_FAILED) {
+            m_mapping = nullptr;
+            ::close(fd);
+            throw std::runtime_error("Failed to mmap file: " + file_path);
+        }
+        m_mapping_size = file_size;
+        ::madvise(m_mapping, m_mapping_size, MADV_SEQUENTIAL);
+    }
+    ::close(fd); // The mapping keeps the file contents alive.
+
+    m_records = static_cast<const BookEventRecord*>(m_mapping);
+    m_record_count = file_size / sizeof(BookEventRecord);
+}
+
+BookEventReader::~BookEventReader() {
+    if (m_mapping) {
+        ::munmap(m_mapping, m_mapping_size);
+    }
+}
+
+std::span<const BookEventRecord> BookEventReader::next_until(std::uint64_t timestamp_epoch_ns) {
+    const std::size_t begin = m_position;
+    while (m_position < m_record_count && m_records[m_position].timestamp_epoch_ns <= timestamp_epoch_ns) {
+        ++m_position;
+    }
+    return {m_records + begin, m_position - begin};
+}
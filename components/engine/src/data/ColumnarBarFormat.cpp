@@ -0,0 +1,393 @@
+// src/data/ColumnarBarFormat.cpp
+
+#include "data/ColumnarBarFormat.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // Slicing-by-8 tables: table[k][b] is the CRC of byte b followed by k zero bytes
+    constexpr std::array<std::array<std::uint32_t, 256>, 8> make_crc_tables() {
+        std::array<std::array<std::uint32_t, 256>, 8> tables{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            tables[0][i] = c;
+        }
+        for (std::size_t k = 1; k < 8; ++k) {
+            for (std::size_t i = 0; i < 256; ++i) {
+                tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    constexpr auto kCrcTables = make_crc_tables();
+
+    inline std::uint64_t load_big_endian(const std::uint8_t* bytes) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+#if defined(_MSC_VER)
+        return _byteswap_uint64(word);
+#else
+        return __builtin_bswap64(word);
+#endif
+    }
+
+    inline std::uint64_t zigzag(std::uint64_t value) {
+        return (value << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63);
+    }
+
+    inline std::uint64_t unzigzag(std::uint64_t value) {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    /**
+     * @brief Appends bits most-significant first.
+     */
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+        // Writes the low `count` bits of `value`, 1 <= count <= 64.
+        void write(std::uint64_t value, unsigned count) {
+            if (count > 32) {
+                write(value >> 32, count - 32);
+                count = 32;
+            }
+            m_bits = (m_bits << count) | (value & ((std::uint64_t{1} << count) - 1));
+            m_used += count;
+            while (m_used >= 8) {
+                m_used -= 8;
+                m_out.push_back(static_cast<std::uint8_t>(m_bits >> m_used));
+            }
+        }
+
+        // Flushes the last partial byte, zero-filled.
+        void finish() {
+            if (m_used > 0) {
+                m_out.push_back(static_cast<std::uint8_t>(m_bits << (8 - m_used)));
+                m_used = 0;
+            }
+        }
+
+    private:
+        std::vector<std::uint8_t>& m_out;
+        std::uint64_t m_bits = 0;
+        unsigned m_used = 0;
+    };
+
+    /**
+     * @brief Reads bits most-significant first, one unaligned 64-bit load per read.
+     * Relies on the block's trailing padding; reading into it means the payload is truncated.
+     */
+    class BitReader {
+    public:
+        explicit BitReader(std::span<const std::uint8_t> payload) : m_data(payload.data()), m_size(payload.size()) {}
+
+        // Reads `count` bits, 1 <= count <= 64.
+        std::uint64_t read(unsigned count) {
+            if (count > 56) {
+                const std::uint64_t high = read(count - 32);
+                return (high << 32) | read(32);
+            }
+            const std::size_t byte = m_position >> 3;
+            if (byte + 8 > m_size) {
+                throw std::runtime_error("Columnar block payload is truncated");
+            }
+            const std::uint64_t word = load_big_endian(m_data + byte) << (m_position & 7);
+            m_position += count;
+            return word >> (64 - count);
+        }
+
+        bool read_bit() { return read(1) != 0; }
+
+    private:
+        const std::uint8_t* m_data;
+        std::size_t m_size;
+        std::size_t m_position = 0;
+    };
+
+    // --- Timestamps: delta-of-delta buckets ---
+
+    void encode_timestamps(std::span<const DataBarRecord> bars, BitWriter& writer) {
+        std::uint64_t previous = bars[0].timestamp_epoch_ns;
+        std::uint64_t previous_delta = 0;
+        writer.write(previous, 64);
+        for (std::size_t i = 1; i < bars.size(); ++i) {
+            const std::uint64_t delta = bars[i].timestamp_epoch_ns - previous;
+            const std::uint64_t bits = zigzag(delta - previous_delta);
+            if (bits == 0) {
+                writer.write(0b0, 1);
+            } else if (bits < (std::uint64_t{1} << 20)) {
+                writer.write(0b10, 2);
+                writer.write(bits, 20);
+            } else if (bits < (std::uint64_t{1} << 48)) {
+                writer.write(0b110, 3);
+                writer.write(bits, 48);
+            } else {
+                writer.write(0b111, 3);
+                writer.write(bits, 64);
+            }
+            previous = bars[i].timestamp_epoch_ns;
+            previous_delta = delta;
+        }
+    }
+
+    void decode_timestamps(BitReader& reader, std::span<DataBarRecord> bars) {
+        std::uint64_t previous = reader.read(64);
+        std::uint64_t delta = 0;
+        bars[0].timestamp_epoch_ns = previous;
+        for (std::size_t i = 1; i < bars.size(); ++i) {
+            if (reader.read_bit()) {
+                unsigned width = 20;
+                if (reader.read_bit()) {
+                    width = reader.read_bit() ? 64 : 48;
+                }
+                delta += unzigzag(reader.read(width));
+            }
+            previous += delta;
+            bars[i].timestamp_epoch_ns = previous;
+        }
+    }
+
+    // --- Prices: scaled decimals, or Gorilla XOR ---
+
+    constexpr unsigned kMaxDecimals = 6;
+    constexpr double kPowersOfTen[kMaxDecimals + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+
+    // The fewest decimals that represent every value of the column exactly, or -1.
+    template <double DataBarRecord::*Field>
+    int exact_decimals(std::span<const DataBarRecord> bars) {
+        for (unsigned decimals = 0; decimals <= kMaxDecimals; ++decimals) {
+            const double scale = kPowersOfTen[decimals];
+            bool exact = true;
+            for (const DataBarRecord& bar : bars) {
+                const double scaled = bar.*Field * scale;
+                // Decoding divides by the scale, which must give back the same bits
+                if (!(std::abs(scaled) < 0x1p53)
+                    || std::bit_cast<std::uint64_t>(std::round(scaled) / scale) != std::bit_cast<std::uint64_t>(bar.*Field)) {
+                    exact = false;
+                    break;
+                }
+            }
+            if (exact) {
+                return static_cast<int>(decimals);
+            }
+        }
+        return -1;
+    }
+
+    void write_delta(std::uint64_t bits, BitWriter& writer) {
+        if (bits == 0) {
+            writer.write(0b0, 1);
+        } else if (bits < (std::uint64_t{1} << 6)) {
+            writer.write(0b10, 2);
+            writer.write(bits, 6);
+        } else if (bits < (std::uint64_t{1} << 14)) {
+            writer.write(0b110, 3);
+            writer.write(bits, 14);
+        } else {
+            writer.write(0b111, 3);
+            writer.write(bits, 64);
+        }
+    }
+
+    std::uint64_t read_delta(BitReader& reader) {
+        if (!reader.read_bit()) {
+            return 0;
+        }
+        if (!reader.read_bit()) {
+            return reader.read(6);
+        }
+        return reader.read(reader.read_bit() ? 64 : 14);
+    }
+
+    // Prices quoted in ticks (eg whole cents) are integers once scaled: store their deltas.
+    template <double DataBarRecord::*Field>
+    void encode_decimal_prices(std::span<const DataBarRecord> bars, unsigned decimals, BitWriter& writer) {
+        const double scale = kPowersOfTen[decimals];
+        std::uint64_t previous = 0;
+        for (const DataBarRecord& bar : bars) {
+            const auto ticks = static_cast<std::uint64_t>(static_cast<std::int64_t>(std::round(bar.*Field * scale)));
+            write_delta(zigzag(ticks - previous), writer);
+            previous = ticks;
+        }
+    }
+
+    template <double DataBarRecord::*Field>
+    void decode_decimal_prices(BitReader& reader, unsigned decimals, std::span<DataBarRecord> bars) {
+        const double scale = kPowersOfTen[decimals];
+        std::uint64_t ticks = 0;
+        for (DataBarRecord& bar : bars) {
+            ticks += unzigzag(read_delta(reader));
+            bar.*Field = static_cast<double>(static_cast<std::int64_t>(ticks)) / scale;
+        }
+    }
+
+    // Anything else: XOR against the previous value, storing only the bits that changed.
+    template <double DataBarRecord::*Field>
+    void encode_xor_prices(std::span<const DataBarRecord> bars, BitWriter& writer) {
+        std::uint64_t previous = std::bit_cast<std::uint64_t>(bars[0].*Field);
+        writer.write(previous, 64);
+        unsigned window_leading = 65; // No window yet
+        unsigned window_trailing = 0;
+        for (std::size_t i = 1; i < bars.size(); ++i) {
+            const std::uint64_t value = std::bit_cast<std::uint64_t>(bars[i].*Field);
+            const std::uint64_t x = value ^ previous;
+            previous = value;
+            if (x == 0) {
+                writer.write(0b0, 1);
+                continue;
+            }
+            const unsigned leading = std::min(std::countl_zero(x), 31);
+            const unsigned trailing = std::countr_zero(x);
+            if (leading >= window_leading && trailing >= window_trailing) {
+                // Fits the previous window: store only its bits
+                writer.write(0b10, 2);
+                writer.write(x >> window_trailing, 64 - window_leading - window_trailing);
+            } else {
+                const unsigned meaningful = 64 - leading - trailing;
+                writer.write(0b11, 2);
+                writer.write(leading, 5);
+                writer.write(meaningful - 1, 6);
+                writer.write(x >> trailing, meaningful);
+                window_leading = leading;
+                window_trailing = trailing;
+            }
+        }
+    }
+
+    template <double DataBarRecord::*Field>
+    void decode_xor_prices(BitReader& reader, std::span<DataBarRecord> bars) {
+        std::uint64_t previous = reader.read(64);
+        bars[0].*Field = std::bit_cast<double>(previous);
+        unsigned window_leading = 0;
+        unsigned window_trailing = 0;
+        for (std::size_t i = 1; i < bars.size(); ++i) {
+            if (reader.read_bit()) {
+                if (reader.read_bit()) {
+                    window_leading = static_cast<unsigned>(reader.read(5));
+                    const unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+                    if (window_leading + meaningful > 64) {
+                        throw std::runtime_error("Columnar block payload is corrupt");
+                    }
+                    window_trailing = 64 - window_leading - meaningful;
+                }
+                const unsigned meaningful = 64 - window_leading - window_trailing;
+                previous ^= reader.read(meaningful) << window_trailing;
+            }
+            bars[i].*Field = std::bit_cast<double>(previous);
+        }
+    }
+
+    // Each price column starts with 3 bits: the decimal count, or 7 for XOR.
+    constexpr unsigned kXorMode = 7;
+
+    template <double DataBarRecord::*Field>
+    void encode_prices(std::span<const DataBarRecord> bars, BitWriter& writer) {
+        const int decimals = exact_decimals<Field>(bars);
+        if (decimals >= 0) {
+            writer.write(static_cast<unsigned>(decimals), 3);
+            encode_decimal_prices<Field>(bars, static_cast<unsigned>(decimals), writer);
+        } else {
+            writer.write(kXorMode, 3);
+            encode_xor_prices<Field>(bars, writer);
+        }
+    }
+
+    template <double DataBarRecord::*Field>
+    void decode_prices(BitReader& reader, std::span<DataBarRecord> bars) {
+        const auto mode = static_cast<unsigned>(reader.read(3));
+        if (mode == kXorMode) {
+            decode_xor_prices<Field>(reader, bars);
+        } else if (mode <= kMaxDecimals) {
+            decode_decimal_prices<Field>(reader, mode, bars);
+        } else {
+            throw std::runtime_error("Columnar block payload is corrupt");
+        }
+    }
+
+    // --- Volume: 7-bit groups ---
+
+    void encode_volumes(std::span<const DataBarRecord> bars, BitWriter& writer) {
+        for (const DataBarRecord& bar : bars) {
+            std::uint64_t volume = bar.volume;
+            while (volume >= 0x80) {
+                writer.write((volume & 0x7F) | 0x80, 8);
+                volume >>= 7;
+            }
+            writer.write(volume, 8);
+        }
+    }
+
+    void decode_volumes(BitReader& reader, std::span<DataBarRecord> bars) {
+        for (DataBarRecord& bar : bars) {
+            std::uint64_t volume = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                const std::uint64_t group = reader.read(8);
+                if (shift < 64) {
+                    volume |= (group & 0x7F) << shift;
+                }
+                if (!(group & 0x80)) {
+                    break;
+                }
+            }
+            bar.volume = volume;
+        }
+    }
+}
+
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    crc = ~crc;
+    // Eight bytes per step (little-endian host, like the file layouts)
+    for (; size >= 8; size -= 8, bytes += 8) {
+        std::uint32_t low;
+        std::uint32_t high;
+        std::memcpy(&low, bytes, 4);
+        std::memcpy(&high, bytes + 4, 4);
+        low ^= crc;
+        crc = kCrcTables[7][low & 0xFF] ^ kCrcTables[6][(low >> 8) & 0xFF]
+            ^ kCrcTables[5][(low >> 16) & 0xFF] ^ kCrcTables[4][low >> 24]
+            ^ kCrcTables[3][high & 0xFF] ^ kCrcTables[2][(high >> 8) & 0xFF]
+            ^ kCrcTables[1][(high >> 16) & 0xFF] ^ kCrcTables[0][high >> 24];
+    }
+    for (; size > 0; --size, ++bytes) {
+        crc = kCrcTables[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void encode_columnar_block(std::span<const DataBarRecord> bars, std::vector<std::uint8_t>& out) {
+    if (bars.empty()) {
+        return;
+    }
+    BitWriter writer(out);
+    encode_timestamps(bars, writer);
+    encode_prices<&DataBarRecord::open>(bars, writer);
+    encode_prices<&DataBarRecord::high>(bars, writer);
+    encode_prices<&DataBarRecord::low>(bars, writer);
+    encode_prices<&DataBarRecord::close>(bars, writer);
+    encode_volumes(bars, writer);
+    writer.finish();
+    out.insert(out.end(), kColumnarBlockPadding, 0);
+}
+
+void decode_columnar_block(std::span<const std::uint8_t> payload, std::span<DataBarRecord> bars) {
+    if (bars.empty()) {
+        return;
+    }
+    BitReader reader(payload);
+    decode_timestamps(reader, bars);
+    decode_prices<&DataBarRecord::open>(reader, bars);
+    decode_prices<&DataBarRecord::high>(reader, bars);
+    decode_prices<&DataBarRecord::low>(reader, bars);
+    decode_prices<&DataBarRecord::close>(reader, bars);
+    decode_volumes(reader, bars);
+}
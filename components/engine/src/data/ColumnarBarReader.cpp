@@ -0,0 +1,194 @@
+// src/data/ColumnarBarReader.cpp
+
+#include "data/ColumnarBarReader.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ColumnarBarReader::ColumnarBarReader(const std::string& file_path,
+                                     const std::shared_ptr<SymbolRegistry>& registry)
+    : m_file_path(file_path) {
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + file_path);
+    }
+
+    const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+    if (file_size < sizeof(ColumnarFileHeader) + sizeof(ColumnarFileTrailer)) {
+        ::close(fd);
+        throw std::runtime_error("File " + file_path + " is too small to be a .cbar file");
+    }
+
+    m_mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file contents alive.
+    if (m_mapping == MAP_FAILED) {
+        m_mapping = nullptr;
+        throw std::runtime_error("Failed to mmap file: " + file_path);
+    }
+    m_mapping_size = file_size;
+    m_bytes = static_cast<const std::uint8_t*>(m_mapping);
+
+    // From here on a failed check must unmap before throwing
+    auto fail = [&](const std::string& reason) {
+        ::munmap(m_mapping, m_mapping_size);
+        m_mapping = nullptr;
+        throw std::runtime_error("File " + file_path + " is not a valid .cbar file: " + reason);
+    };
+
+    ColumnarFileHeader header;
+    ColumnarFileTrailer trailer;
+    std::memcpy(&header, m_bytes, sizeof(header));
+    std::memcpy(&trailer, m_bytes + file_size - sizeof(trailer), sizeof(trailer));
+    if (std::memcmp(header.magic, kColumnarMagic, sizeof(header.magic)) != 0
+        || std::memcmp(trailer.magic, kColumnarMagic, sizeof(trailer.magic)) != 0) {
+        fail("bad magic (unfinished file?)");
+    }
+    if (header.version != kColumnarVersion) {
+        fail("unsupported version " + std::to_string(header.version));
+    }
+    std::memcpy(m_template.symbol, header.symbol, sizeof(m_template.symbol));
+    if (symbol().empty() || header.bars_per_block == 0) {
+        fail("bad header");
+    }
+
+    const std::uint64_t index_bytes = std::uint64_t{trailer.block_count} * sizeof(ColumnarBlockIndexEntry);
+    if (trailer.index_offset < sizeof(ColumnarFileHeader)
+        || trailer.index_offset + index_bytes + sizeof(trailer) != file_size) {
+        fail("bad block index location");
+    }
+    if (crc32(m_bytes + trailer.index_offset, index_bytes) != trailer.index_crc32) {
+        fail("block index checksum mismatch");
+    }
+    m_index.resize(trailer.block_count);
+    std::memcpy(m_index.data(), m_bytes + trailer.index_offset, index_bytes);
+
+    std::uint64_t bars = 0;
+    std::size_t largest_block = 0;
+    for (const ColumnarBlockIndexEntry& entry : m_index) {
+        if (entry.offset < sizeof(ColumnarFileHeader) || entry.offset + entry.size > trailer.index_offset
+            || entry.size < kColumnarBlockPadding || entry.bar_count == 0
+            || entry.bar_count > header.bars_per_block) {
+            fail("bad block index entry");
+        }
+        bars += entry.bar_count;
+        largest_block = std::max<std::size_t>(largest_block, entry.bar_count);
+    }
+    if (bars != trailer.bar_count) {
+        fail("bar count does not match the block index");
+    }
+    m_bar_count = bars;
+
+    ::madvise(m_mapping, m_mapping_size, MADV_SEQUENTIAL);
+
+    // Every decoded record carries the symbol; it is written once here, not per block
+    m_decoded.assign(largest_block, m_template);
+
+    if (registry) {
+        m_symbol_id = registry->intern(symbol());
+    }
+}
+
+ColumnarBarReader::~ColumnarBarReader() {
+    if (m_mapping) {
+        ::munmap(m_mapping, m_mapping_size);
+    }
+}
+
+bool ColumnarBarReader::load_block(std::size_t block) {
+    if (block >= m_index.size()) {
+        return false;
+    }
+    const ColumnarBlockIndexEntry& entry = m_index[block];
+    const std::span<const std::uint8_t> payload(m_bytes + entry.offset, entry.size);
+    if (crc32(payload.data(), payload.size()) != entry.crc32) {
+        throw std::runtime_error("Block " + std::to_string(block) + " of " + m_file_path + " failed its checksum");
+    }
+
+    // Start reading the next block from disk while this one is decoded and consumed
+    if (block + 1 < m_index.size()) {
+        static const auto page_size = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+        const ColumnarBlockIndexEntry& next = m_index[block + 1];
+        const std::uint64_t begin = next.offset & ~(page_size - 1);
+        ::madvise(static_cast<std::uint8_t*>(m_mapping) + begin, next.offset + next.size - begin, MADV_WILLNEED);
+    }
+
+    decode_columnar_block(payload, std::span<DataBarRecord>(m_decoded.data(), entry.bar_count));
+    m_decoded_count = entry.bar_count;
+    m_next_block = block + 1;
+    m_block_position = 0;
+    return true;
+}
+
+const DataBarRecord* ColumnarBarReader::next_record() {
+    if (m_block_position >= m_decoded_count && !load_block(m_next_block)) {
+        return nullptr;
+    }
+    ++m_position;
+    return &m_decoded[m_block_position++];
+}
+
+std::span<const DataBarRecord> ColumnarBarReader::next_batch(std::size_t max_records) {
+    if (m_block_position >= m_decoded_count && !load_block(m_next_block)) {
+        return {};
+    }
+    const std::size_t count = std::min(max_records, m_decoded_count - m_block_position);
+    std::span<const DataBarRecord> batch(m_decoded.data() + m_block_position, count);
+    m_block_position += count;
+    m_position += count;
+    return batch;
+}
+
+std::optional<DataBar> ColumnarBarReader::get_next_bar() {
+    const DataBarRecord* record = next_record();
+    if (!record) {
+        return std::nullopt;
+    }
+    return to_data_bar(*record, m_symbol_id);
+}
+
+SymbolId ColumnarBarReader::symbol_id_of([[maybe_unused]] const DataBarRecord& record) const {
+    return m_symbol_id; // Every record of the file has the file's symbol
+}
+
+void ColumnarBarReader::seek(std::uint64_t timestamp_ns) {
+    // The first block that ends at or after the timestamp holds the first bar wanted
+    const auto block = std::partition_point(m_index.begin(), m_index.end(),
+        [timestamp_ns](const ColumnarBlockIndexEntry& entry) { return entry.last_timestamp_ns < timestamp_ns; });
+    m_position = 0;
+    for (auto it = m_index.begin(); it != block; ++it) {
+        m_position += it->bar_count;
+    }
+    if (!load_block(static_cast<std::size_t>(block - m_index.begin()))) {
+        m_decoded_count = 0; // Past the last bar
+        m_block_position = 0;
+        m_next_block = m_index.size();
+        return;
+    }
+    const DataBarRecord* begin = m_decoded.data();
+    const DataBarRecord* first = std::partition_point(begin, begin + m_decoded_count,
+        [timestamp_ns](const DataBarRecord& record) { return record.timestamp_epoch_ns < timestamp_ns; });
+    m_block_position = static_cast<std::size_t>(first - begin);
+    m_position += m_block_position;
+}
+
+void ColumnarBarReader::resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) {
+    seek(timestamp_ns);
+    skip_bars_at(timestamp_ns, bars_at_timestamp);
+}
+
+void ColumnarBarReader::rewind() {
+    m_decoded_count = 0;
+    m_next_block = 0;
+    m_block_position = 0;
+    m_position = 0;
+}
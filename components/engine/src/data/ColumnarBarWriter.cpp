@@ -0,0 +1,97 @@
+// src/data/ColumnarBarWriter.cpp
+
+#include "data/ColumnarBarWriter.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+ColumnarBarWriter::ColumnarBarWriter(const std::string& file_path, const std::string& symbol,
+                                     std::size_t bars_per_block)
+    : m_file_path(file_path),
+      m_out(file_path, std::ios::binary | std::ios::trunc),
+      m_bars_per_block(bars_per_block)
+{
+    if (!m_out) {
+        throw std::runtime_error("Failed to create file: " + file_path);
+    }
+    if (symbol.empty() || symbol.size() >= sizeof(ColumnarFileHeader::symbol)) {
+        throw std::invalid_argument("Symbol '" + symbol + "' must be 1 to 15 characters");
+    }
+    if (bars_per_block == 0 || bars_per_block > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("bars_per_block must be positive and fit in 32 bits");
+    }
+
+    ColumnarFileHeader header{};
+    std::memcpy(header.magic, kColumnarMagic, sizeof(header.magic));
+    header.version = kColumnarVersion;
+    std::memcpy(header.symbol, symbol.data(), symbol.size());
+    header.bars_per_block = static_cast<std::uint32_t>(bars_per_block);
+    write(&header, sizeof(header));
+
+    m_block.reserve(bars_per_block);
+}
+
+void ColumnarBarWriter::append(const DataBarRecord& bar) {
+    if (m_finished) {
+        throw std::logic_error("ColumnarBarWriter::append after finish");
+    }
+    if (m_bar_count > 0 && bar.timestamp_epoch_ns < m_last_timestamp_ns) {
+        throw std::invalid_argument("Bars must be appended in time order (" + m_file_path + ")");
+    }
+    m_last_timestamp_ns = bar.timestamp_epoch_ns;
+    m_block.push_back(bar);
+    ++m_bar_count;
+    if (m_block.size() == m_bars_per_block) {
+        flush_block();
+    }
+}
+
+void ColumnarBarWriter::flush_block() {
+    if (m_block.empty()) {
+        return;
+    }
+    m_payload.clear();
+    encode_columnar_block(m_block, m_payload);
+
+    ColumnarBlockIndexEntry entry{};
+    entry.offset = m_offset;
+    entry.size = static_cast<std::uint32_t>(m_payload.size());
+    entry.bar_count = static_cast<std::uint32_t>(m_block.size());
+    entry.first_timestamp_ns = m_block.front().timestamp_epoch_ns;
+    entry.last_timestamp_ns = m_block.back().timestamp_epoch_ns;
+    entry.crc32 = crc32(m_payload.data(), m_payload.size());
+    m_index.push_back(entry);
+
+    write(m_payload.data(), m_payload.size());
+    m_block.clear();
+}
+
+void ColumnarBarWriter::finish() {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    flush_block();
+
+    ColumnarFileTrailer trailer{};
+    trailer.index_offset = m_offset;
+    trailer.bar_count = m_bar_count;
+    trailer.block_count = static_cast<std::uint32_t>(m_index.size());
+    trailer.index_crc32 = crc32(m_index.data(), m_index.size() * sizeof(ColumnarBlockIndexEntry));
+    std::memcpy(trailer.magic, kColumnarMagic, sizeof(trailer.magic));
+
+    write(m_index.data(), m_index.size() * sizeof(ColumnarBlockIndexEntry));
+    write(&trailer, sizeof(trailer));
+    m_out.close();
+    if (!m_out) {
+        throw std::runtime_error("Failed to write file: " + m_file_path);
+    }
+}
+
+void ColumnarBarWriter::write(const void* data, std::size_t size) {
+    m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!m_out) {
+        throw std::runtime_error("Failed to write file: " + m_file_path);
+    }
+    m_offset += size;
+}
@@ -0,0 +1,48 @@
+// src/data/InMemoryBarProvider.cpp
+
+#include "data/InMemoryBarProvider.h"
+#include <algorithm>
+#include <stdexcept>
+
+InMemoryBarProvider::InMemoryBarProvider(SharedBarStore bars, TimeRange range)
+    : m_bars(std::move(bars)) {
+    if (!m_bars) {
+        throw std::invalid_argument("InMemoryBarProvider needs a bar store");
+    }
+    auto before = [](std::uint64_t bound) {
+        return [bound](const DataBar& bar) { return TimeRange::to_epoch_ns(bar.timestamp) < bound; };
+    };
+    m_position = static_cast<std::size_t>(
+        std::partition_point(m_bars->begin(), m_bars->end(), before(range.start_ns)) - m_bars->begin());
+    m_end = static_cast<std::size_t>(
+        std::partition_point(m_bars->begin() + static_cast<std::ptrdiff_t>(m_position), m_bars->end(),
+                             before(range.end_ns)) - m_bars->begin());
+}
+
+std::optional<DataBar> InMemoryBarProvider::get_next_bar() {
+    if (m_position >= m_end) {
+        return std::nullopt;
+    }
+    return (*m_bars)[m_position++];
+}
+
+void InMemoryBarProvider::resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) {
+    m_position = static_cast<std::size_t>(
+        std::partition_point(m_bars->begin(), m_bars->begin() + static_cast<std::ptrdiff_t>(m_end),
+                             [timestamp_ns](const DataBar& bar) {
+                                 return TimeRange::to_epoch_ns(bar.timestamp) < timestamp_ns;
+                             }) - m_bars->begin());
+    skip_bars_at(timestamp_ns, bars_at_timestamp);
+}
+
+SharedBarStore InMemoryBarProvider::load_all(IDataProvider& provider, SymbolRegistry* registry) {
+    auto bars = std::make_shared<std::vector<DataBar>>();
+    while (auto bar = provider.get_next_bar()) {
+        if (registry && bar->symbol_id == kInvalidSymbolId) {
+            bar->symbol_id = registry->intern(bar->symbol);
+        }
+        bars->push_back(std::move(*bar));
+    }
+    bars->shrink_to_fit();
+    return bars;
+}
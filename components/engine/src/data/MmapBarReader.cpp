@@ -0,0 +1,112 @@
+// src/data/MmapBarReader.cpp
+
+#include "data/MmapBarReader.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MmapBarReader::MmapBarReader(const std::string& file_path,
+                             const std::shared_ptr<SymbolRegistry>& registry) {
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + file_path);
+    }
+
+    const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+    if (file_size > 0) {
+        m_mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m_mapping == MAP_FAILED) {
+            m_mapping = nullptr;
+            ::close(fd);
+            throw std::runtime_error("Failed to mmap file: " + file_path);
+        }
+        m_mapping_size = file_size;
+        ::madvise(m_mapping, m_mapping_size, MADV_SEQUENTIAL);
+    }
+    ::close(fd); // The mapping keeps the file contents alive.
+
+    std::size_t records_offset = 0;
+    try {
+        records_offset = bar_file_records_offset(m_mapping, file_size);
+    } catch (const std::exception& e) {
+        ::munmap(m_mapping, m_mapping_size);
+        throw std::runtime_error("File " + file_path + ": " + e.what());
+    }
+    if ((file_size - records_offset) % sizeof(DataBarRecord) != 0) {
+        if (m_mapping) {
+            ::munmap(m_mapping, m_mapping_size);
+        }
+        throw std::runtime_error("File size of " + file_path + " is not a multiple of the "
+                                 + std::to_string(sizeof(DataBarRecord)) + "-byte record layout");
+    }
+
+    // mmap returns page-aligned memory and the header is one record long, so the records are aligned.
+    m_records = reinterpret_cast<const DataBarRecord*>(static_cast<const std::uint8_t*>(m_mapping) + records_offset);
+    m_record_count = (file_size - records_offset) / sizeof(DataBarRecord);
+
+    if (m_record_count > 0 && record_symbol(m_records[0]).empty()) {
+        ::munmap(m_mapping, m_mapping_size);
+        throw std::runtime_error("File " + file_path + " does not look like a DataBarRecord file");
+    }
+
+    if (registry && m_record_count > 0) {
+        std::memcpy(m_symbol, m_records[0].symbol, sizeof(m_symbol));
+        m_symbol_id = registry->intern(record_symbol(m_records[0]));
+    }
+}
+
+MmapBarReader::~MmapBarReader() {
+    if (m_mapping) {
+        ::munmap(m_mapping, m_mapping_size);
+    }
+}
+
+std::optional<DataBar> MmapBarReader::get_next_bar() {
+    const DataBarRecord* record = next_record();
+    if (!record) {
+        return std::nullopt;
+    }
+    return to_data_bar(*record, symbol_id_of(*record));
+}
+
+SymbolId MmapBarReader::symbol_id_of(const DataBarRecord& record) const {
+    if (m_symbol_id != kInvalidSymbolId && std::memcmp(record.symbol, m_symbol, sizeof(m_symbol)) == 0) {
+        return m_symbol_id;
+    }
+    return kInvalidSymbolId;
+}
+
+const DataBarRecord* MmapBarReader::next_record() {
+    if (m_position >= m_record_count) {
+        return nullptr;
+    }
+    return &m_records[m_position++];
+}
+
+void MmapBarReader::seek(std::uint64_t timestamp_ns) {
+    const DataBarRecord* first = std::partition_point(m_records, m_records + m_record_count,
+        [timestamp_ns](const DataBarRecord& record) { return record.timestamp_epoch_ns < timestamp_ns; });
+    m_position = static_cast<std::size_t>(first - m_records);
+}
+
+void MmapBarReader::resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) {
+    seek(timestamp_ns);
+    skip_bars_at(timestamp_ns, bars_at_timestamp);
+}
+
+std::span<const DataBarRecord> MmapBarReader::next_batch(std::size_t max_records) {
+    std::size_t count = std::min(max_records, m_record_count - m_position);
+    std::span<const DataBarRecord> batch(m_records + m_position, count);
+    m_position += count;
+    return batch;
+}
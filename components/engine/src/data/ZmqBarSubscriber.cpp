@@ -0,0 +1,93 @@
+// src/data/ZmqBarSubscriber.cpp
+
+#include "data/ZmqBarSubscriber.h"
+#include "logging/Logger.h"
+#include <cstring>
+
+using Clock = std::chrono::steady_clock;
+
+ZmqBarSubscriber::ZmqBarSubscriber(const std::string& endpoint, std::shared_ptr<SymbolRegistry> registry,
+                                   LiveFeedOptions options)
+    : m_options(std::move(options)),
+      m_registry(std::move(registry)),
+      m_socket(m_context, zmq::socket_type::sub)
+{
+    m_socket.set(zmq::sockopt::linger, 0);
+    m_socket.set(zmq::sockopt::rcvhwm, 0); // Queue bursts instead of dropping them
+    if (m_options.symbols.empty()) {
+        m_socket.set(zmq::sockopt::subscribe, "");
+    } else {
+        // Messages start with the symbol, so a prefix subscription selects it. The
+        // empty end-of-feed message matches no prefix; the idle timeout ends the stream.
+        for (const std::string& symbol : m_options.symbols) {
+            m_socket.set(zmq::sockopt::subscribe, symbol);
+            if (m_registry) {
+                m_registry->intern(symbol);
+            }
+        }
+    }
+    m_socket.connect(endpoint);
+    LOG_INFO("LiveFeed", "Subscribed to {} ({})", endpoint,
+             m_options.wait_policy == FeedWaitPolicy::BusyPoll ? "busy-poll" : "spin-then-block");
+}
+
+bool ZmqBarSubscriber::try_receive() {
+    return static_cast<bool>(m_socket.recv(m_message, zmq::recv_flags::dontwait));
+}
+
+bool ZmqBarSubscriber::wait_readable(std::chrono::milliseconds timeout) {
+    zmq::pollitem_t item{m_socket.handle(), 0, ZMQ_POLLIN, 0};
+    ++m_blocking_waits;
+    return zmq::poll(&item, 1, timeout) > 0;
+}
+
+std::optional<DataBar> ZmqBarSubscriber::get_next_bar() {
+    if (m_finished) {
+        return std::nullopt;
+    }
+
+    const auto wait_start = Clock::now();
+    const bool may_block = m_options.wait_policy == FeedWaitPolicy::SpinThenBlock;
+    const bool has_idle_timeout = m_options.idle_timeout.count() > 0;
+    while (true) {
+        if (!try_receive()) {
+            const auto now = Clock::now();
+            if (has_idle_timeout && now - wait_start >= m_options.idle_timeout) {
+                LOG_WARN("LiveFeed", "No bar for {} ms; ending the stream", m_options.idle_timeout.count());
+                m_finished = true;
+                return std::nullopt;
+            }
+            if (may_block && now - wait_start >= m_options.spin_time) {
+                // Spun long enough: sleep in the kernel until the socket is readable
+                const auto timeout = has_idle_timeout
+                    ? std::chrono::ceil<std::chrono::milliseconds>(m_options.idle_timeout - (now - wait_start))
+                    : std::chrono::milliseconds(-1);
+                wait_readable(timeout);
+            }
+            continue;
+        }
+
+        m_last_arrival = Clock::now();
+        if (m_message.size() == 0) {
+            LOG_INFO("LiveFeed", "End of feed after {} bars", m_bars_received);
+            m_finished = true;
+            return std::nullopt;
+        }
+        if (m_message.size() != sizeof(LiveBarMessage)) {
+            if (m_malformed_messages++ == 0) {
+                LOG_WARN("LiveFeed", "Skipping a {}-byte message (expected {})", m_message.size(), sizeof(LiveBarMessage));
+            }
+            continue;
+        }
+
+        LiveBarMessage message;
+        std::memcpy(&message, m_message.data(), sizeof(message)); // The frame may not be 8-byte aligned
+        if (message.published_ns != 0) {
+            const std::uint64_t received_ns = steady_clock_ns(m_last_arrival);
+            m_feed_latency.record(received_ns > message.published_ns ? received_ns - message.published_ns : 0);
+        }
+        ++m_bars_received;
+        const SymbolId id = m_registry ? m_registry->intern(record_symbol(message.record)) : kInvalidSymbolId;
+        return to_data_bar(message.record, id);
+    }
+}
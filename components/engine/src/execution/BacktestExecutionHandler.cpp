@@ -3,12 +3,36 @@
 #include "execution/BacktestExecutionHandler.h"
 #include "core/Portfolio.h"
 #include "core/TradeOrder.h"
+#include "results/ResultsStore.h"
+#include <algorithm>
 #include <set>
 #include <cmath>
 
 BacktestExecutionHandler::BacktestExecutionHandler(double commission, double slippage)
     : m_commission_per_trade(commission), m_slippage_percentage(slippage) {}
 
+double BacktestExecutionHandler::execution_price(long long shares_to_trade, double latest_price) const {
+    if (shares_to_trade > 0) {
+        // Slippage (higher)
+        return latest_price * (1.0 + m_slippage_percentage);
+    }
+    // Slippage (lower)
+    return latest_price * (1.0 - m_slippage_percentage);
+}
+
+double BacktestExecutionHandler::cash_delta_for_fill(long long shares_to_trade, double latest_price) const {
+    OrderSide side = (shares_to_trade > 0) ? OrderSide::Buy : OrderSide::Sell;
+    long long trade_quantity = std::abs(shares_to_trade);
+
+    double trade_value = trade_quantity * execution_price(shares_to_trade, latest_price);
+
+    if (side == OrderSide::Buy) {
+        return -trade_value - m_commission_per_trade;
+    } else { // Sell
+        return trade_value - m_commission_per_trade;
+    }
+}
+
 void BacktestExecutionHandler::execute_trades(
     Portfolio& portfolio,
     const std::map<std::string, double>& approved_target,
@@ -54,26 +78,51 @@ void BacktestExecutionHandler::execute_trades(
             continue; // No trade needed
         }
 
-        OrderSide side = (shares_to_trade > 0) ? OrderSide::Buy : OrderSide::Sell;
-        long long trade_quantity = std::abs(shares_to_trade);
-        
-        double execution_price = 0.0;
-        if (side == OrderSide::Buy) {
-            // Slippage (higher)
-            execution_price = latest_price * (1.0 + m_slippage_percentage);
-        } else { // Sell
-            // Slippage (lower)
-            execution_price = latest_price * (1.0 - m_slippage_percentage);
+        portfolio.update_holding(symbol, shares_to_trade);
+        portfolio.update_cash(cash_delta_for_fill(shares_to_trade, latest_price));
+        if (m_results) {
+            m_results->record_fill(portfolio.registry()->find(symbol), shares_to_trade,
+                                   execution_price(shares_to_trade, latest_price), m_commission_per_trade);
         }
+    }
+}
 
-        double trade_value = trade_quantity * execution_price;
+void BacktestExecutionHandler::execute_target_weights(
+    Portfolio& portfolio,
+    const SymbolRegistry& registry,
+    const WeightVector& approved_weights,
+    const PriceVector& latest_prices
+) {
+    // Get the total market value of the portfolio before any trades
+    double total_value = portfolio.get_total_value();
 
-        portfolio.update_holding(symbol, shares_to_trade);
+    // Only held or targeted assets can produce a trade
+    portfolio.tradable_ids(approved_weights, m_trade_ids);
+    for (SymbolId id : m_trade_ids) {
+        if (id >= registry.size() || id >= latest_prices.size() || latest_prices[id] <= 0.0) {
+            continue; // Cannot trade without a price
+        }
+        double latest_price = latest_prices[id];
+
+        // Target position in shares
+        double target_weight = id < approved_weights.size() ? approved_weights[id] : 0.0;
+        long long current_shares = portfolio.get_position(id);
+
+        double target_dollar_value = total_value * target_weight;
+        long long target_shares = static_cast<long long>(std::round(target_dollar_value / latest_price));
+
+        // Trade delta
+        long long shares_to_trade = target_shares - current_shares;
+
+        if (shares_to_trade == 0) {
+            continue; // No trade needed
+        }
 
-        if (side == OrderSide::Buy) {
-            portfolio.update_cash(-trade_value - m_commission_per_trade);
-        } else { // Sell
-            portfolio.update_cash(trade_value - m_commission_per_trade);
+        portfolio.update_holding(id, shares_to_trade);
+        portfolio.update_cash(cash_delta_for_fill(shares_to_trade, latest_price));
+        if (m_results) {
+            m_results->record_fill(id, shares_to_trade, execution_price(shares_to_trade, latest_price),
+                                   m_commission_per_trade);
         }
     }
-}
\ No newline at end of file
+}
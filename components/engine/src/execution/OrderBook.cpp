@@ -0,0 +1,309 @@
+// src/execution/OrderBook.cpp
+
+#include "execution/OrderBook.h"
+#include <algorithm>
+
+namespace {
+    constexpr std::int64_t kInitialLadderTicks = 1024;
+
+    std::size_t hash_id(std::uint64_t id) {
+        id *= 0x9E3779B97F4A7C15ull; // Fibonacci hashing; order ids are often sequential
+        return static_cast<std::size_t>(id ^ (id >> 32));
+    }
+}
+
+OrderBook::OrderBook(std::size_t expected_orders) {
+    m_orders.reserve(expected_orders);
+    std::size_t buckets = 16;
+    while (buckets < 2 * expected_orders) {
+        buckets *= 2;
+    }
+    m_ids.assign(buckets, IdEntry{0, kNone});
+    m_id_mask = buckets - 1;
+}
+
+// --- Ladders ---
+
+OrderBook::Level* OrderBook::level_for(BookSide side, std::int64_t price_ticks) {
+    Ladder& ladder = m_ladders[static_cast<int>(side)];
+    auto size = static_cast<std::int64_t>(ladder.levels.size());
+    if (size == 0) {
+        ladder.base = price_ticks - kInitialLadderTicks / 2;
+        ladder.levels.resize(kInitialLadderTicks);
+        size = kInitialLadderTicks;
+    }
+
+    std::int64_t index = price_ticks - ladder.base;
+    if (index < 0) {
+        // Grow downwards: shift every level up, keeping spare room below the new price
+        const std::int64_t shift = std::max(-index + size / 2, size);
+        if (size + shift > kMaxLadderTicks) {
+            return nullptr;
+        }
+        std::vector<Level> levels(static_cast<std::size_t>(size + shift));
+        std::move(ladder.levels.begin(), ladder.levels.end(), levels.begin() + shift);
+        ladder.levels = std::move(levels);
+        ladder.base -= shift;
+        if (ladder.best >= 0) {
+            ladder.best += shift;
+        }
+        index += shift;
+    } else if (index >= size) {
+        const std::int64_t new_size = std::max(index + 1 + size / 2, 2 * size);
+        if (index >= kMaxLadderTicks) {
+            return nullptr;
+        }
+        ladder.levels.resize(static_cast<std::size_t>(std::min(new_size, kMaxLadderTicks)));
+    }
+    return &ladder.levels[static_cast<std::size_t>(index)];
+}
+
+void OrderBook::level_filled(BookSide side, std::int64_t index) {
+    Ladder& ladder = m_ladders[static_cast<int>(side)];
+    if (ladder.best < 0 || (side == BookSide::Bid ? index > ladder.best : index < ladder.best)) {
+        ladder.best = index;
+    }
+}
+
+void OrderBook::level_drained(BookSide side, std::int64_t index) {
+    Ladder& ladder = m_ladders[static_cast<int>(side)];
+    if (index != ladder.best || ladder.levels[static_cast<std::size_t>(index)].quantity > 0) {
+        return;
+    }
+    // The best level emptied: walk outwards to the next one with quantity
+    const std::int64_t step = side == BookSide::Bid ? -1 : 1;
+    const auto size = static_cast<std::int64_t>(ladder.levels.size());
+    for (std::int64_t i = index + step; i >= 0 && i < size; i += step) {
+        if (ladder.levels[static_cast<std::size_t>(i)].quantity > 0) {
+            ladder.best = i;
+            return;
+        }
+    }
+    ladder.best = -1;
+}
+
+// --- L3 ---
+
+bool OrderBook::add_order(std::uint64_t order_id, BookSide side, std::int64_t price_ticks, std::int64_t quantity) {
+    if (quantity <= 0 || find_slot(order_id) != kNone) {
+        return false;
+    }
+    Level* level = level_for(side, price_ticks);
+    if (!level) {
+        return false;
+    }
+
+    std::uint32_t slot;
+    if (m_free != kNone) {
+        slot = m_free;
+        m_free = m_orders[slot].next;
+    } else {
+        slot = static_cast<std::uint32_t>(m_orders.size());
+        m_orders.emplace_back();
+    }
+    m_orders[slot] = Order{order_id, quantity, price_ticks, level->tail, kNone, side};
+
+    // Append to the level's FIFO: later orders queue behind earlier ones
+    if (level->tail != kNone) {
+        m_orders[level->tail].next = slot;
+    } else {
+        level->head = slot;
+    }
+    level->tail = slot;
+    level->quantity += quantity;
+
+    insert_id(order_id, slot);
+    ++m_order_count;
+    level_filled(side, price_ticks - m_ladders[static_cast<int>(side)].base);
+    return true;
+}
+
+void OrderBook::unlink(std::uint32_t slot) {
+    const Order order = m_orders[slot];
+    Ladder& ladder = m_ladders[static_cast<int>(order.side)];
+    const std::int64_t index = order.price_ticks - ladder.base;
+    Level& level = ladder.levels[static_cast<std::size_t>(index)];
+
+    if (order.prev != kNone) {
+        m_orders[order.prev].next = order.next;
+    } else {
+        level.head = order.next;
+    }
+    if (order.next != kNone) {
+        m_orders[order.next].prev = order.prev;
+    } else {
+        level.tail = order.prev;
+    }
+    level.quantity -= order.quantity;
+
+    erase_id(order.id);
+    m_orders[slot].next = m_free;
+    m_free = slot;
+    --m_order_count;
+    level_drained(order.side, index);
+}
+
+bool OrderBook::cancel_order(std::uint64_t order_id) {
+    const std::uint32_t slot = find_slot(order_id);
+    if (slot == kNone) {
+        return false;
+    }
+    unlink(slot);
+    return true;
+}
+
+bool OrderBook::execute_order(std::uint64_t order_id, std::int64_t quantity) {
+    const std::uint32_t slot = find_slot(order_id);
+    if (slot == kNone || quantity <= 0) {
+        return false;
+    }
+    Order& order = m_orders[slot];
+    if (quantity >= order.quantity) {
+        unlink(slot);
+        return true;
+    }
+    order.quantity -= quantity;
+    Ladder& ladder = m_ladders[static_cast<int>(order.side)];
+    ladder.levels[static_cast<std::size_t>(order.price_ticks - ladder.base)].quantity -= quantity;
+    return true;
+}
+
+// --- L2 ---
+
+bool OrderBook::set_level(BookSide side, std::int64_t price_ticks, std::int64_t quantity) {
+    if (quantity < 0) {
+        return false;
+    }
+    Level* level = level_for(side, price_ticks);
+    if (!level) {
+        return quantity == 0; // Clearing a level that cannot exist is a no-op
+    }
+    const std::int64_t change = quantity - level->l2_quantity;
+    level->l2_quantity = quantity;
+    level->quantity += change;
+
+    const std::int64_t index = price_ticks - m_ladders[static_cast<int>(side)].base;
+    if (change > 0) {
+        level_filled(side, index);
+    } else if (change < 0) {
+        level_drained(side, index);
+    }
+    return true;
+}
+
+bool OrderBook::apply(const BookEventRecord& event) {
+    const BookSide side = event.side == 0 ? BookSide::Bid : BookSide::Ask;
+    switch (event.type) {
+        case BookEventType::Add:
+            return add_order(event.order_id, side, event.price_ticks, event.quantity);
+        case BookEventType::Cancel:
+            return cancel_order(event.order_id);
+        case BookEventType::Execute:
+            return execute_order(event.order_id, event.quantity);
+        case BookEventType::Level:
+            return set_level(side, event.price_ticks, event.quantity);
+        case BookEventType::Clear:
+            clear();
+            return true;
+    }
+    return false;
+}
+
+void OrderBook::clear() {
+    for (Ladder& ladder : m_ladders) {
+        std::fill(ladder.levels.begin(), ladder.levels.end(), Level{});
+        ladder.best = -1;
+    }
+    m_orders.clear();
+    m_free = kNone;
+    m_order_count = 0;
+    std::fill(m_ids.begin(), m_ids.end(), IdEntry{0, kNone});
+}
+
+// --- Queries ---
+
+std::int64_t OrderBook::best_bid() const {
+    const Ladder& ladder = m_ladders[static_cast<int>(BookSide::Bid)];
+    return ladder.best < 0 ? kNoBid : ladder.base + ladder.best;
+}
+
+std::int64_t OrderBook::best_ask() const {
+    const Ladder& ladder = m_ladders[static_cast<int>(BookSide::Ask)];
+    return ladder.best < 0 ? kNoAsk : ladder.base + ladder.best;
+}
+
+std::int64_t OrderBook::level_quantity(BookSide side, std::int64_t price_ticks) const {
+    const Ladder& ladder = m_ladders[static_cast<int>(side)];
+    const std::int64_t index = price_ticks - ladder.base;
+    if (index < 0 || index >= static_cast<std::int64_t>(ladder.levels.size())) {
+        return 0;
+    }
+    return ladder.levels[static_cast<std::size_t>(index)].quantity;
+}
+
+bool OrderBook::order_level(std::uint64_t order_id, BookSide& side, std::int64_t& price_ticks) const {
+    const std::uint32_t slot = find_slot(order_id);
+    if (slot == kNone) {
+        return false;
+    }
+    side = m_orders[slot].side;
+    price_ticks = m_orders[slot].price_ticks;
+    return true;
+}
+
+// --- Order id table ---
+
+std::uint32_t OrderBook::find_slot(std::uint64_t order_id) const {
+    for (std::size_t bucket = hash_id(order_id) & m_id_mask;; bucket = (bucket + 1) & m_id_mask) {
+        const IdEntry& entry = m_ids[bucket];
+        if (entry.slot == kNone || entry.id == order_id) {
+            return entry.slot;
+        }
+    }
+}
+
+void OrderBook::insert_id(std::uint64_t order_id, std::uint32_t slot) {
+    if (2 * (m_order_count + 1) > m_ids.size()) {
+        grow_ids(); // Keep the load factor at or below one half
+    }
+    std::size_t bucket = hash_id(order_id) & m_id_mask;
+    while (m_ids[bucket].slot != kNone) {
+        bucket = (bucket + 1) & m_id_mask;
+    }
+    m_ids[bucket] = IdEntry{order_id, slot};
+}
+
+void OrderBook::erase_id(std::uint64_t order_id) {
+    std::size_t bucket = hash_id(order_id) & m_id_mask;
+    while (m_ids[bucket].id != order_id || m_ids[bucket].slot == kNone) {
+        bucket = (bucket + 1) & m_id_mask;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole,
+    // so lookups never need tombstones
+    std::size_t hole = bucket;
+    for (std::size_t next = (hole + 1) & m_id_mask; m_ids[next].slot != kNone; next = (next + 1) & m_id_mask) {
+        const std::size_t home = hash_id(m_ids[next].id) & m_id_mask;
+        // Move the entry if its home bucket is not in the cyclic range (hole, next]
+        if (((next - home) & m_id_mask) >= ((next - hole) & m_id_mask)) {
+            m_ids[hole] = m_ids[next];
+            hole = next;
+        }
+    }
+    m_ids[hole] = IdEntry{0, kNone};
+}
+
+void OrderBook::grow_ids() {
+    std::vector<IdEntry> old = std::move(m_ids);
+    m_ids.assign(old.size() * 2, IdEntry{0, kNone});
+    m_id_mask = m_ids.size() - 1;
+    for (const IdEntry& entry : old) {
+        if (entry.slot != kNone) {
+            std::size_t bucket = hash_id(entry.id) & m_id_mask;
+            while (m_ids[bucket].slot != kNone) {
+                bucket = (bucket + 1) & m_id_mask;
+            }
+            m_ids[bucket] = entry;
+        }
+    }
+}
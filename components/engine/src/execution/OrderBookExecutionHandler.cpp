@@ -0,0 +1,293 @@
+// src/execution/OrderBookExecutionHandler.cpp
+
+#include "execution/OrderBookExecutionHandler.h"
+#include "checkpoint/Checkpoint.h"
+#include "core/Portfolio.h"
+#include "logging/Logger.h"
+#include "results/ResultsStore.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+
+OrderBookExecutionHandler::OrderBookExecutionHandler(std::string book_directory, double tick_size, double commission,
+                                                     double max_slippage, double fallback_slippage)
+    : m_book_directory(std::move(book_directory)),
+      m_tick_size(tick_size),
+      m_commission_per_trade(commission),
+      m_max_slippage(max_slippage),
+      m_fallback_slippage(fallback_slippage)
+{
+    if (!(tick_size > 0.0)) {
+        throw std::invalid_argument("OrderBookExecutionHandler needs a positive tick size");
+    }
+}
+
+void OrderBookExecutionHandler::on_market_bar(SymbolId /*symbol*/, const DataBar& bar) {
+    const auto timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        bar.timestamp.time_since_epoch()).count();
+    m_now_ns = std::max(m_now_ns, static_cast<std::uint64_t>(timestamp_ns));
+}
+
+void OrderBookExecutionHandler::save_state(StateWriter& out) const {
+    out.write(m_now_ns);
+    out.write(m_unfilled_shares);
+
+    std::uint64_t depleted = 0;
+    for (const auto& [symbol, book] : m_books) {
+        depleted += book && !book->consumed.empty();
+    }
+    out.write(depleted);
+    for (const auto& [symbol, book] : m_books) {
+        if (book && !book->consumed.empty()) {
+            out.write_string(symbol);
+            out.write<std::uint64_t>(book->events.position());
+            out.write_vector(book->consumed);
+        }
+    }
+}
+
+void OrderBookExecutionHandler::restore_state(StateReader& in) {
+    in.read(m_now_ns);
+    in.read(m_unfilled_shares);
+
+    m_books.clear(); // Reopened, and replayed to the restored positions, on first use
+    m_books_by_id.clear();
+    m_resolved_ids.clear();
+    m_restored_books.clear();
+    const auto depleted = in.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < depleted; ++i) {
+        const std::string symbol = in.read_string();
+        RestoredBook& restored = m_restored_books[symbol];
+        in.read(restored.position);
+        in.read_vector(restored.consumed);
+    }
+}
+
+OrderBookExecutionHandler::SymbolBook* OrderBookExecutionHandler::open_book(const std::string& symbol) {
+    auto it = m_books.find(symbol);
+    if (it == m_books.end()) {
+        const std::filesystem::path path = std::filesystem::path(m_book_directory) / (symbol + ".book");
+        std::unique_ptr<SymbolBook> book;
+        if (std::filesystem::exists(path)) {
+            book = std::make_unique<SymbolBook>(path.string());
+            LOG_INFO("OrderBookExecution", "Replaying {} book events for {}", book->events.size(), symbol);
+
+            auto restored = m_restored_books.find(symbol);
+            if (restored != m_restored_books.end()) {
+                // Back to where the checkpoint left the book, with the liquidity our fills had taken
+                const std::uint64_t position = std::min<std::uint64_t>(restored->second.position, book->events.size());
+                if (position > 0) {
+                    for (const BookEventRecord& event :
+                         book->events.next_until(book->events.records()[position - 1].timestamp_epoch_ns)) {
+                        if (!book->book.apply(event)) {
+                            ++m_rejected_events;
+                        }
+                        ++m_replayed_events;
+                    }
+                }
+                book->consumed = std::move(restored->second.consumed);
+                m_restored_books.erase(restored);
+            }
+        } else {
+            LOG_WARN("OrderBookExecution", "WARNING: No order book for {}; filling at the latest price.", symbol);
+        }
+        it = m_books.emplace(symbol, std::move(book)).first;
+    }
+    return it->second.get();
+}
+
+void OrderBookExecutionHandler::replay(SymbolBook* book) {
+    if (!book) {
+        return;
+    }
+    for (const BookEventRecord& event : book->events.next_until(m_now_ns)) {
+        if (!book->consumed.empty()) {
+            release_level(*book, event);
+        }
+        if (!book->book.apply(event)) {
+            ++m_rejected_events;
+        }
+        ++m_replayed_events;
+    }
+}
+
+void OrderBookExecutionHandler::release_level(SymbolBook& book, const BookEventRecord& event) {
+    BookSide side = event.side == 0 ? BookSide::Bid : BookSide::Ask;
+    std::int64_t price_ticks = event.price_ticks;
+    switch (event.type) {
+        case BookEventType::Add:
+        case BookEventType::Level:
+            break;
+        case BookEventType::Cancel:
+        case BookEventType::Execute:
+            if (!book.book.order_level(event.order_id, side, price_ticks)) {
+                return; // Rejected by the book as well
+            }
+            break;
+        case BookEventType::Clear:
+            book.consumed.clear();
+            return;
+    }
+    std::erase_if(book.consumed, [&](const ConsumedLevel& level) {
+        return level.side == side && level.price_ticks == price_ticks;
+    });
+}
+
+OrderBookExecutionHandler::ConsumedLevel* OrderBookExecutionHandler::find_consumed(SymbolBook& book, BookSide side,
+                                                                                  std::int64_t price_ticks) {
+    for (ConsumedLevel& level : book.consumed) {
+        if (level.side == side && level.price_ticks == price_ticks) {
+            return &level;
+        }
+    }
+    return nullptr;
+}
+
+OrderBookExecutionHandler::Fill OrderBookExecutionHandler::fill(SymbolBook* book, long long shares_to_trade,
+                                                               double latest_price) {
+    const bool buy = shares_to_trade > 0;
+    const long long wanted = std::abs(shares_to_trade);
+    Fill result;
+
+    if (!book) {
+        const double price = latest_price * (buy ? 1.0 + m_fallback_slippage : 1.0 - m_fallback_slippage);
+        result.shares = shares_to_trade;
+        result.cash_delta = (buy ? -1.0 : 1.0) * static_cast<double>(wanted) * price - m_commission_per_trade;
+        result.price = price;
+        return result;
+    }
+
+    // Immediate-or-cancel: cross levels up to the limit, leave the rest
+    const double limit_price = latest_price * (buy ? 1.0 + m_max_slippage : 1.0 - m_max_slippage);
+    const auto limit_ticks = static_cast<std::int64_t>(buy ? std::floor(limit_price / m_tick_size)
+                                                           : std::ceil(limit_price / m_tick_size));
+    const BookSide side = buy ? BookSide::Ask : BookSide::Bid;
+    long long filled = 0;
+    double notional = 0.0;
+    book->book.for_each_level(side, [&](std::int64_t price_ticks, std::int64_t quantity) {
+        if (buy ? price_ticks > limit_ticks : price_ticks < limit_ticks) {
+            return false;
+        }
+        // Liquidity we already took stays gone until the feed updates the level
+        ConsumedLevel* consumed = find_consumed(*book, side, price_ticks);
+        const long long taken = std::min<long long>(wanted - filled, quantity - (consumed ? consumed->quantity : 0));
+        if (taken <= 0) {
+            return true; // All taken by earlier orders
+        }
+        if (consumed) {
+            consumed->quantity += taken;
+        } else {
+            book->consumed.push_back({price_ticks, taken, side});
+        }
+        filled += taken;
+        notional += static_cast<double>(taken) * static_cast<double>(price_ticks) * m_tick_size;
+        return filled < wanted;
+    });
+
+    m_unfilled_shares += static_cast<std::uint64_t>(wanted - filled);
+    if (filled == 0) {
+        return result; // Nothing within the limit: no trade, no commission
+    }
+    result.shares = buy ? filled : -filled;
+    result.cash_delta = (buy ? -notional : notional) - m_commission_per_trade;
+    result.price = notional / static_cast<double>(filled);
+    return result;
+}
+
+void OrderBookExecutionHandler::execute_trades(
+    Portfolio& portfolio,
+    const std::map<std::string, double>& approved_target,
+    const std::map<std::string, double>& latest_prices
+) {
+    // Get the total market value of the portfolio before any trades
+    double total_value = portfolio.get_total_value();
+
+    // Establish the universe of assets to consider
+    std::set<std::string> asset_universe;
+    for (const auto& pair : portfolio.get_holdings()) {
+        asset_universe.insert(pair.first);
+    }
+    for (const auto& pair : approved_target) {
+        asset_universe.insert(pair.first);
+    }
+
+    for (const std::string& symbol : asset_universe) {
+        auto price_it = latest_prices.find(symbol);
+        if (price_it == latest_prices.end() || price_it->second <= 0.0) {
+            continue; // Cannot trade without a price
+        }
+        const double latest_price = price_it->second;
+
+        auto target_it = approved_target.find(symbol);
+        const double target_weight = target_it != approved_target.end() ? target_it->second : 0.0;
+        const long long target_shares = static_cast<long long>(std::round(total_value * target_weight / latest_price));
+        const long long shares_to_trade = target_shares - portfolio.get_position(symbol);
+        if (shares_to_trade == 0) {
+            continue; // No trade needed
+        }
+
+        SymbolBook* book = open_book(symbol);
+        replay(book);
+        const Fill result = fill(book, shares_to_trade, latest_price);
+        if (result.shares != 0) {
+            portfolio.update_holding(symbol, result.shares);
+            portfolio.update_cash(result.cash_delta);
+            if (m_results) {
+                m_results->record_fill(portfolio.registry()->find(symbol), result.shares, result.price,
+                                       m_commission_per_trade);
+            }
+        }
+    }
+}
+
+void OrderBookExecutionHandler::execute_target_weights(
+    Portfolio& portfolio,
+    const SymbolRegistry& registry,
+    const WeightVector& approved_weights,
+    const PriceVector& latest_prices
+) {
+    // Get the total market value of the portfolio before any trades
+    double total_value = portfolio.get_total_value();
+
+    const std::size_t universe = std::min(registry.size(), latest_prices.size());
+    if (m_books_by_id.size() < universe) {
+        m_books_by_id.resize(universe, nullptr);
+        m_resolved_ids.resize(universe, false);
+    }
+
+    // Only held or targeted assets can produce a trade
+    portfolio.tradable_ids(approved_weights, m_trade_ids);
+    for (SymbolId id : m_trade_ids) {
+        if (id >= universe || latest_prices[id] <= 0.0) {
+            continue; // Cannot trade without a price
+        }
+        const double latest_price = latest_prices[id];
+
+        const double target_weight = id < approved_weights.size() ? approved_weights[id] : 0.0;
+        const long long current_shares = portfolio.get_position(id);
+
+        const long long target_shares = static_cast<long long>(std::round(total_value * target_weight / latest_price));
+        const long long shares_to_trade = target_shares - current_shares;
+        if (shares_to_trade == 0) {
+            continue; // No trade needed
+        }
+
+        if (!m_resolved_ids[id]) {
+            m_books_by_id[id] = open_book(registry.name(id));
+            m_resolved_ids[id] = true;
+        }
+        SymbolBook* book = m_books_by_id[id];
+        replay(book);
+
+        const Fill result = fill(book, shares_to_trade, latest_price);
+        if (result.shares != 0) {
+            portfolio.update_holding(id, result.shares);
+            portfolio.update_cash(result.cash_delta);
+            if (m_results) {
+                m_results->record_fill(id, result.shares, result.price, m_commission_per_trade);
+            }
+        }
+    }
+}
@@ -0,0 +1,244 @@
+// src/logging/Logger.cpp
+
+#include "logging/Logger.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace logging {
+
+    LogRing::LogRing(std::size_t capacity)
+        : m_capacity(capacity),
+          m_mask(capacity - 1),
+          m_buffer(std::make_unique<std::byte[]>(capacity))
+    {
+        if (capacity < 64 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("LogRing capacity must be a power of two of at least 64 bytes");
+        }
+    }
+
+    const std::byte* LogRing::peek() {
+        while (true) {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            const std::size_t offset = tail & m_mask;
+            std::uint32_t size;
+            std::memcpy(&size, m_buffer.get() + offset, sizeof(size));
+            if (size != 0) {
+                return m_buffer.get() + offset;
+            }
+            m_tail.store(tail + (m_capacity - offset), std::memory_order_release); // Wrap marker
+        }
+    }
+
+    void LogRing::release(std::size_t size) {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    }
+
+    Logger& Logger::instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger::Logger()
+        : m_start_ns(now_ns()),
+          m_thread(&Logger::run, this) {}
+
+    Logger::~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_thread.join(); // The logger thread drains every ring before it exits
+
+        if (const std::uint64_t dropped = dropped_records()) {
+            std::fprintf(m_err, "[Logger] WARNING: %llu records were dropped because a log ring was full.\n",
+                         static_cast<unsigned long long>(dropped));
+        }
+    }
+
+    void Logger::set_output(std::FILE* out, std::FILE* err) {
+        flush(); // Earlier records still go to the old streams
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_out = out;
+        m_err = err;
+    }
+
+    void Logger::flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const std::uint64_t ticket = ++m_flush_requested;
+        m_wake.notify_one();
+        m_flushed.wait(lock, [&] { return m_flush_completed >= ticket; });
+    }
+
+    LogRing& Logger::thread_ring() {
+        // Owned jointly with the logger, so records survive their thread
+        struct RingHandle {
+            std::shared_ptr<LogRing> ring;
+            ~RingHandle() {
+                if (ring) {
+                    ring->retired.store(true, std::memory_order_release);
+                }
+            }
+        };
+        thread_local RingHandle handle;
+
+        if (!handle.ring) {
+            handle.ring = std::make_shared<LogRing>(kRingCapacity);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_rings.push_back(handle.ring);
+        }
+        return *handle.ring;
+    }
+
+    void Logger::run() {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        std::string out;
+        std::string err;
+
+        while (true) {
+            std::uint64_t flush_ticket;
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                flush_ticket = m_flush_requested;
+                stop = m_stop;
+                rings = m_rings;
+            }
+
+            // Drain until every ring is empty, so a flush sees all earlier records
+            bool any = false;
+            while (true) {
+                bool progress = false;
+                for (const auto& ring : rings) {
+                    while (const std::byte* record = ring->peek()) {
+                        RecordHeader header;
+                        std::memcpy(&header, record, sizeof(header));
+                        format_record(record, header.level >= Level::Warn ? err : out);
+                        ring->release(header.size);
+                        progress = true;
+                    }
+                }
+                if (!progress) {
+                    break;
+                }
+                any = true;
+            }
+
+            std::FILE* out_stream;
+            std::FILE* err_stream;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                out_stream = m_out;
+                err_stream = m_err;
+            }
+            if (!out.empty()) {
+                std::fwrite(out.data(), 1, out.size(), out_stream);
+                std::fflush(out_stream);
+                out.clear();
+            }
+            if (!err.empty()) {
+                std::fwrite(err.data(), 1, err.size(), err_stream);
+                std::fflush(err_stream);
+                err.clear();
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // Drop rings whose thread has exited and which are now empty
+            std::erase_if(m_rings, [](const std::shared_ptr<LogRing>& ring) {
+                return ring->retired.load(std::memory_order_acquire) && !ring->peek();
+            });
+            if (flush_ticket > m_flush_completed) {
+                m_flush_completed = flush_ticket;
+                m_flushed.notify_all();
+            }
+            if (stop) {
+                return;
+            }
+            if (!any && m_flush_requested == flush_ticket && !m_stop) {
+                m_wake.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    namespace {
+        void append_arg(const std::byte*& cursor, std::string& line) {
+            ArgType type;
+            std::memcpy(&type, cursor, 1);
+            cursor += 1;
+
+            char text[32];
+            switch (type) {
+                case ArgType::Int: {
+                    std::int64_t value;
+                    std::memcpy(&value, cursor, sizeof(value));
+                    cursor += sizeof(value);
+                    line.append(text, std::to_chars(text, text + sizeof(text), value).ptr);
+                    break;
+                }
+                case ArgType::UInt: {
+                    std::uint64_t value;
+                    std::memcpy(&value, cursor, sizeof(value));
+                    cursor += sizeof(value);
+                    line.append(text, std::to_chars(text, text + sizeof(text), value).ptr);
+                    break;
+                }
+                case ArgType::Double: {
+                    double value;
+                    std::memcpy(&value, cursor, sizeof(value));
+                    cursor += sizeof(value);
+                    const int length = std::snprintf(text, sizeof(text), "%g", value); // Matches iostream defaults
+                    line.append(text, static_cast<std::size_t>(length));
+                    break;
+                }
+                case ArgType::Bool: {
+                    std::uint64_t value;
+                    std::memcpy(&value, cursor, sizeof(value));
+                    cursor += sizeof(value);
+                    line += value ? "true" : "false";
+                    break;
+                }
+                case ArgType::String: {
+                    std::uint32_t length;
+                    std::memcpy(&length, cursor, sizeof(length));
+                    cursor += sizeof(length);
+                    line.append(reinterpret_cast<const char*>(cursor), length);
+                    cursor += length;
+                    break;
+                }
+            }
+        }
+    }
+
+    void Logger::format_record(const std::byte* record, std::string& line) const {
+        RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+        const std::byte* cursor = record + sizeof(header);
+
+        char prefix[32];
+        const double seconds = static_cast<double>(header.timestamp_ns - m_start_ns) * 1e-9;
+        const int length = std::snprintf(prefix, sizeof(prefix), "%12.6f ", seconds);
+        line.append(prefix, static_cast<std::size_t>(length));
+        if (header.tag && *header.tag) {
+            line += '[';
+            line += header.tag;
+            line += "] ";
+        }
+
+        // Substitute the arguments into the `{}` placeholders, in order
+        std::size_t args_left = header.arg_count;
+        for (const char* p = header.format; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}' && args_left > 0) {
+                append_arg(cursor, line);
+                --args_left;
+                ++p;
+            } else {
+                line += *p;
+            }
+        }
+        line += '\n';
+    }
+
+} // namespace logging
@@ -2,24 +2,71 @@
 
 #include "EventLoop.h"
 #include "core/Portfolio.h"
-#include "data/BinFileReader.h"
+#include "core/CpuAffinity.h"
+#include "data/MergedBarProvider.h"
+#include "data/ZmqBarSubscriber.h"
 #include "signals/AggregatedIPCSource.h"
+#include "signals/CachedSignalSource.h"
+#include "signals/PipelinedIPCSource.h"
 #include "risk/PortfolioRiskManager.h"
 #include "execution/BacktestExecutionHandler.h"
+#include "execution/OrderBookExecutionHandler.h"
+#include "data/InMemoryBarProvider.h"
+#include "sweep/ParameterSweep.h"
+#include "results/ResultsStore.h"
+#include "logging/Logger.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <memory>
 
-int main() {
+// Usage: engine [--checkpoint engine.ckpt [--resume]] [--metrics metrics.json] [--refresh-signals]
+//                                                 -- one backtest with the parameters below;
+//                                                    --checkpoint saves its state to that file,
+//                                                    --resume continues from the last checkpoint there,
+//                                                    --refresh-signals discards the signal cache
+//        engine --live [--metrics metrics.json]   -- the same components on the live feed below
+//        engine --sweep grid.json [out.csv] [--refresh-signals]
+//                                                 -- one backtest per point of the grid
+// Every mode also takes --results results.db, which records fills and equity curves into that
+// SQLite database, and --target-volatility X (annualized, eg 0.15) and --max-var X (one-bar
+// 99% VaR as a fraction of equity, eg 0.03), the portfolio volatility rules; both are off by default.
+// Options may come in any order.
+int main(int argc, char* argv[]) {
     // --- 1. Configuration ---
     // This section would is be loaded from a config file (eg JSON)
     const double initial_cash = 100000.0;
-    const std::string data_file_path = "../../data/AAPL_data.bin";
+    const std::string data_directory = "../../data"; // One .bin record or .cbar file per symbol
+    const TimeRange backtest_window{};                // Every bar; eg TimeRange::between(start, end) for a window
+    std::string results_db;                           // Fills and equity curves of every run (--results); empty disables it
+    std::string checkpoint_path;                      // Latest state of the backtest (--checkpoint); empty disables it
+    const std::uint64_t checkpoint_every_bars = 100000;
+    const bool pipelined_stages = false;              // Decode, signals and risk/execution on three threads; no checkpoints
+    const std::size_t pipeline_queue_capacity = 1024; // Bars buffered between two stages
+
+    // Live mode: bars from a ZeroMQ PUB feed (eg bar_replay serving the data directory)
+    const std::string live_feed_endpoint = "tcp://localhost:5560";
+    LiveFeedOptions live_feed_options;
+    live_feed_options.wait_policy = FeedWaitPolicy::SpinThenBlock; // BusyPoll on an isolated core
+    live_feed_options.spin_time = std::chrono::microseconds(200);
+    const int live_engine_cpu = -1;                   // Pin the engine thread to this CPU; -1 leaves it unpinned
 
     // IPC configuration for Python models
     const std::vector<std::string> model_endpoints = {"tcp://localhost:5555", "tcp://localhost:5556"};
     const std::chrono::milliseconds reply_timeout(100); // 100ms timeout
+    const std::size_t max_bars_in_flight = 8;           // Requests outstanding per model
+    const std::size_t batched_bars = 0;                 // Backtests: > 0 sends models that declare themselves
+                                                        // causal this many bars per request (AggregatedIPCSource)
+    const std::string aggregation_method = "mean";      // "mean", "median" or "trimmed_mean"
+    const double aggregation_trim_fraction = 0.1;       // Per side, for "trimmed_mean"
+
+    // Replies of deterministic models, recorded so that backtests of the same data skip the
+    // models, eg while tuning risk parameters. Not used live.
+    const std::string signal_cache_path = "";           // eg "signals.cache"; empty disables it
+    const std::string model_version = "1";              // Change with the models: older replies are then not served
 
     // Risk and Execution parameters
     const double max_position_weight = 0.25;
@@ -27,21 +74,184 @@ int main() {
     const double max_drawdown = 0.20;
     const double commission_per_trade = 1.00;
     const double slippage_percentage = 0.0005; // 0.05% slippage
+    const std::string book_directory = data_directory + "/book"; // Optional <SYMBOL>.book replay files
+    const double tick_size = 0.01;
+    const double max_order_slippage = 0.005;   // Limit of each IOC order against the book
+
+    // Portfolio volatility rules, on an EWMA covariance of per-bar returns. Off unless
+    // --target-volatility or --max-var is given.
+    VolatilityLimits volatility_limits;
 
     // --- 2. Component Assembly (Dependency Injection) ---
-    auto portfolio = std::make_unique<Portfolio>(initial_cash);
+    // Symbols are interned once, while the data files are opened
+    auto symbol_registry = std::make_shared<SymbolRegistry>();
+
+    // Flags may come in any order and take their value with them; what is left is positional
+    bool refresh_signals = false;
+    bool resume = false;
+    bool live = false;
+    std::string sweep_grid;
+    std::string metrics_path;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (argument == "--refresh-signals") {
+            refresh_signals = true;
+        } else if (argument == "--resume") {
+            resume = true;
+        } else if (argument == "--live") {
+            live = true;
+        } else if (argument == "--sweep" && has_value) {
+            sweep_grid = argv[++i];
+        } else if (argument == "--target-volatility" && has_value) {
+            volatility_limits.target_volatility = std::strtod(argv[++i], nullptr);
+        } else if (argument == "--max-var" && has_value) {
+            volatility_limits.max_value_at_risk = std::strtod(argv[++i], nullptr);
+        } else if (argument == "--results" && has_value) {
+            results_db = argv[++i];
+        } else if (argument == "--metrics" && has_value) {
+            metrics_path = argv[++i];
+        } else if (argument == "--checkpoint" && has_value) {
+            checkpoint_path = argv[++i];
+        } else if (argument.starts_with("--")) {
+            LOG_ERROR("", "Unknown option, or one missing its value: {}", argument);
+            return 1;
+        } else {
+            positional.push_back(argument);
+        }
+    }
+    // The sweep's output file is the only positional argument
+    if (positional.size() > (sweep_grid.empty() ? 0u : 1u)) {
+        LOG_ERROR("", "Unexpected argument: {}", positional.back());
+        return 1;
+    }
+    if (resume && checkpoint_path.empty()) {
+        LOG_ERROR("", "--resume needs the checkpoint file: --checkpoint <file> --resume");
+        return 1;
+    }
+
+    // Live bars are always sent one at a time: a batch would wait for bars that have not happened yet
+    auto make_model_source = [&](bool backtest) -> std::unique_ptr<ISignalSource> {
+        auto aggregator = make_signal_aggregator(aggregation_method, aggregation_trim_fraction);
+        if (backtest && batched_bars > 0) {
+            return std::make_unique<AggregatedIPCSource>(model_endpoints, reply_timeout, batched_bars,
+                                                         std::move(aggregator));
+        }
+        return std::make_unique<PipelinedIPCSource>(model_endpoints, reply_timeout, max_bars_in_flight,
+                                                    std::move(aggregator));
+    };
+    // Replies are keyed on everything that shapes them: the models and how they are combined
+    auto open_signal_cache = [&]() -> std::shared_ptr<SignalReplyCache> {
+        if (signal_cache_path.empty()) {
+            return nullptr;
+        }
+        std::string model_key = "version " + model_version + "; " + aggregation_method + " " +
+                                std::to_string(aggregation_trim_fraction);
+        for (const auto& endpoint : model_endpoints) {
+            model_key += "; " + endpoint;
+        }
+        return std::make_shared<SignalReplyCache>(signal_cache_path, model_key,
+            refresh_signals ? SignalCacheMode::Invalidate : SignalCacheMode::ReadWrite);
+    };
+    auto log_signal_cache = [](const std::shared_ptr<SignalReplyCache>& cache) {
+        if (cache) {
+            cache->flush();
+            LOG_INFO("SignalCache", "{} bars served from the signal cache, {} sent to the models.",
+                     cache->hits(), cache->misses());
+        }
+    };
+
+    if (!sweep_grid.empty()) {
+        try {
+            std::ifstream grid_file(sweep_grid);
+            if (!grid_file) {
+                throw std::runtime_error("Cannot open sweep grid " + sweep_grid);
+            }
+            const SweepParameters defaults{max_position_weight, max_leverage, max_drawdown,
+                                           commission_per_trade, slippage_percentage,
+                                           volatility_limits.target_volatility};
+            const auto parameter_sets = ParameterGrid::from_json(nlohmann::json::parse(grid_file), defaults).expand();
+
+            // The market data is read once and shared read-only by every run
+            MergedBarProvider loader(data_directory, 4096, symbol_registry, backtest_window);
+            SharedBarStore bars = InMemoryBarProvider::load_all(loader, symbol_registry.get());
+            LOG_INFO("Sweep", "Loaded {} bars; running {} configurations.", bars->size(), parameter_sets.size());
 
-    auto data_provider = std::make_unique<BinFileReader>(data_file_path);
+            // One cache for every run: each configuration replays the same bars
+            const auto signal_cache = open_signal_cache();
+            ParameterSweep sweep(bars, symbol_registry, initial_cash, [&]() -> std::unique_ptr<ISignalSource> {
+                auto models = make_model_source(true);
+                if (!signal_cache) {
+                    return models;
+                }
+                return std::make_unique<CachedSignalSource>(std::move(models), signal_cache);
+            });
 
-    auto signal_source = std::make_unique<AggregatedIPCSource>(model_endpoints, reply_timeout);
+            std::ofstream csv_file;
+            if (!positional.empty()) {
+                csv_file.open(positional.front());
+                if (!csv_file) {
+                    throw std::runtime_error("Cannot open sweep output " + positional.front());
+                }
+            }
+            std::ostream& out = positional.empty() ? std::cout : csv_file;
+            std::shared_ptr<ResultsStore> results;
+            if (!results_db.empty()) {
+                results = std::make_shared<ResultsStore>(results_db);
+                sweep.set_results_store(results);
+            }
+
+            ParameterSweep::write_csv_header(out);
+            sweep.run(parameter_sets, [&](const SweepResult& result) {
+                ParameterSweep::write_csv_row(out, result);
+            });
+            log_signal_cache(signal_cache);
+        } catch (const std::exception& e) {
+            LOG_ERROR("", "An unhandled exception occurred: {}", e.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    std::unique_ptr<IDataProvider> data_provider;
+    try {
+        if (live) {
+            data_provider = std::make_unique<ZmqBarSubscriber>(live_feed_endpoint, symbol_registry, live_feed_options);
+        } else {
+            data_provider = std::make_unique<MergedBarProvider>(data_directory, 4096, symbol_registry, backtest_window);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("", "Cannot open the market data: {}", e.what());
+        return 1;
+    }
+
+    auto portfolio = std::make_unique<Portfolio>(initial_cash, symbol_registry);
+
+    std::unique_ptr<ISignalSource> signal_source = make_model_source(!live);
+    std::shared_ptr<SignalReplyCache> signal_cache;
+    if (!live) {
+        signal_cache = open_signal_cache();
+        if (signal_cache) {
+            signal_source = std::make_unique<CachedSignalSource>(std::move(signal_source), signal_cache);
+        }
+    }
 
     auto risk_manager = std::make_unique<PortfolioRiskManager>(
-        max_position_weight, max_leverage, max_drawdown
+        max_position_weight, max_leverage, max_drawdown, volatility_limits
     );
 
-    auto execution_handler = std::make_unique<BacktestExecutionHandler>(
-        commission_per_trade, slippage_percentage
-    );
+    // Fill against replayed order books when there are any, otherwise at the bar price
+    std::unique_ptr<IExecutionHandler> execution_handler;
+    if (std::filesystem::is_directory(book_directory)) {
+        execution_handler = std::make_unique<OrderBookExecutionHandler>(
+            book_directory, tick_size, commission_per_trade, max_order_slippage, slippage_percentage
+        );
+    } else {
+        execution_handler = std::make_unique<BacktestExecutionHandler>(
+            commission_per_trade, slippage_percentage
+        );
+    }
 
     // --- 3. Create and Run the Event Loop ---
     // We pass ownership of all our components to the EventLoop
@@ -54,12 +264,38 @@ int main() {
     );
 
     try {
-        event_loop.run_backtest();
+        if (resume) {
+            event_loop.restore_checkpoint(checkpoint_path);
+        }
+        if (!checkpoint_path.empty() && !live && !pipelined_stages) {
+            event_loop.enable_checkpoints(checkpoint_path, checkpoint_every_bars);
+        }
+        std::unique_ptr<ResultsStore> results;
+        if (!results_db.empty()) {
+            // A resumed backtest is recorded as a new run, from the checkpoint on
+            results = std::make_unique<ResultsStore>(results_db);
+            event_loop.set_results_recorder(
+                results->begin_run(live ? "live" : resume ? "backtest (resumed)" : "backtest"));
+        }
+        if (live) {
+            if (live_engine_cpu >= 0) {
+                pin_current_thread(live_engine_cpu);
+            }
+            event_loop.run_live(); // Reports tick-to-decision latency percentiles at the end
+        } else if (pipelined_stages) {
+            event_loop.run_pipelined_backtest(pipeline_queue_capacity); // Same results, stages overlapped
+        } else {
+            event_loop.run_backtest();
+        }
+        log_signal_cache(signal_cache);
+        if (!metrics_path.empty()) {
+            event_loop.write_metrics_json(metrics_path); // Stage and per-model latency histograms
+        }
     } catch (const std::exception& e) {
-        std::cerr << "An unhandled exception occurred: " << e.what() << std::endl;
+        LOG_ERROR("", "An unhandled exception occurred: {}", e.what());
         return 1;
     } catch (...) {
-        std::cerr << "An unknown exception occurred." << std::endl;
+        LOG_ERROR("", "An unknown exception occurred.");
         return 1;
     }
 
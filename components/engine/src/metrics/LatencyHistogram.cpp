@@ -0,0 +1,41 @@
+// src/metrics/LatencyHistogram.cpp
+
+#include "metrics/LatencyHistogram.h"
+#include <cmath>
+
+std::uint64_t LatencyHistogram::bucket_value(std::size_t index) {
+    if (index < kExactLimit) {
+        return index;
+    }
+    const std::size_t offset = index - kExactLimit;
+    const unsigned shift = static_cast<unsigned>(offset / kSubBuckets) + 1;
+    const std::uint64_t lower = (kSubBuckets + offset % kSubBuckets) << shift;
+    return lower + ((1ull << shift) >> 1);
+}
+
+std::uint64_t LatencyHistogram::percentile(double quantile) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(quantile * m_count)));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::clamp(bucket_value(i), min(), m_max); // Never outside the observed range
+        }
+    }
+    return m_max;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
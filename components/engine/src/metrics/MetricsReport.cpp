@@ -0,0 +1,59 @@
+// src/metrics/MetricsReport.cpp
+
+#include "metrics/MetricsReport.h"
+#include "logging/Logger.h"
+
+LatencyHistogram& MetricsReport::histogram(std::string_view name) {
+    for (auto& entry : m_histograms) {
+        if (entry.name == name) {
+            return entry.histogram;
+        }
+    }
+    return m_histograms.emplace_back(NamedHistogram{std::string(name), {}}).histogram;
+}
+
+std::uint64_t& MetricsReport::counter(std::string_view name) {
+    for (auto& entry : m_counters) {
+        if (entry.name == name) {
+            return entry.value;
+        }
+    }
+    return m_counters.emplace_back(NamedCounter{std::string(name), 0}).value;
+}
+
+void MetricsReport::log_summary() const {
+    LOG_INFO("Metrics", "--- {} (latencies in us) ---", m_title);
+    for (const auto& [name, histogram] : m_histograms) {
+        if (histogram.count() == 0) {
+            continue;
+        }
+        LOG_INFO("Metrics", "{}: n={} mean={} p50={} p99={} p99.9={} max={}",
+                 name, histogram.count(), histogram.mean() * 1e-3,
+                 histogram.percentile(0.50) * 1e-3, histogram.percentile(0.99) * 1e-3,
+                 histogram.percentile(0.999) * 1e-3, histogram.max() * 1e-3);
+    }
+    for (const auto& [name, value] : m_counters) {
+        LOG_INFO("Metrics", "{}: {}", name, value);
+    }
+}
+
+nlohmann::json MetricsReport::to_json() const {
+    nlohmann::json histograms = nlohmann::json::object();
+    for (const auto& [name, histogram] : m_histograms) {
+        histograms[name] = {
+            {"count", histogram.count()},
+            {"mean_ns", histogram.mean()},
+            {"min_ns", histogram.min()},
+            {"p50_ns", histogram.percentile(0.50)},
+            {"p99_ns", histogram.percentile(0.99)},
+            {"p999_ns", histogram.percentile(0.999)},
+            {"max_ns", histogram.max()}
+        };
+    }
+
+    nlohmann::json counters = nlohmann::json::object();
+    for (const auto& [name, value] : m_counters) {
+        counters[name] = value;
+    }
+    return {{"histograms", histograms}, {"counters", counters}};
+}
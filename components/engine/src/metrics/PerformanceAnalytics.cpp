@@ -0,0 +1,208 @@
+// src/metrics/PerformanceAnalytics.cpp
+
+#include "metrics/PerformanceAnalytics.h"
+#include "checkpoint/Checkpoint.h"
+#include "core/Portfolio.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double kSecondsPerYear = 365.25 * 24 * 3600;
+    constexpr double kNanosPerSecond = 1e9;
+
+    std::int64_t to_ns(std::chrono::system_clock::time_point timestamp) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+    }
+}
+
+PerformanceAnalytics::PerformanceAnalytics(double initial_equity, double periods_per_year)
+    : m_initial_equity(initial_equity),
+      m_periods_per_year(periods_per_year),
+      m_peak(initial_equity),
+      m_previous_equity(initial_equity),
+      m_running_peak(initial_equity)
+{}
+
+void PerformanceAnalytics::on_bar(std::chrono::system_clock::time_point timestamp, const Portfolio& portfolio,
+                                  double peak_equity) {
+    const std::int64_t timestamp_ns = to_ns(timestamp);
+    if (m_has_open_period && timestamp_ns != m_period_ns) {
+        close_period();
+    }
+    m_has_open_period = true;
+    m_period_ns = timestamp_ns;
+    m_equity = portfolio.get_total_value();
+    m_peak = peak_equity;
+    m_gross_exposure = portfolio.get_gross_exposure();
+    m_market_value = portfolio.get_market_value();
+    m_fills = portfolio.get_fill_count();
+    m_traded_notional = portfolio.get_traded_notional();
+}
+
+void PerformanceAnalytics::close_period() {
+    m_has_open_period = false;
+    if (m_periods == 0) {
+        m_first_period_ns = m_period_ns;
+        m_drawdown_start_ns = m_period_ns;
+    }
+    ++m_periods;
+
+    // Return moments (Welford) and the downside
+    const double period_return = m_previous_equity != 0.0 ? m_equity / m_previous_equity - 1.0 : 0.0;
+    const double delta = period_return - m_mean;
+    m_mean += delta / static_cast<double>(m_periods);
+    m_m2 += delta * (period_return - m_mean);
+    if (period_return < 0.0) {
+        m_downside_sum_squares += period_return * period_return;
+    }
+    m_best_return = m_periods == 1 ? period_return : std::max(m_best_return, period_return);
+    m_worst_return = m_periods == 1 ? period_return : std::min(m_worst_return, period_return);
+    m_previous_equity = m_equity;
+    m_equity_sum += m_equity;
+
+    // Drawdown against the risk manager's peak; a stretch lasts until a new high
+    const double peak = std::max({m_peak, m_equity, m_running_peak});
+    if (peak > m_running_peak || m_equity >= peak) {
+        m_running_peak = peak;
+        m_drawdown_periods = 0;
+        m_drawdown_start_ns = m_period_ns;
+    } else {
+        ++m_drawdown_periods;
+        if (m_drawdown_periods > m_max_drawdown_periods) {
+            m_max_drawdown_periods = m_drawdown_periods;
+            m_max_drawdown_ns = m_period_ns - m_drawdown_start_ns;
+        }
+    }
+    if (peak > 0.0) {
+        m_max_drawdown = std::max(m_max_drawdown, 1.0 - m_equity / peak);
+    }
+
+    // Exposure and trading
+    if (m_equity > 0.0) {
+        const double gross = m_gross_exposure / m_equity;
+        m_gross_exposure_sum += gross;
+        m_max_gross_exposure = std::max(m_max_gross_exposure, gross);
+        m_net_exposure_sum += m_market_value / m_equity;
+    }
+    if (m_gross_exposure > 0.0) {
+        ++m_invested_periods;
+    }
+    if (m_fills != m_previous_fills) {
+        ++m_periods_with_fills;
+        m_previous_fills = m_fills;
+    }
+}
+
+const PerformanceSummary& PerformanceAnalytics::finish() {
+    if (m_has_open_period) {
+        close_period();
+    }
+
+    PerformanceSummary& s = m_summary;
+    s = PerformanceSummary{};
+    s.periods = m_periods;
+    s.initial_equity = m_initial_equity;
+    s.final_equity = m_periods > 0 ? m_previous_equity : m_initial_equity;
+    s.total_return = m_initial_equity != 0.0 ? s.final_equity / m_initial_equity - 1.0 : 0.0;
+    if (m_periods == 0) {
+        return s;
+    }
+
+    const double periods = static_cast<double>(m_periods);
+    s.periods_per_year = m_periods_per_year;
+    const double elapsed_seconds = static_cast<double>(m_period_ns - m_first_period_ns) / kNanosPerSecond;
+    if (s.periods_per_year == 0.0 && m_periods > 1 && elapsed_seconds > 0.0) {
+        s.periods_per_year = (periods - 1.0) / (elapsed_seconds / kSecondsPerYear);
+    }
+    const double annualization = s.periods_per_year > 0.0 ? std::sqrt(s.periods_per_year) : 1.0;
+
+    s.mean_return = m_mean;
+    s.return_volatility = m_periods > 1 ? std::sqrt(m_m2 / (periods - 1.0)) : 0.0;
+    s.downside_deviation = std::sqrt(m_downside_sum_squares / periods);
+    s.best_return = m_best_return;
+    s.worst_return = m_worst_return;
+    s.sharpe_ratio = s.return_volatility > 0.0 ? m_mean / s.return_volatility * annualization : 0.0;
+    s.sortino_ratio = s.downside_deviation > 0.0 ? m_mean / s.downside_deviation * annualization : 0.0;
+
+    s.max_drawdown = m_max_drawdown;
+    s.max_drawdown_periods = m_max_drawdown_periods;
+    s.max_drawdown_seconds = static_cast<double>(m_max_drawdown_ns) / kNanosPerSecond;
+
+    s.average_gross_exposure = m_gross_exposure_sum / periods;
+    s.max_gross_exposure = m_max_gross_exposure;
+    s.average_net_exposure = m_net_exposure_sum / periods;
+    s.time_in_market = static_cast<double>(m_invested_periods) / periods;
+
+    s.fills = m_fills;
+    s.periods_with_fills = m_periods_with_fills;
+    s.traded_notional = m_traded_notional;
+    const double average_equity = m_equity_sum / periods;
+    s.turnover = average_equity > 0.0 ? m_traded_notional / average_equity : 0.0;
+    s.annual_turnover = s.periods_per_year > 0.0 ? s.turnover * s.periods_per_year / periods : 0.0;
+    return s;
+}
+
+template <typename Self, typename Visit>
+void PerformanceAnalytics::visit_state(Self& self, Visit&& visit) {
+    visit(self.m_initial_equity, self.m_periods_per_year,
+          self.m_has_open_period, self.m_period_ns, self.m_equity, self.m_peak, self.m_gross_exposure,
+          self.m_market_value, self.m_fills, self.m_traded_notional,
+          self.m_periods, self.m_first_period_ns, self.m_previous_equity, self.m_previous_fills,
+          self.m_mean, self.m_m2, self.m_downside_sum_squares, self.m_best_return, self.m_worst_return,
+          self.m_equity_sum, self.m_running_peak, self.m_max_drawdown, self.m_drawdown_periods,
+          self.m_drawdown_start_ns, self.m_max_drawdown_periods, self.m_max_drawdown_ns,
+          self.m_gross_exposure_sum, self.m_max_gross_exposure, self.m_net_exposure_sum,
+          self.m_invested_periods, self.m_periods_with_fills);
+}
+
+void PerformanceAnalytics::save_state(StateWriter& writer) const {
+    visit_state(*this, [&](const auto&... fields) { (writer.write(fields), ...); });
+}
+
+void PerformanceAnalytics::restore_state(StateReader& reader) {
+    visit_state(*this, [&](auto&... fields) { (reader.read(fields), ...); });
+}
+
+void PerformanceSummary::log_summary() const {
+    LOG_INFO("Performance", "--- Performance over {} periods ({} per year) ---", periods, periods_per_year);
+    LOG_INFO("Performance", "Return: total={}% mean={}% volatility={}% best={}% worst={}%",
+             total_return * 100, mean_return * 100, return_volatility * 100, best_return * 100, worst_return * 100);
+    LOG_INFO("Performance", "Sharpe={} Sortino={}", sharpe_ratio, sortino_ratio);
+    LOG_INFO("Performance", "Max drawdown={}% lasting {} periods ({} days)",
+             max_drawdown * 100, max_drawdown_periods, max_drawdown_seconds / 86400.0);
+    LOG_INFO("Performance", "Exposure: gross avg={}% max={}% net avg={}% in market {}% of periods",
+             average_gross_exposure * 100, max_gross_exposure * 100, average_net_exposure * 100,
+             time_in_market * 100);
+    LOG_INFO("Performance", "Trading: {} fills in {} periods, turnover={}x ({}x per year)",
+             fills, periods_with_fills, turnover, annual_turnover);
+}
+
+nlohmann::json PerformanceSummary::to_json() const {
+    return {
+        {"periods", periods},
+        {"periods_per_year", periods_per_year},
+        {"initial_equity", initial_equity},
+        {"final_equity", final_equity},
+        {"total_return", total_return},
+        {"mean_return", mean_return},
+        {"return_volatility", return_volatility},
+        {"downside_deviation", downside_deviation},
+        {"best_return", best_return},
+        {"worst_return", worst_return},
+        {"sharpe_ratio", sharpe_ratio},
+        {"sortino_ratio", sortino_ratio},
+        {"max_drawdown", max_drawdown},
+        {"max_drawdown_periods", max_drawdown_periods},
+        {"max_drawdown_seconds", max_drawdown_seconds},
+        {"average_gross_exposure", average_gross_exposure},
+        {"max_gross_exposure", max_gross_exposure},
+        {"average_net_exposure", average_net_exposure},
+        {"time_in_market", time_in_market},
+        {"fills", fills},
+        {"periods_with_fills", periods_with_fills},
+        {"traded_notional", traded_notional},
+        {"turnover", turnover},
+        {"annual_turnover", annual_turnover}
+    };
+}
@@ -0,0 +1,336 @@
+// src/results/ResultsStore.cpp
+
+#include "results/ResultsStore.h"
+#include "logging/Logger.h"
+#include <sqlite3.h>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr const char* kSchema =
+        "CREATE TABLE IF NOT EXISTS runs ("
+        "  run_id INTEGER PRIMARY KEY, label TEXT NOT NULL,"
+        "  bars INTEGER, fills INTEGER, final_equity REAL, final_cash REAL, peak_equity REAL);"
+        "CREATE TABLE IF NOT EXISTS symbols ("
+        "  run_id INTEGER NOT NULL, symbol_id INTEGER NOT NULL, name TEXT NOT NULL,"
+        "  PRIMARY KEY (run_id, symbol_id));"
+        "CREATE TABLE IF NOT EXISTS fills ("
+        "  run_id INTEGER NOT NULL, bar_index INTEGER NOT NULL, timestamp_ns INTEGER NOT NULL,"
+        "  symbol_id INTEGER NOT NULL, shares INTEGER NOT NULL, price REAL NOT NULL, commission REAL NOT NULL);"
+        "CREATE TABLE IF NOT EXISTS equity ("
+        "  run_id INTEGER NOT NULL, bar_index INTEGER NOT NULL, timestamp_ns INTEGER NOT NULL,"
+        "  equity REAL NOT NULL, cash REAL NOT NULL, peak REAL NOT NULL);";
+
+    // How long the idle writer sleeps before looking at the rings again.
+    constexpr auto kIdleWait = std::chrono::milliseconds(2);
+
+    std::int64_t as_int64(std::uint64_t value) { return static_cast<std::int64_t>(value); }
+}
+
+// --- ResultsRecorder ---
+
+ResultsRecorder::ResultsRecorder(std::uint32_t run_id, std::string label, std::size_t capacity)
+    : m_run_id(run_id), m_label(std::move(label)), m_rows(capacity) {}
+
+void ResultsRecorder::begin_bar(std::chrono::system_clock::time_point timestamp) {
+    if (m_started) {
+        ++m_bar_index;
+    }
+    m_started = true;
+    m_timestamp_ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count());
+}
+
+void ResultsRecorder::push_slow(const ResultRow& row) {
+    // The writer is behind: wait for room rather than lose the row
+    do {
+        ++m_stalls;
+        std::this_thread::yield();
+    } while (!m_rows.try_push(row));
+}
+
+void ResultsRecorder::finish(const SymbolRegistry& registry) {
+    if (m_finished.load(std::memory_order_relaxed)) {
+        return;
+    }
+    m_symbol_names.reserve(registry.size());
+    for (SymbolId id = 0; id < registry.size(); ++id) {
+        m_symbol_names.push_back(registry.name(id));
+    }
+    m_finished.store(true, std::memory_order_release);
+}
+
+// --- ResultsStore ---
+
+ResultsStore::ResultsStore(const std::string& db_path, std::size_t ring_capacity, std::size_t rows_per_transaction)
+    : m_ring_capacity(ring_capacity),
+      m_rows_per_transaction(rows_per_transaction == 0 ? 1 : rows_per_transaction)
+{
+    auto check = [this, &db_path](int rc, const char* what) {
+        if (rc != SQLITE_OK) {
+            const std::string message = "ResultsStore " + db_path + ": " + what + ": " +
+                                        (m_db ? sqlite3_errmsg(m_db) : sqlite3_errstr(rc));
+            close_database();
+            throw std::runtime_error(message);
+        }
+    };
+
+    // Only the constructing thread and then the writer thread use the connection
+    check(sqlite3_open_v2(db_path.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX,
+                          nullptr), "cannot open");
+    // WAL appends instead of rewriting pages, and NORMAL syncs only at checkpoints
+    check(sqlite3_exec(m_db, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr),
+          "cannot set the journal mode");
+    check(sqlite3_exec(m_db, kSchema, nullptr, nullptr, nullptr), "cannot create the schema");
+
+    auto prepare = [&](const char* sql, sqlite3_stmt** statement) {
+        check(sqlite3_prepare_v3(m_db, sql, -1, SQLITE_PREPARE_PERSISTENT, statement, nullptr), sql);
+    };
+    prepare("INSERT INTO fills VALUES (?, ?, ?, ?, ?, ?, ?)", &m_insert_fill);
+    prepare("INSERT INTO equity VALUES (?, ?, ?, ?, ?, ?)", &m_insert_equity);
+    prepare("INSERT INTO runs (run_id, label) VALUES (?, ?)", &m_insert_run);
+    prepare("UPDATE runs SET bars = ?, fills = ?, final_equity = ?, final_cash = ?, peak_equity = ? "
+            "WHERE run_id = ?", &m_update_run);
+    prepare("INSERT OR REPLACE INTO symbols VALUES (?, ?, ?)", &m_insert_symbol);
+
+    // New runs continue the numbering of earlier sessions
+    sqlite3_stmt* max_run = nullptr;
+    prepare("SELECT COALESCE(MAX(run_id), 0) FROM runs", &max_run);
+    if (sqlite3_step(max_run) == SQLITE_ROW) {
+        m_next_run_id = static_cast<std::uint32_t>(sqlite3_column_int64(max_run, 0)) + 1;
+    }
+    sqlite3_finalize(max_run);
+
+    m_writer = std::thread(&ResultsStore::writer_loop, this);
+    LOG_INFO("ResultsStore", "Recording results to {}", db_path);
+}
+
+ResultsStore::~ResultsStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup_cv.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    close_database();
+}
+
+void ResultsStore::close_database() {
+    for (sqlite3_stmt* statement : {m_insert_fill, m_insert_equity, m_insert_run, m_update_run, m_insert_symbol}) {
+        sqlite3_finalize(statement); // A no-op on nullptr
+    }
+    m_insert_fill = m_insert_equity = m_insert_run = m_update_run = m_insert_symbol = nullptr;
+    sqlite3_close(m_db);
+    m_db = nullptr;
+}
+
+std::shared_ptr<ResultsRecorder> ResultsStore::begin_run(const std::string& label) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto recorder = std::make_shared<ResultsRecorder>(m_next_run_id++, label, m_ring_capacity);
+    m_new_runs.push_back(recorder);
+    return recorder;
+}
+
+void ResultsStore::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::uint64_t request = ++m_flush_requested;
+    m_wakeup_cv.notify_one();
+    m_flushed_cv.wait(lock, [&] { return m_flush_completed >= request; });
+}
+
+void ResultsStore::writer_loop() {
+    while (true) {
+        std::vector<std::shared_ptr<ResultsRecorder>> new_runs;
+        std::uint64_t flush_target = 0;
+        bool stopping = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            new_runs.swap(m_new_runs);
+            flush_target = m_flush_requested;
+            stopping = m_stop;
+        }
+
+        std::size_t work = new_runs.size();
+        for (auto& recorder : new_runs) {
+            write_run_start(*recorder);
+            m_active_runs.push_back(std::move(recorder));
+        }
+
+        for (std::size_t i = 0; i < m_active_runs.size();) {
+            ResultsRecorder& recorder = *m_active_runs[i];
+            // Read before draining: every row pushed before finish() is then visible
+            const bool finished = recorder.m_finished.load(std::memory_order_acquire);
+            work += drain(recorder, m_rows_per_transaction);
+            if (finished && recorder.m_rows.empty()) {
+                write_run_end(recorder);
+                ++work;
+                m_active_runs[i] = std::move(m_active_runs.back());
+                m_active_runs.pop_back();
+            } else {
+                ++i;
+            }
+        }
+
+        if (work > 0) {
+            continue;
+        }
+
+        // Every ring was empty: commit what is pending and report the flush
+        if (m_in_transaction) {
+            commit();
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (flush_target > m_flush_completed) {
+            m_flush_completed = flush_target;
+            m_flushed_cv.notify_all();
+        }
+        if (stopping) {
+            break;
+        }
+        m_wakeup_cv.wait_for(lock, kIdleWait, [&] {
+            return m_stop || !m_new_runs.empty() || m_flush_requested > m_flush_completed;
+        });
+    }
+
+    if (!m_active_runs.empty()) {
+        LOG_WARN("ResultsStore", "{} run(s) were not finished; their summaries are missing.", m_active_runs.size());
+    }
+    if (std::uint64_t discarded = rows_discarded(); discarded > 0) {
+        LOG_WARN("ResultsStore", "{} rows were discarded after a database error.", discarded);
+    }
+}
+
+std::size_t ResultsStore::drain(ResultsRecorder& recorder, std::size_t limit) {
+    std::size_t moved = 0;
+    while (moved < limit) {
+        const ResultRow* row = recorder.m_rows.front();
+        if (!row) {
+            break;
+        }
+        write_row(recorder.m_run_id, *row);
+        recorder.m_rows.pop();
+        ++moved;
+    }
+    return moved;
+}
+
+void ResultsStore::write_row(std::uint32_t run_id, const ResultRow& row) {
+    if (m_failed) {
+        m_rows_discarded.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    begin_transaction();
+
+    sqlite3_stmt* statement = nullptr;
+    if (row.kind == ResultRow::Kind::Fill) {
+        statement = m_insert_fill;
+        sqlite3_bind_int64(statement, 4, row.fill.symbol);
+        sqlite3_bind_int64(statement, 5, row.fill.shares);
+        sqlite3_bind_double(statement, 6, row.fill.price);
+        sqlite3_bind_double(statement, 7, row.fill.commission);
+    } else {
+        statement = m_insert_equity;
+        sqlite3_bind_double(statement, 4, row.equity.equity);
+        sqlite3_bind_double(statement, 5, row.equity.cash);
+        sqlite3_bind_double(statement, 6, row.equity.peak);
+    }
+    sqlite3_bind_int64(statement, 1, run_id);
+    sqlite3_bind_int64(statement, 2, as_int64(row.bar_index));
+    sqlite3_bind_int64(statement, 3, as_int64(row.timestamp_ns));
+    step(statement);
+    if (m_failed) {
+        m_rows_discarded.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ++m_rows_in_transaction;
+    if (m_rows_in_transaction >= m_rows_per_transaction) {
+        commit();
+    }
+}
+
+void ResultsStore::write_run_start(const ResultsRecorder& recorder) {
+    if (m_failed) {
+        return;
+    }
+    begin_transaction();
+    sqlite3_bind_int64(m_insert_run, 1, recorder.m_run_id);
+    sqlite3_bind_text(m_insert_run, 2, recorder.m_label.c_str(), -1, SQLITE_TRANSIENT);
+    step(m_insert_run);
+}
+
+void ResultsStore::write_run_end(const ResultsRecorder& recorder) {
+    if (m_failed) {
+        return;
+    }
+    begin_transaction();
+    const std::uint64_t bars = recorder.m_started ? recorder.m_bar_index + 1 : 0;
+    sqlite3_bind_int64(m_update_run, 1, as_int64(bars));
+    sqlite3_bind_int64(m_update_run, 2, as_int64(recorder.m_fills));
+    sqlite3_bind_double(m_update_run, 3, recorder.m_final_equity);
+    sqlite3_bind_double(m_update_run, 4, recorder.m_final_cash);
+    sqlite3_bind_double(m_update_run, 5, recorder.m_peak_equity);
+    sqlite3_bind_int64(m_update_run, 6, recorder.m_run_id);
+    step(m_update_run);
+
+    for (SymbolId id = 0; id < recorder.m_symbol_names.size() && !m_failed; ++id) {
+        sqlite3_bind_int64(m_insert_symbol, 1, recorder.m_run_id);
+        sqlite3_bind_int64(m_insert_symbol, 2, id);
+        sqlite3_bind_text(m_insert_symbol, 3, recorder.m_symbol_names[id].c_str(), -1, SQLITE_STATIC);
+        step(m_insert_symbol);
+    }
+}
+
+void ResultsStore::begin_transaction() {
+    if (!m_in_transaction && !m_failed) {
+        exec("BEGIN");
+        m_in_transaction = !m_failed;
+    }
+}
+
+void ResultsStore::commit() {
+    if (!m_in_transaction) {
+        return;
+    }
+    exec("COMMIT");
+    if (!m_failed) {
+        m_rows_written.fetch_add(m_rows_in_transaction, std::memory_order_relaxed);
+        m_rows_in_transaction = 0;
+        m_in_transaction = false;
+    }
+}
+
+void ResultsStore::exec(const char* sql) {
+    if (m_failed) {
+        return;
+    }
+    char* error = nullptr;
+    if (sqlite3_exec(m_db, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+        fail(error ? error : sqlite3_errmsg(m_db));
+        sqlite3_free(error);
+    }
+}
+
+void ResultsStore::step(sqlite3_stmt* statement) {
+    if (m_failed) {
+        return;
+    }
+    if (sqlite3_step(statement) != SQLITE_DONE) {
+        fail(sqlite3_errmsg(m_db));
+    }
+    sqlite3_reset(statement);
+}
+
+void ResultsStore::fail(const char* message) {
+    LOG_ERROR("ResultsStore", "Database error, no further results are recorded: {}", message);
+    m_failed = true;
+    // The open transaction's rows are lost with it
+    m_rows_discarded.fetch_add(m_rows_in_transaction, std::memory_order_relaxed);
+    m_rows_in_transaction = 0;
+    if (m_in_transaction) {
+        sqlite3_exec(m_db, "ROLLBACK", nullptr, nullptr, nullptr);
+        m_in_transaction = false;
+    }
+}
@@ -0,0 +1,126 @@
+// src/risk/EwmaCovariance.cpp
+
+#include "risk/EwmaCovariance.h"
+#include "checkpoint/Checkpoint.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    // Rescale before the stored entries (which grow like 1/m_scale) could overflow
+    constexpr double kMinScale = 1e-100;
+}
+
+EwmaCovariance::EwmaCovariance(double decay)
+    : m_decay(decay)
+{
+    if (!(decay > 0.0 && decay < 1.0)) {
+        throw std::invalid_argument("EwmaCovariance decay must be in (0, 1)");
+    }
+}
+
+void EwmaCovariance::resize(std::size_t symbols) {
+    if (symbols <= m_symbols) {
+        return;
+    }
+    std::vector<double> matrix(symbols * symbols, 0.0);
+    for (std::size_t i = 0; i < m_symbols; ++i) {
+        std::copy_n(m_matrix.begin() + i * m_symbols, m_symbols, matrix.begin() + i * symbols);
+    }
+    m_matrix = std::move(matrix);
+    m_symbols = symbols;
+    m_product_valid = false;
+    // Sized here, with the matrix, so rebuilding the product never allocates on the bar path
+    m_product.reserve(symbols);
+    m_product_weights.reserve(symbols);
+}
+
+void EwmaCovariance::normalize() {
+    for (double& value : m_matrix) {
+        value *= m_scale;
+    }
+    m_scale = 1.0;
+    m_product_valid = false;
+}
+
+void EwmaCovariance::update(const std::vector<double>& returns) {
+    const std::size_t count = std::min(returns.size(), m_symbols);
+    m_scale *= m_decay;
+    if (m_scale < kMinScale) {
+        normalize();
+    }
+    ++m_observations;
+    m_product_valid = false;
+
+    // Row i gets (1 - decay) * r_i * r, divided by the scale the matrix is stored under
+    const double step = (1.0 - m_decay) / m_scale;
+    const double* r = returns.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (r[i] == 0.0) {
+            continue; // Nothing to add to this row (or, by symmetry, this column)
+        }
+        const double factor = step * r[i];
+        double* row = m_matrix.data() + i * m_symbols;
+        for (std::size_t j = 0; j < count; ++j) {
+            row[j] += factor * r[j];
+        }
+    }
+}
+
+double EwmaCovariance::portfolio_variance(const std::vector<double>& weights) {
+    const std::size_t count = std::min(weights.size(), m_symbols);
+    if (!m_product_valid || m_product.size() != count) {
+        m_product.assign(count, 0.0);
+        m_product_weights.assign(count, 0.0);
+        m_product_valid = true;
+    }
+    double* product = m_product.data();
+    double* previous = m_product_weights.data();
+    const double* w = weights.data();
+
+    // C w as a sum of rows (C is symmetric): add (w_i - previous_i) * row_i
+    // for every weight that changed since the product was last brought up to date
+    for (std::size_t i = 0; i < count; ++i) {
+        if (w[i] == previous[i]) {
+            continue;
+        }
+        const double weight = w[i] - previous[i];
+        previous[i] = w[i];
+        const double* row = m_matrix.data() + i * m_symbols;
+        for (std::size_t j = 0; j < count; ++j) {
+            product[j] += weight * row[j];
+        }
+    }
+
+    double variance = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        variance += w[i] * product[i];
+    }
+    return m_scale * variance;
+}
+
+void EwmaCovariance::save_state(StateWriter& writer) const {
+    writer.write(m_decay);
+    writer.write(m_scale);
+    writer.write<std::uint64_t>(m_symbols);
+    writer.write<std::uint64_t>(m_observations);
+    writer.write_vector(m_matrix);
+    writer.write_vector(m_product);
+    writer.write_vector(m_product_weights);
+    writer.write(m_product_valid);
+}
+
+void EwmaCovariance::restore_state(StateReader& reader) {
+    if (reader.read<double>() != m_decay) {
+        throw std::runtime_error("Checkpoint covariance was estimated with a different decay");
+    }
+    reader.read(m_scale);
+    m_symbols = reader.read<std::uint64_t>();
+    m_observations = reader.read<std::uint64_t>();
+    reader.read_vector(m_matrix);
+    reader.read_vector(m_product);
+    reader.read_vector(m_product_weights);
+    reader.read(m_product_valid);
+    if (m_matrix.size() != m_symbols * m_symbols) {
+        throw std::runtime_error("Checkpoint covariance matrix does not match its symbol count");
+    }
+}
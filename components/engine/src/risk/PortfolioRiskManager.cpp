@@ -1,12 +1,140 @@
 // src/risk/PortfolioRiskManager.cpp
 
 #include "risk/PortfolioRiskManager.h"
+#include "checkpoint/Checkpoint.h"
 #include "core/Portfolio.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cmath>
 #include <numeric>
-#include <iostream>
 
-PortfolioRiskManager::PortfolioRiskManager(double max_pos_weight, double max_leverage, double max_drawdown)
-    : m_max_pos_weight(max_pos_weight), m_max_leverage(max_leverage), m_max_drawdown(max_drawdown) {}
+PortfolioRiskManager::PortfolioRiskManager(double max_pos_weight, double max_leverage, double max_drawdown,
+                                           const VolatilityLimits& volatility_limits)
+    : m_max_pos_weight(max_pos_weight), m_max_leverage(max_leverage), m_max_drawdown(max_drawdown),
+      m_volatility_limits(volatility_limits),
+      m_volatility_enabled(volatility_limits.target_volatility > 0.0 || volatility_limits.max_value_at_risk > 0.0),
+      m_covariance(volatility_limits.ewma_decay) {}
+
+void PortfolioRiskManager::on_market_bar(SymbolId symbol, const DataBar& bar) {
+    if (!m_volatility_enabled) {
+        return;
+    }
+    if (bar.timestamp != m_period_timestamp) {
+        close_period();
+        m_period_timestamp = bar.timestamp;
+    }
+    if (symbol >= m_last_close.size()) {
+        m_last_close.resize(symbol + 1, 0.0);
+        m_period_close.resize(symbol + 1, 0.0); // 0 = no close yet, so no return this period
+        m_in_period.resize(symbol + 1, false);
+    }
+    if (!m_in_period[symbol]) {
+        m_in_period[symbol] = true;
+        m_period_symbols.push_back(symbol);
+    }
+    m_last_close[symbol] = bar.close;
+}
+
+void PortfolioRiskManager::save_state(StateWriter& out) const {
+    out.write(m_volatility_enabled);
+    m_covariance.save_state(out);
+    out.write<std::int64_t>(m_period_timestamp.time_since_epoch().count());
+    out.write_vector(m_last_close);
+    out.write_vector(m_period_close);
+    out.write_vector(m_period_symbols);
+    out.write_vector(m_in_period);
+}
+
+void PortfolioRiskManager::restore_state(StateReader& in) {
+    if (in.read<bool>() != m_volatility_enabled) {
+        throw std::runtime_error("Checkpoint was taken with different volatility limits");
+    }
+    m_covariance.restore_state(in);
+    m_period_timestamp = std::chrono::system_clock::time_point(
+        std::chrono::system_clock::duration(in.read<std::int64_t>()));
+    in.read_vector(m_last_close);
+    in.read_vector(m_period_close);
+    in.read_vector(m_period_symbols);
+    in.read_vector(m_in_period);
+}
+
+void PortfolioRiskManager::close_period() {
+    if (m_period_symbols.empty()) {
+        return;
+    }
+    m_covariance.resize(m_last_close.size());
+    m_returns.assign(m_last_close.size(), 0.0);
+
+    // Only the symbols that traded have a return; the others stay at 0
+    bool any_return = false;
+    for (SymbolId id : m_period_symbols) {
+        const double previous = m_period_close[id];
+        const double current = m_last_close[id];
+        if (previous > 0.0 && current > 0.0) {
+            m_returns[id] = std::log(current / previous);
+            any_return = true;
+        }
+        m_period_close[id] = current;
+        m_in_period[id] = false;
+    }
+    m_period_symbols.clear();
+
+    if (any_return) {
+        m_covariance.update(m_returns);
+    }
+}
+
+double PortfolioRiskManager::predicted_volatility(const WeightVector& target_weights) {
+    if (m_covariance.observations() < m_volatility_limits.min_observations) {
+        return 0.0;
+    }
+    return std::sqrt(std::max(0.0, m_covariance.portfolio_variance(target_weights)));
+}
+
+double PortfolioRiskManager::volatility_scaling(const WeightVector& target_weights) {
+    const double volatility = predicted_volatility(target_weights);
+    if (volatility <= 0.0) {
+        return 1.0; // Still warming up, or nothing at risk
+    }
+
+    double scaling_factor = 1.0;
+    if (m_volatility_limits.target_volatility > 0.0) {
+        const double annualized = volatility * std::sqrt(m_volatility_limits.periods_per_year);
+        if (annualized > m_volatility_limits.target_volatility) {
+            LOG_WARN("RiskManager", "WARNING: Predicted volatility ({}%) exceeds the budget ({}%). Scaling all positions.",
+                     annualized * 100, m_volatility_limits.target_volatility * 100);
+            scaling_factor = std::min(scaling_factor, m_volatility_limits.target_volatility / annualized);
+        }
+    }
+    if (m_volatility_limits.max_value_at_risk > 0.0) {
+        const double value_at_risk = m_volatility_limits.var_z_score * volatility;
+        if (value_at_risk > m_volatility_limits.max_value_at_risk) {
+            LOG_WARN("RiskManager", "WARNING: Predicted VaR ({}%) exceeds the limit ({}%). Scaling all positions.",
+                     value_at_risk * 100, m_volatility_limits.max_value_at_risk * 100);
+            scaling_factor = std::min(scaling_factor, m_volatility_limits.max_value_at_risk / value_at_risk);
+        }
+    }
+
+    return scaling_factor;
+}
+
+bool PortfolioRiskManager::drawdown_exceeded(const Portfolio& current_portfolio, double peak_portfolio_value) {
+    double drawdown = 0.0;
+    if (peak_portfolio_value > 0) {
+        drawdown = (peak_portfolio_value - current_portfolio.get_total_value()) / peak_portfolio_value;
+    }
+    if (drawdown <= m_max_drawdown) {
+        m_drawdown_breached = false;
+        return false;
+    }
+    if (!m_drawdown_breached) {
+        // Flattening keeps the drawdown above the limit, so this would otherwise repeat every bar
+        m_drawdown_breached = true;
+        LOG_ERROR("RiskManager", "CRITICAL: Max drawdown of {}% exceeded. Current drawdown: {}%. FLATTENING ALL POSITIONS.",
+                  m_max_drawdown * 100, drawdown * 100);
+    }
+    return true;
+}
 
 std::map<std::string, double> PortfolioRiskManager::validate_target(
     const Portfolio& current_portfolio,
@@ -14,28 +142,19 @@ std::map<std::string, double> PortfolioRiskManager::validate_target(
     const std::map<std::string, double>& target_portfolio) {
 
     // --- Max Drawdown Rule ---
-    double current_value = current_portfolio.get_total_value();
-    if (peak_portfolio_value > 0) {
-        double drawdown = (peak_portfolio_value - current_value) / peak_portfolio_value;
-        if (drawdown > m_max_drawdown) {
-            std::cout << "[RiskManager] CRITICAL: Max drawdown of " << m_max_drawdown * 100
-                      << "% exceeded. Current drawdown: " << drawdown * 100
-                      << "%. FLATTENING ALL POSITIONS." << std::endl;
-            // Return "sell everything".
-            return {};
-        }
+    if (drawdown_exceeded(current_portfolio, peak_portfolio_value)) {
+        // Return "sell everything".
+        return {};
     }
 
     auto approved_portfolio = target_portfolio;
-    std::cout << "[RiskManager] Starting validation of target portfolio..." << std::endl;
+    LOG_DEBUG("RiskManager", "Starting validation of target portfolio...");
 
     // --- Concentration Risk ---
     for (auto& position : approved_portfolio) {
         if (position.second > m_max_pos_weight) {
-            std::cout << "[RiskManager] WARNING: Position " << position.first
-                      << " target weight (" << position.second * 100 << "%)"
-                      << " exceeds max allowed (" << m_max_pos_weight * 100 << "%). Scaling down."
-                      << std::endl;
+            LOG_WARN("RiskManager", "WARNING: Position {} target weight ({}%) exceeds max allowed ({}%). Scaling down.",
+                     position.first, position.second * 100, m_max_pos_weight * 100);
             position.second = m_max_pos_weight;
         }
     }
@@ -51,9 +170,8 @@ std::map<std::string, double> PortfolioRiskManager::validate_target(
     );
 
     if (total_weight > m_max_leverage) {
-        std::cout << "[RiskManager] WARNING: Total target weight (" << total_weight * 100 << "%)"
-                  << " exceeds max leverage (" << m_max_leverage * 100 << "%). Scaling all positions."
-                  << std::endl;
+        LOG_WARN("RiskManager", "WARNING: Total target weight ({}%) exceeds max leverage ({}%). Scaling all positions.",
+                 total_weight * 100, m_max_leverage * 100);
 
         double scaling_factor = m_max_leverage / total_weight;
         for (auto& position : approved_portfolio) {
@@ -61,6 +179,76 @@ std::map<std::string, double> PortfolioRiskManager::validate_target(
         }
     }
 
-    std::cout << "[RiskManager] Validation complete. Portfolio is compliant." << std::endl;
+    // --- Portfolio Volatility and VaR ---
+    // The covariance is kept by SymbolId: symbols the registry does not know carry no risk estimate
+    if (m_volatility_enabled) {
+        const SymbolRegistry& registry = *current_portfolio.registry();
+        m_map_weights.assign(registry.size(), 0.0);
+        for (const auto& [symbol, weight] : approved_portfolio) {
+            const SymbolId id = registry.find(symbol);
+            if (id != kInvalidSymbolId) {
+                m_map_weights[id] = weight;
+            }
+        }
+        const double scaling_factor = volatility_scaling(m_map_weights);
+        if (scaling_factor < 1.0) {
+            for (auto& position : approved_portfolio) {
+                position.second *= scaling_factor;
+            }
+        }
+    }
+
+    LOG_DEBUG("RiskManager", "Validation complete. Portfolio is compliant.");
     return approved_portfolio;
-}
\ No newline at end of file
+}
+
+void PortfolioRiskManager::validate_target_weights(
+    const Portfolio& current_portfolio,
+    double peak_portfolio_value,
+    const SymbolRegistry& registry,
+    WeightVector& target_weights) {
+
+    // --- Max Drawdown Rule ---
+    if (drawdown_exceeded(current_portfolio, peak_portfolio_value)) {
+        // Zero every weight: "sell everything".
+        std::fill(target_weights.begin(), target_weights.end(), 0.0);
+        return;
+    }
+
+    LOG_DEBUG("RiskManager", "Starting validation of target portfolio...");
+
+    // --- Concentration Risk ---
+    double total_weight = 0.0;
+    for (SymbolId id = 0; id < target_weights.size(); ++id) {
+        double& weight = target_weights[id];
+        if (weight > m_max_pos_weight) {
+            LOG_WARN("RiskManager", "WARNING: Position {} target weight ({}%) exceeds max allowed ({}%). Scaling down.",
+                     registry.name(id), weight * 100, m_max_pos_weight * 100);
+            weight = m_max_pos_weight;
+        }
+        total_weight += weight;
+    }
+
+    // --- Leverage and Total Exposure Risk ---
+    if (total_weight > m_max_leverage) {
+        LOG_WARN("RiskManager", "WARNING: Total target weight ({}%) exceeds max leverage ({}%). Scaling all positions.",
+                 total_weight * 100, m_max_leverage * 100);
+
+        double scaling_factor = m_max_leverage / total_weight;
+        for (double& weight : target_weights) {
+            weight *= scaling_factor;
+        }
+    }
+
+    // --- Portfolio Volatility and VaR ---
+    if (m_volatility_enabled) {
+        const double scaling_factor = volatility_scaling(target_weights);
+        if (scaling_factor < 1.0) {
+            for (double& weight : target_weights) {
+                weight *= scaling_factor;
+            }
+        }
+    }
+
+    LOG_DEBUG("RiskManager", "Validation complete. Portfolio is compliant.");
+}
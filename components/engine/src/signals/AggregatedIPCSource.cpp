@@ -2,97 +2,273 @@
 
 #include "core/SignalPacket.h"
 #include "signals/AggregatedIPCSource.h"
-#include <numeric>
-#include <iostream>
-#include <cmath>
-
-// Private helper function for the aggregation logic
-namespace {
-    std::map<std::string, double> aggregate_signals(const std::vector<SignalPacket>& packets) {
-        if (packets.empty()) {
-            return {};
-        }
+#include "signals/SignalAggregation.h"
+#include "signals/WireProtocol.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+AggregatedIPCSource::AggregatedIPCSource(const std::vector<std::string>& model_endpoints,
+                                       std::chrono::milliseconds reply_timeout,
+                                       std::size_t batch_size,
+                                       std::unique_ptr<ISignalAggregator> aggregator)
+    : m_context(1),
+      m_reply_timeout(reply_timeout),
+      m_batch_size(std::max<std::size_t>(1, batch_size)),
+      m_aggregator(aggregator ? std::move(aggregator) : std::make_unique<WeightedMeanAggregator>())
+{
+    m_sockets.reserve(model_endpoints.size());
+    for (std::size_t i = 0; i < model_endpoints.size(); ++i) {
+        const std::string& endpoint = model_endpoints[i];
+        LOG_INFO("IPCSource", "Connecting DEALER socket to {}", endpoint);
+        m_sockets.emplace_back(m_context, zmq::socket_type::dealer);
+        m_sockets.back().set(zmq::sockopt::linger, 0);
+        m_sockets.back().connect(endpoint);
 
-        std::map<std::string, double> weighted_sums;
-        std::map<std::string, double> total_confidences;
+        const std::string model = "model[" + std::to_string(i) + "] " + endpoint;
+        m_reply_latency.push_back(&m_metrics.histogram(model + " reply"));
+        m_timeouts.push_back(&m_metrics.counter(model + " timeouts"));
+    }
 
-        // 1. Accumulate weighted sums and total confidences for each asset
-        for (const auto& packet : packets) {
-            weighted_sums[packet.symbol] += packet.target_weight * packet.confidence;
-            total_confidences[packet.symbol] += packet.confidence;
+    // The poll set never changes, so it is built once
+    for (auto& socket : m_sockets) {
+        m_poll_items.push_back({socket, 0, ZMQ_POLLIN, 0});
+    }
+    m_wire_formats.assign(m_sockets.size(), wire::ReplyFormat::Json); // Upgraded on the first binary reply
+    m_causal_models.assign(m_sockets.size(), false);
+    m_queued_bars.reserve(m_batch_size);
+}
+
+bool AggregatedIPCSource::send_request(std::size_t model_index, std::uint64_t request_id, const std::string& payload) {
+    auto& socket = m_sockets[model_index];
+    if (!socket.send(zmq::buffer(&request_id, sizeof(request_id)), zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+        LOG_WARN("IPCSource", "WARNING: Model {} is backlogged, skipping request {}.", model_index, request_id);
+        return false;
+    }
+    // Once the first frame is queued, the rest of the message is queued atomically
+    socket.send(zmq::message_t(), zmq::send_flags::sndmore);
+    socket.send(zmq::buffer(payload), zmq::send_flags::none);
+    return true;
+}
+
+bool AggregatedIPCSource::receive_reply(std::size_t model_index, std::uint64_t request_id) {
+    auto& socket = m_sockets[model_index];
+    while (socket.recv(m_id_frame, zmq::recv_flags::dontwait)) {
+        std::size_t frames = 1;
+        bool more = m_id_frame.more();
+        while (more) {
+            zmq::message_t& frame = frames == 1 ? m_delimiter_frame : frames == 2 ? m_reply : m_extra_frame;
+            (void)socket.recv(frame, zmq::recv_flags::none);
+            more = frame.more();
+            ++frames;
         }
 
-        // 2. Calculate the final weighted average for each asset
-        std::map<std::string, double> aggregated_portfolio;
-        for (const auto& pair : weighted_sums) {
-            const std::string& asset = pair.first;
-            if (total_confidences[asset] > 1e-9) { // Avoid division by zero
-                aggregated_portfolio[asset] = weighted_sums[asset] / total_confidences[asset];
-            }
+        if (m_id_frame.size() != sizeof(request_id) || frames != 3 || m_delimiter_frame.size() != 0) {
+            LOG_ERROR("IPCSource", "ERROR: Malformed reply envelope from model {}.", model_index);
+            continue;
         }
 
-        std::cout << "[IPCSource] Aggregation complete on " << packets.size() << " signals." << std::endl;
-        return aggregated_portfolio;
+        std::uint64_t reply_id = 0;
+        std::memcpy(&reply_id, m_id_frame.data(), sizeof(reply_id));
+        if (reply_id == request_id) {
+            return true;
+        }
+        ++m_late_replies; // Answers a request that already timed out
     }
+    return false;
 }
 
-AggregatedIPCSource::AggregatedIPCSource(const std::vector<std::string>& model_endpoints,
-                                       std::chrono::milliseconds reply_timeout)
-    : m_context(1),
-      m_reply_timeout(reply_timeout)
-{
-    m_sockets.reserve(model_endpoints.size());
-    for (const auto& endpoint : model_endpoints) {
-        std::cout << "[IPCSource] Connecting REQ socket to " << endpoint << std::endl;
-        m_sockets.emplace_back(m_context, zmq::socket_type::req);
-        m_sockets.back().connect(endpoint);
+template <typename OnReply>
+std::size_t AggregatedIPCSource::poll_replies(std::uint64_t request_id,
+                                              std::chrono::steady_clock::time_point sent_at,
+                                              std::chrono::steady_clock::time_point deadline,
+                                              OnReply&& on_reply) {
+    m_replied.assign(m_sockets.size(), false);
+    std::size_t replies = 0;
+    while (replies < m_sockets.size()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+        zmq::poll(m_poll_items, std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+
+        for (std::size_t i = 0; i < m_poll_items.size(); ++i) {
+            if (m_replied[i] || !(m_poll_items[i].revents & ZMQ_POLLIN)) {
+                continue;
+            }
+            if (!receive_reply(i, request_id)) {
+                continue;
+            }
+            m_reply_latency[i]->record(std::chrono::steady_clock::now() - sent_at);
+            m_replied[i] = true;
+            ++replies;
+            on_reply(i, m_reply);
+        }
+    }
+
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        if (!m_replied[i]) {
+            ++*m_timeouts[i];
+        }
     }
+    return replies;
 }
 
 void AggregatedIPCSource::update_market_data(const nlohmann::json& market_data) {
     m_latest_market_data = market_data;
+    // Raw JSON can only be forwarded as JSON, one message at a time
+    m_queued_bars.clear();
+    m_batch_next = m_batch_size_sent = 0;
+}
+
+void AggregatedIPCSource::update_market_bar(const DataBar& bar) {
+    m_latest_market_data = nullptr;
+    if (m_batch_size == 1) {
+        m_queued_bars.clear(); // Lock-step: the latest bar replaces any uncollected one
+    }
+    m_queued_bars.push_back(bar);
 }
 
 std::map<std::string, double> AggregatedIPCSource::get_target_portfolio() {
-    if (m_latest_market_data.is_null()) {
-        std::cerr << "[IPCSource] ERROR: get_target_portfolio() called before update_market_data()." << std::endl;
-        return {};
+    const ModelReplies& replies = next_signals();
+    m_last_result_complete = all_models_replied(replies);
+    return aggregate_signals(replies, *m_aggregator);
+}
+
+void AggregatedIPCSource::get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) {
+    const ModelReplies& replies = next_signals();
+    m_last_result_complete = all_models_replied(replies);
+    m_signal_matrix.load(replies, registry);
+    m_aggregator->aggregate(m_signal_matrix, target_weights);
+}
+
+const ModelReplies& AggregatedIPCSource::next_signals() {
+    if (m_batch_next == m_batch_size_sent && m_queued_bars.size() > 1 && can_batch()) {
+        collect_signal_batch();
     }
 
-    // --- 1. Send Requests ---
-    std::string request_str = m_latest_market_data.dump();
-    for (auto& socket : m_sockets) {
-        socket.send(zmq::buffer(request_str), zmq::send_flags::dontwait);
+    if (m_batch_next < m_batch_size_sent) {
+        return m_batch_replies[m_batch_next++];
     }
 
-    // --- 2. Poll for Replies ---
-    std::vector<zmq::pollitem_t> poll_items;
-    poll_items.reserve(m_sockets.size());
-    for (auto& socket : m_sockets) {
-        poll_items.push_back({socket, 0, ZMQ_POLLIN, 0});
+    if (m_queued_bars.empty()) {
+        return collect_signals(nullptr); // Raw JSON market data (or nothing at all)
+    }
+
+    const ModelReplies& signals = collect_signals(&m_queued_bars.front());
+    m_queued_bars.erase(m_queued_bars.begin());
+    return signals;
+}
+
+bool AggregatedIPCSource::can_batch() const {
+    return m_batch_size != 1 && models_stateless();
+}
+
+bool AggregatedIPCSource::models_stateless() const {
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        if (m_wire_formats[i] != wire::ReplyFormat::Binary || !m_causal_models[i]) {
+            return false;
+        }
+    }
+    return !m_sockets.empty();
+}
+
+const ModelReplies& AggregatedIPCSource::collect_signals(const DataBar* bar) {
+    reset_model_replies(m_replies, m_sockets.size());
+    if (!bar && m_latest_market_data.is_null()) {
+        LOG_ERROR("IPCSource", "ERROR: get_target_portfolio() called before update_market_data().");
+        return m_replies;
+    }
+
+    // --- 1. Encode Requests (each encoding only if some model needs it) ---
+    bool any_json = !bar;
+    bool any_binary = false;
+    for (wire::ReplyFormat format : m_wire_formats) {
+        any_json = any_json || format == wire::ReplyFormat::Json;
+        any_binary = any_binary || format == wire::ReplyFormat::Binary;
+    }
+
+    if (any_binary && bar) {
+        wire::encode_market_data(*bar, m_binary_request);
+    }
+    if (any_json) {
+        if (bar) {
+            wire::encode_json_market_data(*bar, m_json_request);
+        } else {
+            m_json_request = m_latest_market_data.dump();
+        }
     }
 
-    zmq::poll(poll_items, m_reply_timeout);
+    // --- 2. Send Requests ---
+    const std::uint64_t request_id = m_next_request_id++;
+    const auto sent_at = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        const bool binary = bar && m_wire_formats[i] == wire::ReplyFormat::Binary;
+        send_request(i, request_id, binary ? m_binary_request : m_json_request);
+    }
+
+    // --- 3. Poll for Replies, then Collect and Parse them ---
+    const std::size_t replies = poll_replies(request_id, sent_at, sent_at + m_reply_timeout,
+        [&](std::size_t model_index, const zmq::message_t& reply) {
+            parse_reply(model_index, reply, m_replies[model_index]);
+        });
+
+    LOG_DEBUG("IPCSource", "Polling complete. Received {}/{} replies.", replies, m_sockets.size());
+
+    return m_replies;
+}
+
+void AggregatedIPCSource::parse_reply(std::size_t model_index, const zmq::message_t& reply, std::string& out) {
+    try {
+        if (wire::store_reply(reply.data(), reply.size(), out) == wire::ReplyFormat::Binary) {
+            m_wire_formats[model_index] = wire::ReplyFormat::Binary;
+            m_causal_models[model_index] = wire::message_flags(reply.data(), reply.size()) & wire::kFlagCausal;
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("IPCSource", "ERROR parsing reply: {}", e.what());
+    }
+}
+
+void AggregatedIPCSource::collect_signal_batch() {
+    const std::size_t batch_count = std::min(m_queued_bars.size(), m_batch_size);
+    std::span<const DataBar> batch(m_queued_bars.data(), batch_count);
+
+    // --- 1. Send one request carrying the whole batch to every model ---
+    wire::encode_market_data_batch(batch, m_binary_request);
+    const std::uint64_t request_id = m_next_request_id++;
+    const auto sent_at = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        send_request(i, request_id, m_binary_request);
+    }
+
+    // --- 2. Poll until every model replied or the batch deadline passes ---
+    if (m_batch_replies.size() < batch_count) {
+        m_batch_replies.resize(batch_count);
+    }
+    for (std::size_t bar = 0; bar < batch_count; ++bar) {
+        reset_model_replies(m_batch_replies[bar], m_sockets.size());
+    }
 
     // --- 3. Collect and Parse Replies ---
-    std::vector<SignalPacket> received_packets;
-    for (size_t i = 0; i < poll_items.size(); ++i) {
-        if (poll_items[i].revents & ZMQ_POLLIN) {
-            zmq::message_t reply;
-            if (m_sockets[i].recv(reply, zmq::recv_flags::dontwait)) {
-                try {
-                    nlohmann::json j = nlohmann::json::parse(reply.to_string());
-                    received_packets.push_back(j.get<SignalPacket>());
-                } catch (const nlohmann::json::exception& e) {
-                    std::cerr << "[IPCSource] ERROR parsing JSON reply: " << e.what() << std::endl;
+    const std::size_t replies = poll_replies(request_id, sent_at, sent_at + m_reply_timeout * batch_count,
+        [&](std::size_t model_index, const zmq::message_t& reply) {
+            m_batch_split.resize(batch_count);
+            try {
+                wire::split_signal_batch(reply.data(), reply.size(), m_batch_split);
+                for (std::size_t bar = 0; bar < batch_count; ++bar) {
+                    // A swap, so both buffers keep their capacity for the next batch
+                    m_batch_replies[bar][model_index].swap(m_batch_split[bar]);
                 }
+                m_causal_models[model_index] = wire::message_flags(reply.data(), reply.size()) & wire::kFlagCausal;
+            } catch (const std::exception& e) {
+                LOG_ERROR("IPCSource", "ERROR parsing batch reply: {}", e.what());
             }
-        }
-    }
+        });
 
-    std::cout << "[IPCSource] Polling complete. Received "
-              << received_packets.size() << "/" << m_sockets.size() << " replies." << std::endl;
+    LOG_DEBUG("IPCSource", "Batch of {} bars complete. Received {}/{} replies.", batch_count, replies, m_sockets.size());
 
-    // --- 4. Aggregate and Return ---
-    return aggregate_signals(received_packets);
-}
\ No newline at end of file
+    // --- 4. Serve the per-bar results locally from now on ---
+    m_batch_size_sent = batch_count;
+    m_batch_next = 0;
+    m_queued_bars.erase(m_queued_bars.begin(), m_queued_bars.begin() + batch_count);
+}
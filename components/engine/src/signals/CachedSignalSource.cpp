@@ -0,0 +1,138 @@
+// src/signals/CachedSignalSource.cpp
+
+#include "signals/CachedSignalSource.h"
+#include "signals/WireProtocol.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <stdexcept>
+
+CachedSignalSource::CachedSignalSource(std::unique_ptr<ISignalSource> inner, std::shared_ptr<SignalReplyCache> cache)
+    : m_inner(std::move(inner)),
+      m_cache(std::move(cache))
+{
+    if (!m_inner || !m_cache) {
+        throw std::invalid_argument("CachedSignalSource needs a signal source and a cache");
+    }
+    m_pending.resize(std::max<std::size_t>(1, m_inner->pipeline_depth()));
+}
+
+void CachedSignalSource::update_market_data(const nlohmann::json& market_data) {
+    m_payload = market_data.dump();
+    if (submit()) {
+        m_inner->update_market_data(market_data);
+    }
+}
+
+void CachedSignalSource::update_market_bar(const DataBar& bar) {
+    wire::encode_market_data(bar, m_payload);
+    if (submit()) {
+        m_inner->update_market_bar(bar);
+    }
+}
+
+std::map<std::string, double> CachedSignalSource::get_target_portfolio() {
+    if (m_pending_count == 0) {
+        LOG_ERROR("CachedSignalSource", "ERROR: get_target_portfolio() called without an outstanding request.");
+        m_last_result_complete = false;
+        return {};
+    }
+    PendingBar& oldest = take_oldest();
+    std::map<std::string, double> target_portfolio;
+    if (oldest.hit) {
+        if (oldest.forwarded) {
+            (void)m_inner->get_target_portfolio(); // Keeps the models in step; the recorded reply is served
+        }
+        m_last_result_complete = true;
+        decode(oldest.value);
+        for (const SignalPacket& packet : m_packets) {
+            target_portfolio[packet.symbol] = packet.target_weight;
+        }
+        return target_portfolio;
+    }
+
+    target_portfolio = m_inner->get_target_portfolio();
+    m_last_result_complete = m_inner->last_result_complete();
+    if (!m_last_result_complete) {
+        return target_portfolio; // A model was masked out of this bar: pass the result on, but never replay it
+    }
+    m_packets.clear();
+    for (const auto& [symbol, weight] : target_portfolio) {
+        if (weight != 0.0) {
+            m_packets.emplace_back(symbol, weight < 0.0 ? SignalType::Short : SignalType::Long, weight, 1.0);
+        }
+    }
+    record(oldest.key);
+    return target_portfolio;
+}
+
+void CachedSignalSource::get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) {
+    if (m_pending_count == 0) {
+        LOG_ERROR("CachedSignalSource", "ERROR: get_target_weights() called without an outstanding request.");
+        m_last_result_complete = false;
+        target_weights.assign(registry.size(), 0.0);
+        return;
+    }
+    PendingBar& oldest = take_oldest();
+    if (oldest.hit) {
+        if (oldest.forwarded) {
+            m_inner->get_target_weights(registry, target_weights); // As in get_target_portfolio()
+        }
+        m_last_result_complete = true;
+        decode(oldest.value);
+        target_weights.assign(registry.size(), 0.0);
+        for (const SignalPacket& packet : m_packets) {
+            const SymbolId id = registry.find(packet.symbol);
+            if (id != kInvalidSymbolId) {
+                target_weights[id] = packet.target_weight;
+            }
+        }
+        return;
+    }
+
+    m_inner->get_target_weights(registry, target_weights);
+    m_last_result_complete = m_inner->last_result_complete();
+    if (!m_last_result_complete) {
+        return; // As in get_target_portfolio()
+    }
+    m_packets.clear();
+    for (std::size_t id = 0; id < target_weights.size(); ++id) {
+        const double weight = target_weights[id];
+        if (weight != 0.0) {
+            m_packets.emplace_back(registry.name(static_cast<SymbolId>(id)),
+                                   weight < 0.0 ? SignalType::Short : SignalType::Long, weight, 1.0);
+        }
+    }
+    record(oldest.key);
+}
+
+bool CachedSignalSource::submit() {
+    if (m_pending_count == m_pending.size()) {
+        // Full (a caller running further ahead than pipeline_depth()): unwrap, then grow
+        std::rotate(m_pending.begin(), m_pending.begin() + m_pending_head, m_pending.end());
+        m_pending_head = 0;
+        m_pending.emplace_back();
+    }
+    PendingBar& slot = m_pending[(m_pending_head + m_pending_count++) % m_pending.size()];
+    slot.key = m_cache->key_of(m_payload);
+    slot.hit = m_cache->find(slot.key, slot.value);
+    // A model that keeps state must see every bar, even one whose answer is recorded
+    slot.forwarded = !slot.hit || !m_inner->models_stateless();
+    return slot.forwarded;
+}
+
+CachedSignalSource::PendingBar& CachedSignalSource::take_oldest() {
+    PendingBar& oldest = m_pending[m_pending_head];
+    m_pending_head = (m_pending_head + 1) % m_pending.size();
+    --m_pending_count;
+    return oldest;
+}
+
+void CachedSignalSource::decode(const std::string& value) {
+    m_packets.clear();
+    wire::decode_signals(value.data(), value.size(), m_packets);
+}
+
+void CachedSignalSource::record(const SignalCacheKey& key) {
+    wire::encode_signals(m_packets, m_value);
+    m_cache->insert(key, m_value);
+}
@@ -0,0 +1,240 @@
+// src/signals/PipelinedIPCSource.cpp
+
+#include "signals/PipelinedIPCSource.h"
+#include "signals/SignalAggregation.h"
+#include "checkpoint/Checkpoint.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+PipelinedIPCSource::PipelinedIPCSource(const std::vector<std::string>& model_endpoints,
+                                       std::chrono::milliseconds reply_timeout,
+                                       std::size_t max_in_flight,
+                                       std::unique_ptr<ISignalAggregator> aggregator)
+    : m_context(1),
+      m_reply_timeout(reply_timeout),
+      m_max_in_flight(max_in_flight),
+      m_aggregator(aggregator ? std::move(aggregator) : std::make_unique<WeightedMeanAggregator>())
+{
+    if (m_max_in_flight == 0) {
+        throw std::invalid_argument("PipelinedIPCSource needs max_in_flight >= 1");
+    }
+
+    m_sockets.reserve(model_endpoints.size());
+    for (std::size_t i = 0; i < model_endpoints.size(); ++i) {
+        const std::string& endpoint = model_endpoints[i];
+        LOG_INFO("PipelinedIPCSource", "Connecting DEALER socket to {}", endpoint);
+        m_sockets.emplace_back(m_context, zmq::socket_type::dealer);
+        m_sockets.back().set(zmq::sockopt::linger, 0);
+        m_sockets.back().connect(endpoint);
+
+        const std::string model = "model[" + std::to_string(i) + "] " + endpoint;
+        m_reply_latency.push_back(&m_metrics.histogram(model + " reply"));
+        m_timeouts.push_back(&m_metrics.counter(model + " timeouts"));
+    }
+
+    // The poll set never changes, so it is built once
+    for (auto& socket : m_sockets) {
+        m_poll_items.push_back({socket, 0, ZMQ_POLLIN, 0});
+    }
+    m_wire_formats.assign(m_sockets.size(), wire::ReplyFormat::Json); // Upgraded on the first binary reply
+    m_causal_models.assign(m_sockets.size(), false);
+    m_pending.resize(m_max_in_flight); // The event loop never keeps more in flight
+}
+
+bool PipelinedIPCSource::models_stateless() const {
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        if (m_wire_formats[i] != wire::ReplyFormat::Binary || !m_causal_models[i]) {
+            return false;
+        }
+    }
+    return !m_sockets.empty();
+}
+
+void PipelinedIPCSource::save_state(StateWriter& out) const {
+    out.write(m_next_request_id);
+}
+
+void PipelinedIPCSource::restore_state(StateReader& in) {
+    in.read(m_next_request_id);
+}
+
+void PipelinedIPCSource::update_market_data(const nlohmann::json& market_data) {
+    m_latest_market_data = market_data;
+    send_request(nullptr); // Raw JSON can only be forwarded as JSON
+}
+
+void PipelinedIPCSource::update_market_bar(const DataBar& bar) {
+    send_request(&bar);
+}
+
+std::map<std::string, double> PipelinedIPCSource::get_target_portfolio() {
+    return aggregate_signals(collect_oldest(), *m_aggregator);
+}
+
+void PipelinedIPCSource::get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) {
+    m_signal_matrix.load(collect_oldest(), registry);
+    m_aggregator->aggregate(m_signal_matrix, target_weights);
+}
+
+void PipelinedIPCSource::send_request(const DataBar* bar) {
+    // --- 1. Encode (each encoding only if some model needs it) ---
+    bool any_json = (bar == nullptr);
+    bool any_binary = false;
+    for (wire::ReplyFormat format : m_wire_formats) {
+        any_json = any_json || format == wire::ReplyFormat::Json;
+        any_binary = any_binary || format == wire::ReplyFormat::Binary;
+    }
+
+    if (bar && any_binary) {
+        wire::encode_market_data(*bar, m_binary_request);
+    }
+    if (any_json) {
+        if (bar) {
+            wire::encode_json_market_data(*bar, m_json_request);
+        } else {
+            m_json_request = m_latest_market_data.dump();
+        }
+    }
+
+    // --- 2. Send [request_id, <empty>, payload] to every model ---
+    const auto now = std::chrono::steady_clock::now();
+    PendingRequest& request = push_pending();
+    request.request_id = m_next_request_id++;
+    request.sent_at = now;
+    request.deadline = now + m_reply_timeout;
+    request.awaiting.assign(m_sockets.size(), false);
+    request.replies_expected = 0;
+    request.replies_received = 0;
+    reset_model_replies(request.replies, m_sockets.size());
+
+    for (std::size_t i = 0; i < m_sockets.size(); ++i) {
+        const bool binary = bar && m_wire_formats[i] == wire::ReplyFormat::Binary;
+        const std::string& payload = binary ? m_binary_request : m_json_request;
+
+        auto& socket = m_sockets[i];
+        auto sent = socket.send(zmq::buffer(&request.request_id, sizeof(request.request_id)),
+                                zmq::send_flags::sndmore | zmq::send_flags::dontwait);
+        if (!sent) {
+            // The model's queue is full: do not wait for a reply that cannot come
+            LOG_WARN("PipelinedIPCSource", "WARNING: Model {} is backlogged, skipping request {}.", i, request.request_id);
+            continue;
+        }
+        // Once the first frame is queued, the rest of the message is queued atomically
+        socket.send(zmq::message_t(), zmq::send_flags::sndmore);
+        socket.send(zmq::buffer(payload), zmq::send_flags::none);
+        request.awaiting[i] = true;
+        ++request.replies_expected;
+    }
+}
+
+PipelinedIPCSource::PendingRequest& PipelinedIPCSource::push_pending() {
+    if (m_pending_count == m_pending.size()) {
+        // Full (a caller running further ahead than max_in_flight): unwrap, then grow
+        std::rotate(m_pending.begin(), m_pending.begin() + m_pending_head, m_pending.end());
+        m_pending_head = 0;
+        m_pending.emplace_back();
+    }
+    return m_pending[(m_pending_head + m_pending_count++) % m_pending.size()];
+}
+
+void PipelinedIPCSource::drain_socket(std::size_t model_index) {
+    auto& socket = m_sockets[model_index];
+    while (true) {
+        // Envelope: [request_id, <empty>, payload], received into reused frames
+        if (!socket.recv(m_id_frame, zmq::recv_flags::dontwait)) {
+            return; // Nothing more ready
+        }
+
+        std::size_t frames = 1;
+        bool more = m_id_frame.more();
+        while (more) {
+            zmq::message_t& frame = frames == 1 ? m_delimiter_frame : frames == 2 ? m_payload_frame : m_extra_frame;
+            (void)socket.recv(frame, zmq::recv_flags::none);
+            more = frame.more();
+            ++frames;
+        }
+
+        if (m_id_frame.size() != sizeof(std::uint64_t) || frames != 3 || m_delimiter_frame.size() != 0) {
+            LOG_ERROR("PipelinedIPCSource", "ERROR: Malformed reply envelope from model {}.", model_index);
+            continue;
+        }
+
+        std::uint64_t request_id = 0;
+        std::memcpy(&request_id, m_id_frame.data(), sizeof(request_id));
+
+        // Late replies belong to requests that were already returned (timed out)
+        if (m_pending_count == 0 || request_id < m_pending[m_pending_head].request_id) {
+            ++m_late_replies;
+            continue;
+        }
+        std::uint64_t slot = request_id - m_pending[m_pending_head].request_id;
+        if (slot >= m_pending_count) {
+            LOG_ERROR("PipelinedIPCSource", "ERROR: Reply for unknown request {}.", request_id);
+            continue;
+        }
+
+        PendingRequest& pending = m_pending[(m_pending_head + slot) % m_pending.size()];
+        if (!pending.awaiting[model_index]) {
+            ++m_late_replies; // A duplicate, which must not answer the request for another model
+            continue;
+        }
+        m_reply_latency[model_index]->record(std::chrono::steady_clock::now() - pending.sent_at);
+        pending.awaiting[model_index] = false;
+        const zmq::message_t& payload = m_payload_frame;
+        try {
+            if (wire::store_reply(payload.data(), payload.size(), pending.replies[model_index]) == wire::ReplyFormat::Binary) {
+                m_wire_formats[model_index] = wire::ReplyFormat::Binary;
+                m_causal_models[model_index] = wire::message_flags(payload.data(), payload.size()) & wire::kFlagCausal;
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("PipelinedIPCSource", "ERROR parsing reply: {}", e.what());
+        }
+        ++pending.replies_received; // A malformed reply still answers the request
+    }
+}
+
+const ModelReplies& PipelinedIPCSource::collect_oldest() {
+    if (m_pending_count == 0) {
+        LOG_ERROR("PipelinedIPCSource", "ERROR: get_target_portfolio() called without an outstanding request.");
+        m_last_result_complete = false;
+        return m_no_signals;
+    }
+
+    PendingRequest& oldest = m_pending[m_pending_head];
+    while (true) {
+        if (oldest.replies_received >= oldest.replies_expected) {
+            break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= oldest.deadline) {
+            m_timed_out_replies += oldest.replies_expected - oldest.replies_received;
+            for (std::size_t i = 0; i < oldest.awaiting.size(); ++i) {
+                if (oldest.awaiting[i]) {
+                    ++*m_timeouts[i];
+                }
+            }
+            break;
+        }
+
+        // Wait for any socket to become readable, but never past the oldest deadline
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(oldest.deadline - now);
+        zmq::poll(m_poll_items, wait);
+        for (std::size_t i = 0; i < m_poll_items.size(); ++i) {
+            if (m_poll_items[i].revents & ZMQ_POLLIN) {
+                drain_socket(i);
+            }
+        }
+    }
+
+    // The slot is only reused by the next send_request()
+    m_pending_head = (m_pending_head + 1) % m_pending.size();
+    --m_pending_count;
+    m_last_result_complete = all_models_replied(oldest.replies);
+
+    LOG_DEBUG("PipelinedIPCSource", "Request {} complete. Received {}/{} replies.",
+              oldest.request_id, oldest.replies_received, m_sockets.size());
+    return oldest.replies;
+}
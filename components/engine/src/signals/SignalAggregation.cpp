@@ -0,0 +1,189 @@
+// src/signals/SignalAggregation.cpp
+
+#include "signals/SignalAggregation.h"
+#include "signals/WireProtocol.h"
+#include "logging/Logger.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    // Symbols gathered per pass of RankAggregator: one row slice of each model
+    // (512 bytes) is read at a time instead of striding down whole columns.
+    constexpr std::size_t kBlockSymbols = 64;
+}
+
+void WeightedMeanAggregator::aggregate(const SignalMatrix& signals, WeightVector& target_weights) {
+    const std::size_t symbols = signals.symbols();
+    target_weights.assign(symbols, 0.0);
+    m_total_confidences.assign(symbols, 0.0);
+    double* sums = target_weights.data();
+    double* totals = m_total_confidences.data();
+
+    // 1. Accumulate weighted sums and total confidences, one model row at a time
+    for (const std::uint32_t model : signals.active_models()) {
+        const double* weights = signals.weights(model);
+        const double* confidences = signals.confidences(model);
+        for (std::size_t i = 0; i < symbols; ++i) {
+            sums[i] += weights[i] * confidences[i];
+            totals[i] += confidences[i];
+        }
+    }
+
+    // 2. Calculate the final weighted average for each asset
+    for (std::size_t i = 0; i < symbols; ++i) {
+        sums[i] = totals[i] > 1e-9 ? sums[i] / totals[i] : 0.0; // Avoid division by zero
+    }
+}
+
+void RankAggregator::aggregate(const SignalMatrix& signals, WeightVector& target_weights) {
+    const std::size_t symbols = signals.symbols();
+    const std::size_t models = signals.active_models().size();
+    target_weights.assign(symbols, 0.0);
+    if (models == 0) {
+        return;
+    }
+    m_values.resize(kBlockSymbols * models);
+    m_counts.resize(kBlockSymbols);
+
+    for (std::size_t begin = 0; begin < symbols; begin += kBlockSymbols) {
+        const std::size_t width = std::min(kBlockSymbols, symbols - begin);
+        std::fill(m_counts.begin(), m_counts.begin() + width, 0u);
+
+        // 1. Gather each symbol's weights into its own column of m_values
+        for (const std::uint32_t model : signals.active_models()) {
+            const double* weights = signals.weights(model) + begin;
+            const double* confidences = signals.confidences(model) + begin;
+            for (std::size_t j = 0; j < width; ++j) {
+                if (confidences[j] > 0.0) {
+                    m_values[j * models + m_counts[j]++] = weights[j];
+                }
+            }
+        }
+
+        // 2. Reduce every column that has at least one opinion
+        for (std::size_t j = 0; j < width; ++j) {
+            if (m_counts[j] > 0) {
+                target_weights[begin + j] = combine({m_values.data() + j * models, m_counts[j]});
+            }
+        }
+    }
+}
+
+double MedianAggregator::combine(std::span<double> values) const {
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    if (values.size() % 2 == 1) {
+        return *middle;
+    }
+    // Even count: average the two central values; the lower one is the largest of the lower half
+    return 0.5 * (*middle + *std::max_element(values.begin(), middle));
+}
+
+TrimmedMeanAggregator::TrimmedMeanAggregator(double trim_fraction)
+    : m_trim_fraction(trim_fraction)
+{
+    if (!(trim_fraction >= 0.0 && trim_fraction < 0.5)) {
+        throw std::invalid_argument("TrimmedMeanAggregator needs 0 <= trim_fraction < 0.5");
+    }
+}
+
+double TrimmedMeanAggregator::combine(std::span<double> values) const {
+    const std::size_t count = values.size();
+    const auto trim = static_cast<std::size_t>(m_trim_fraction * static_cast<double>(count));
+    if (trim > 0) {
+        // Two partial selections instead of a sort: the lowest `trim` values end
+        // up before begin+trim, the highest `trim` at or after end-trim
+        std::nth_element(values.begin(), values.begin() + trim, values.end());
+        std::nth_element(values.begin() + trim, values.end() - trim, values.end());
+    }
+    const double sum = std::accumulate(values.begin() + trim, values.end() - trim, 0.0);
+    return sum / static_cast<double>(count - 2 * trim);
+}
+
+namespace {
+    // Runs `aggregator` on `matrix`, keeping only symbols at least one model has an opinion on.
+    std::map<std::string, double> aggregate_to_map(const SignalMatrix& matrix, const SymbolRegistry& registry,
+                                                   ISignalAggregator& aggregator) {
+        WeightVector weights;
+        aggregator.aggregate(matrix, weights);
+
+        std::map<std::string, double> aggregated_portfolio;
+        for (SymbolId id = 0; id < registry.size(); ++id) {
+            for (const std::uint32_t model : matrix.active_models()) {
+                if (matrix.confidences(model)[id] > 0.0) {
+                    aggregated_portfolio.emplace(registry.name(id), weights[id]);
+                    break;
+                }
+            }
+        }
+        return aggregated_portfolio;
+    }
+}
+
+std::unique_ptr<ISignalAggregator> make_signal_aggregator(std::string_view method, double trim_fraction) {
+    if (method == "mean") {
+        return std::make_unique<WeightedMeanAggregator>();
+    }
+    if (method == "median") {
+        return std::make_unique<MedianAggregator>();
+    }
+    if (method == "trimmed_mean") {
+        return std::make_unique<TrimmedMeanAggregator>(trim_fraction);
+    }
+    throw std::invalid_argument("Unknown signal aggregation method: " + std::string(method));
+}
+
+std::map<std::string, double> aggregate_signals(const ModelSignals& signals, ISignalAggregator& aggregator) {
+    SymbolRegistry registry;
+    for (const auto& packets : signals) {
+        for (const auto& packet : packets) {
+            registry.intern(packet.symbol);
+        }
+    }
+
+    SignalMatrix matrix;
+    matrix.load(signals, registry);
+    return aggregate_to_map(matrix, registry, aggregator);
+}
+
+std::map<std::string, double> aggregate_signals(const ModelReplies& replies, ISignalAggregator& aggregator) {
+    SymbolRegistry registry;
+    for (const std::string& reply : replies) {
+        const std::uint32_t count = reply.empty() ? 0 : wire::signal_count(reply.data(), reply.size());
+        for (std::uint32_t i = 0; i < count; ++i) {
+            registry.intern(wire::record_symbol(wire::signal_record(reply.data(), i)));
+        }
+    }
+
+    SignalMatrix matrix;
+    matrix.load(replies, registry);
+    return aggregate_to_map(matrix, registry, aggregator);
+}
+
+std::map<std::string, double> aggregate_signals(const std::vector<SignalPacket>& packets) {
+    if (packets.empty()) {
+        return {};
+    }
+
+    std::map<std::string, double> weighted_sums;
+    std::map<std::string, double> total_confidences;
+
+    // 1. Accumulate weighted sums and total confidences for each asset
+    for (const auto& packet : packets) {
+        weighted_sums[packet.symbol] += packet.target_weight * packet.confidence;
+        total_confidences[packet.symbol] += packet.confidence;
+    }
+
+    // 2. Calculate the final weighted average for each asset
+    std::map<std::string, double> aggregated_portfolio;
+    for (const auto& pair : weighted_sums) {
+        const std::string& asset = pair.first;
+        if (total_confidences[asset] > 1e-9) { // Avoid division by zero
+            aggregated_portfolio[asset] = weighted_sums[asset] / total_confidences[asset];
+        }
+    }
+
+    LOG_DEBUG("IPCSource", "Aggregation complete on {} signals.", packets.size());
+    return aggregated_portfolio;
+}
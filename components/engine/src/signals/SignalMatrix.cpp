@@ -0,0 +1,113 @@
+// src/signals/SignalMatrix.cpp
+
+#include "signals/SignalMatrix.h"
+#include "signals/WireProtocol.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+void SignalMatrix::reset(std::size_t models, std::size_t symbols) {
+    if (models * symbols > m_weights.size()) {
+        m_weights.resize(models * symbols);
+        m_confidences.resize(models * symbols);
+    }
+    if (models > m_symbol_cache.size()) {
+        m_symbol_cache.resize(models);
+        m_record_cache.resize(models);
+    }
+    m_models = models;
+    m_symbols = symbols;
+    m_active_models.clear();
+}
+
+void SignalMatrix::clear_row(std::size_t model) {
+    double* weights = m_weights.data() + model * m_symbols;
+    double* confidences = m_confidences.data() + model * m_symbols;
+    std::fill(weights, weights + m_symbols, 0.0);
+    std::fill(confidences, confidences + m_symbols, 0.0);
+}
+
+void SignalMatrix::add_signal(std::size_t model, SymbolId id, double target_weight, double confidence) {
+    if (id == kInvalidSymbolId || id >= m_symbols || !(confidence > 0.0)) {
+        return; // Unknown symbol (no price to trade it at) or no opinion
+    }
+
+    double* weights = m_weights.data() + model * m_symbols;
+    double* confidences = m_confidences.data() + model * m_symbols;
+    const double previous = confidences[id];
+    const double total = previous + confidence;
+    weights[id] = (weights[id] * previous + target_weight * confidence) / total;
+    confidences[id] = total;
+}
+
+void SignalMatrix::set_model(std::size_t model, const std::vector<SignalPacket>& packets,
+                             const SymbolRegistry& registry) {
+    clear_row(model);
+    std::vector<SymbolId>& cache = m_symbol_cache[model];
+    cache.resize(packets.size(), kInvalidSymbolId);
+
+    for (std::size_t i = 0; i < packets.size(); ++i) {
+        const SignalPacket& packet = packets[i];
+        SymbolId& id = cache[i];
+        if (id == kInvalidSymbolId || id >= registry.size() || registry.name(id) != packet.symbol) {
+            id = registry.find(packet.symbol);
+        }
+        add_signal(model, id, packet.target_weight, packet.confidence);
+    }
+
+    m_active_models.push_back(static_cast<std::uint32_t>(model));
+}
+
+void SignalMatrix::set_model(std::size_t model, const std::string& reply, const SymbolRegistry& registry) {
+    const std::uint32_t count = wire::signal_count(reply.data(), reply.size());
+    if (&registry != m_record_cache_registry) {
+        for (auto& cache : m_record_cache) {
+            cache.clear();
+        }
+        m_record_cache_registry = &registry;
+    }
+
+    clear_row(model);
+    std::vector<RecordSymbol>& cache = m_record_cache[model];
+    cache.resize(count);
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        // Fields are read in place: copying each record out and measuring its
+        // symbol cost more than the rest of the load
+        const char* record = wire::signal_record_at(reply.data(), i);
+        const char* symbol = record + offsetof(wire::SignalRecord, symbol);
+        RecordSymbol& cached = cache[i];
+        if (cached.id == kInvalidSymbolId || std::memcmp(cached.symbol, symbol, sizeof(cached.symbol)) != 0) {
+            std::memcpy(cached.symbol, symbol, sizeof(cached.symbol));
+            cached.id = registry.find(std::string_view(symbol, strnlen(symbol, sizeof(cached.symbol))));
+        }
+
+        double target_weight;
+        double confidence;
+        std::memcpy(&target_weight, record + offsetof(wire::SignalRecord, target_weight), sizeof(target_weight));
+        std::memcpy(&confidence, record + offsetof(wire::SignalRecord, confidence), sizeof(confidence));
+        add_signal(model, cached.id, target_weight, confidence);
+    }
+
+    m_active_models.push_back(static_cast<std::uint32_t>(model));
+}
+
+void SignalMatrix::load(const ModelSignals& signals, const SymbolRegistry& registry) {
+    reset(signals.size(), registry.size());
+    for (std::size_t model = 0; model < signals.size(); ++model) {
+        if (!signals[model].empty()) {
+            set_model(model, signals[model], registry);
+        }
+    }
+}
+
+void SignalMatrix::load(const ModelReplies& replies, const SymbolRegistry& registry) {
+    reset(replies.size(), registry.size());
+    for (std::size_t model = 0; model < replies.size(); ++model) {
+        // A reply without records counts as silent, as an empty packet list does
+        const std::string& reply = replies[model];
+        if (reply.size() > sizeof(wire::MessageHeader)) {
+            set_model(model, reply, registry);
+        }
+    }
+}
@@ -0,0 +1,224 @@
+// src/signals/SignalReplyCache.cpp
+
+#include "signals/SignalReplyCache.h"
+#include "data/ColumnarBarFormat.h"
+#include "logging/Logger.h"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr std::size_t kRecordAlignment = 8;
+
+    std::size_t padded(std::size_t size) {
+        return (size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+    }
+
+    // splitmix64's finalizer
+    std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Two independently mixed 64-bit lanes over the bytes, 8 at a time. Not
+    // cryptographic: it only has to keep distinct requests apart.
+    SignalCacheKey hash_bytes(std::uint64_t seed, std::string_view bytes) {
+        std::uint64_t low = mix(seed ^ 0x9e3779b97f4a7c15ULL);
+        std::uint64_t high = mix(seed + bytes.size());
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            low = mix(low ^ word);
+            high = mix(high + word * 0xff51afd7ed558ccdULL);
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+        low = mix(low ^ tail ^ bytes.size());
+        high = mix(high + tail);
+        return {mix(low ^ high), high};
+    }
+}
+
+SignalReplyCache::SignalReplyCache(const std::string& path, std::string_view model_key, SignalCacheMode mode)
+    : m_path(path),
+      m_mode(mode),
+      m_model_key_hash(hash_bytes(0, model_key).low)
+{
+    if (m_mode == SignalCacheMode::Invalidate) {
+        fs::remove(m_path);
+        LOG_INFO("SignalReplyCache", "Discarded the signal cache {}.", m_path);
+    }
+
+    std::error_code error;
+    const auto file_size = fs::file_size(m_path, error);
+    const std::size_t valid_size = error ? 0 : load(static_cast<std::size_t>(file_size));
+    if (m_other_models) {
+        m_mode = SignalCacheMode::ReadOnly; // Another model set's log is never discarded implicitly
+    }
+    const bool read_only = m_mode == SignalCacheMode::ReadOnly;
+
+    if (!error && !m_other_models && valid_size < file_size) {
+        if (read_only) {
+            LOG_WARN("SignalReplyCache", "WARNING: {} has {} unreadable bytes at its end.", m_path,
+                     file_size - valid_size);
+        } else {
+            // Cut back to the last good record, so new records follow it
+            LOG_WARN("SignalReplyCache", "WARNING: Truncating {} from {} to {} bytes.", m_path, file_size, valid_size);
+            fs::resize_file(m_path, valid_size);
+        }
+    }
+
+    if (!read_only) {
+        m_out.open(m_path, std::ios::binary | std::ios::app);
+        if (!m_out) {
+            unload();
+            throw std::runtime_error("Cannot open signal cache " + m_path + " for writing");
+        }
+        if (valid_size == 0) {
+            SignalCacheFileHeader header{};
+            std::memcpy(header.magic, kSignalCacheMagic, sizeof(header.magic));
+            header.version = kSignalCacheVersion;
+            header.model_key_hash = m_model_key_hash;
+            m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            m_out.flush();
+        }
+    }
+    LOG_INFO("SignalReplyCache", "Signal cache {}: {} recorded replies{}.", m_path, m_index.size(),
+             read_only ? " (read-only)" : "");
+}
+
+SignalReplyCache::~SignalReplyCache() {
+    try {
+        flush();
+    } catch (const std::exception& e) {
+        LOG_ERROR("SignalReplyCache", "ERROR: {}", e.what());
+    }
+    unload();
+}
+
+std::size_t SignalReplyCache::load(std::size_t file_size) {
+    if (file_size == 0) {
+        return 0;
+    }
+
+    int fd = ::open(m_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open signal cache " + m_path);
+    }
+    void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file contents alive.
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot mmap signal cache " + m_path);
+    }
+    m_mapping = static_cast<const std::uint8_t*>(mapping);
+    m_mapping_size = file_size;
+
+    SignalCacheFileHeader header{};
+    if (file_size < sizeof(header)) {
+        unload();
+        return 0; // Cut short before its first record: recorded afresh
+    }
+    std::memcpy(&header, m_mapping, sizeof(header));
+    if (std::memcmp(header.magic, kSignalCacheMagic, sizeof(header.magic)) != 0) {
+        unload();
+        throw std::runtime_error(m_path + " is not a signal cache");
+    }
+    if (header.version != kSignalCacheVersion) {
+        unload();
+        throw std::runtime_error(m_path + " has signal cache version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(kSignalCacheVersion));
+    }
+    if (header.model_key_hash != m_model_key_hash) {
+        LOG_WARN("SignalReplyCache", "WARNING: {} was recorded for other models (or model versions); "
+                 "its replies are not used and nothing is recorded. Use another cache file, or discard "
+                 "this one (--refresh-signals).", m_path);
+        unload();
+        m_other_models = true;
+        return 0;
+    }
+
+    // Replays are read back in the order they were recorded
+    ::madvise(mapping, m_mapping_size, MADV_SEQUENTIAL);
+
+    std::size_t offset = sizeof(header);
+    while (file_size - offset >= sizeof(SignalCacheRecordHeader)) {
+        SignalCacheRecordHeader record{};
+        std::memcpy(&record, m_mapping + offset, sizeof(record));
+        const std::size_t value_offset = offset + sizeof(record);
+        const std::size_t record_end = offset + padded(sizeof(record) + record.value_size);
+        if (record_end > file_size || crc32(m_mapping + value_offset, record.value_size) != record.value_crc32) {
+            break;
+        }
+        m_index.emplace(SignalCacheKey{record.key_low, record.key_high}, ValueLocation{value_offset, record.value_size});
+        offset = record_end;
+    }
+    return offset;
+}
+
+void SignalReplyCache::unload() {
+    if (m_mapping) {
+        ::munmap(const_cast<std::uint8_t*>(m_mapping), m_mapping_size);
+    }
+    m_mapping = nullptr;
+    m_mapping_size = 0;
+    m_index.clear();
+}
+
+SignalCacheKey SignalReplyCache::key_of(std::string_view payload) const {
+    return hash_bytes(m_model_key_hash, payload);
+}
+
+bool SignalReplyCache::find(const SignalCacheKey& key, std::string& value) const {
+    const auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(m_mapping + it->second.offset), it->second.size);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void SignalReplyCache::insert(const SignalCacheKey& key, std::string_view value) {
+    if (m_mode == SignalCacheMode::ReadOnly || m_index.contains(key)) {
+        return;
+    }
+
+    SignalCacheRecordHeader record{};
+    record.key_low = key.low;
+    record.key_high = key.high;
+    record.value_size = static_cast<std::uint32_t>(value.size());
+    record.value_crc32 = crc32(value.data(), value.size());
+    const char padding[kRecordAlignment] = {};
+
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    if (!m_appended.insert(key).second) {
+        return; // Another run of a sweep recorded it first
+    }
+    m_out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    m_out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    m_out.write(padding, static_cast<std::streamsize>(padded(sizeof(record) + value.size()) - sizeof(record) - value.size()));
+    if (!m_out) {
+        throw std::runtime_error("Cannot write signal cache " + m_path);
+    }
+}
+
+void SignalReplyCache::flush() {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    if (m_out.is_open()) {
+        m_out.flush();
+        if (!m_out) {
+            throw std::runtime_error("Cannot write signal cache " + m_path);
+        }
+    }
+}
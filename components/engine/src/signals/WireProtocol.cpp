@@ -0,0 +1,246 @@
+// src/signals/WireProtocol.cpp
+
+#include "signals/WireProtocol.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace wire {
+
+namespace {
+    MessageHeader make_header(MessageType type, std::size_t count) {
+        return MessageHeader{kMagic, kVersion, static_cast<uint16_t>(type), static_cast<uint32_t>(count), 0};
+    }
+
+    void copy_symbol(char (&dest)[16], const std::string& symbol) {
+        std::memset(dest, 0, sizeof(dest));
+        std::memcpy(dest, symbol.data(), std::min(symbol.size(), sizeof(dest)));
+    }
+
+    void check_signal_type(uint8_t signal_type) {
+        if (signal_type > static_cast<uint8_t>(SignalType::Flat)) {
+            throw std::runtime_error("Invalid signal_type " + std::to_string(signal_type));
+        }
+    }
+
+    // Validates a Signals message and calls `fn(record)` for each record.
+    template <typename Fn>
+    void for_each_signal_record(const void* data, std::size_t size, Fn&& fn) {
+        const uint32_t count = signal_count(data, size);
+        for (uint32_t i = 0; i < count; ++i) {
+            const SignalRecord record = signal_record(data, i);
+            check_signal_type(record.signal_type);
+            fn(record);
+        }
+    }
+
+    // A number as nlohmann::json writes it: shortest round-trip digits, with a
+    // fraction or exponent so it reads back as a float; null if not finite.
+    void append_json_number(double value, std::string& out) {
+        if (!std::isfinite(value)) {
+            out += "null";
+            return;
+        }
+        char buffer[32];
+        char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        out.append(buffer, static_cast<std::size_t>(end - buffer));
+        if (std::none_of(buffer, end, [](char c) { return c == '.' || c == 'e'; })) {
+            out += ".0";
+        }
+    }
+
+    void append_json_string(const std::string& text, std::string& out) {
+        out += '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+                out += escape;
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    SignalPacket to_packet(const SignalRecord& record) {
+        return SignalPacket(std::string(record_symbol(record)),
+                            static_cast<SignalType>(record.signal_type),
+                            record.target_weight,
+                            record.confidence);
+    }
+}
+
+bool is_binary_message(const void* data, std::size_t size) {
+    uint32_t magic = 0;
+    if (size < sizeof(MessageHeader)) {
+        return false;
+    }
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == kMagic;
+}
+
+uint32_t message_flags(const void* data, std::size_t size) {
+    if (!is_binary_message(data, size)) {
+        return 0;
+    }
+    MessageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.flags;
+}
+
+uint32_t signal_count(const void* data, std::size_t size) {
+    if (!is_binary_message(data, size)) {
+        throw std::runtime_error("Not a binary wire message");
+    }
+
+    MessageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != kVersion) {
+        throw std::runtime_error("Unsupported wire version " + std::to_string(header.version));
+    }
+    if (header.type != static_cast<uint16_t>(MessageType::Signals)) {
+        throw std::runtime_error("Expected a Signals message, got type " + std::to_string(header.type));
+    }
+    if (size < sizeof(header) + std::size_t{header.count} * sizeof(SignalRecord)) {
+        throw std::runtime_error("Truncated Signals message");
+    }
+    return header.count;
+}
+
+void encode_market_data(const DataBar& bar, std::string& out) {
+    encode_market_data_batch(std::span<const DataBar>(&bar, 1), out);
+}
+
+void encode_market_data_batch(std::span<const DataBar> bars, std::string& out) {
+    MessageHeader header = make_header(MessageType::MarketData, bars.size());
+
+    out.resize(sizeof(header) + bars.size() * sizeof(MarketDataRecord));
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    char* cursor = out.data() + sizeof(header);
+    for (const DataBar& bar : bars) {
+        MarketDataRecord record{};
+        copy_symbol(record.symbol, bar.symbol);
+        record.timestamp_epoch_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(bar.timestamp.time_since_epoch()).count());
+        record.open = bar.open;
+        record.high = bar.high;
+        record.low = bar.low;
+        record.close = bar.close;
+        record.volume = bar.volume;
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+}
+
+void encode_signals(const std::vector<SignalPacket>& packets, std::string& out, uint32_t flags) {
+    MessageHeader header = make_header(MessageType::Signals, packets.size());
+    header.flags = flags;
+
+    out.resize(sizeof(header) + packets.size() * sizeof(SignalRecord));
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    char* cursor = out.data() + sizeof(header);
+    for (const auto& packet : packets) {
+        SignalRecord record{};
+        copy_symbol(record.symbol, packet.symbol);
+        record.target_weight = packet.target_weight;
+        record.confidence = packet.confidence;
+        record.signal_type = static_cast<uint8_t>(packet.signal_type);
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+}
+
+void decode_signals(const void* data, std::size_t size, std::vector<SignalPacket>& out) {
+    for_each_signal_record(data, size, [&](const SignalRecord& record) {
+        out.push_back(to_packet(record));
+    });
+}
+
+void decode_signal_batch(const void* data, std::size_t size,
+                         std::vector<std::vector<SignalPacket>>& per_bar) {
+    for_each_signal_record(data, size, [&](const SignalRecord& record) {
+        if (record.bar_index >= per_bar.size()) {
+            throw std::runtime_error("bar_index " + std::to_string(record.bar_index) + " outside the batch");
+        }
+        per_bar[record.bar_index].push_back(to_packet(record));
+    });
+}
+
+void split_signal_batch(const void* data, std::size_t size, std::vector<std::string>& per_bar) {
+    // A bar without records was still answered: it gets a message with no signals, not none
+    const MessageHeader empty_header = make_header(MessageType::Signals, 0);
+    for (std::string& message : per_bar) {
+        message.assign(reinterpret_cast<const char*>(&empty_header), sizeof(empty_header));
+    }
+    const uint32_t flags = message_flags(data, size);
+    for_each_signal_record(data, size, [&](const SignalRecord& record) {
+        if (record.bar_index >= per_bar.size()) {
+            throw std::runtime_error("bar_index " + std::to_string(record.bar_index) + " outside the batch");
+        }
+        per_bar[record.bar_index].append(reinterpret_cast<const char*>(&record), sizeof(record));
+    });
+
+    // Each message's header still says 0 records
+    for (std::string& message : per_bar) {
+        MessageHeader header = make_header(MessageType::Signals, (message.size() - sizeof(header)) / sizeof(SignalRecord));
+        header.flags = flags;
+        std::memcpy(message.data(), &header, sizeof(header));
+    }
+}
+
+void encode_json_market_data(const DataBar& bar, std::string& out) {
+    // Written out directly: building a nlohmann::json object allocates per key, every bar.
+    // Same message as json{...}.dump(), keys in its (sorted) order.
+    out.clear();
+    out += "{\"close\":";
+    append_json_number(bar.close, out);
+    out += ",\"symbol\":";
+    append_json_string(bar.symbol, out);
+    out += ",\"wire_version\":";
+    char version[8];
+    const char* version_end = std::to_chars(version, version + sizeof(version), kVersion).ptr;
+    out.append(version, static_cast<std::size_t>(version_end - version));
+    out += '}';
+}
+
+ReplyFormat decode_reply(const void* data, std::size_t size, std::vector<SignalPacket>& out) {
+    if (is_binary_message(data, size)) {
+        decode_signals(data, size, out);
+        return ReplyFormat::Binary;
+    }
+
+    const char* text = static_cast<const char*>(data);
+    out.push_back(nlohmann::json::parse(text, text + size).get<SignalPacket>());
+    return ReplyFormat::Json;
+}
+
+ReplyFormat store_reply(const void* data, std::size_t size, std::string& out) {
+    out.clear();
+    if (is_binary_message(data, size)) {
+        // Validated once here, so readers of `out` only check the header
+        const uint32_t count = signal_count(data, size);
+        for (uint32_t i = 0; i < count; ++i) {
+            check_signal_type(static_cast<uint8_t>(signal_record_at(data, i)[offsetof(SignalRecord, signal_type)]));
+        }
+        out.assign(static_cast<const char*>(data), size);
+        return ReplyFormat::Binary;
+    }
+
+    const char* text = static_cast<const char*>(data);
+    const std::vector<SignalPacket> packets{nlohmann::json::parse(text, text + size).get<SignalPacket>()};
+    encode_signals(packets, out);
+    return ReplyFormat::Json;
+}
+
+} // namespace wire
@@ -0,0 +1,152 @@
+// src/sweep/ParameterSweep.cpp
+
+#include "sweep/ParameterSweep.h"
+#include "BasicEventLoop.h"
+#include "core/Portfolio.h"
+#include "core/WorkStealingPool.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "risk/PortfolioRiskManager.h"
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    // Only the signal source varies between sweeps; the rest is called without virtual dispatch
+    using SweepEventLoop = BasicEventLoop<InMemoryBarProvider, ISignalSource, PortfolioRiskManager, BacktestExecutionHandler>;
+
+    std::vector<double> read_axis(const nlohmann::json& grid, const char* name, double default_value) {
+        if (!grid.contains(name)) {
+            return {default_value};
+        }
+        auto values = grid.at(name).get<std::vector<double>>();
+        if (values.empty()) {
+            throw std::invalid_argument(std::string("Sweep axis '") + name + "' is empty");
+        }
+        return values;
+    }
+}
+
+ParameterGrid ParameterGrid::from_json(const nlohmann::json& grid, const SweepParameters& defaults) {
+    ParameterGrid result;
+    result.max_position_weight = read_axis(grid, "max_position_weight", defaults.max_position_weight);
+    result.max_leverage = read_axis(grid, "max_leverage", defaults.max_leverage);
+    result.max_drawdown = read_axis(grid, "max_drawdown", defaults.max_drawdown);
+    result.commission_per_trade = read_axis(grid, "commission_per_trade", defaults.commission_per_trade);
+    result.slippage_percentage = read_axis(grid, "slippage_percentage", defaults.slippage_percentage);
+    result.target_volatility = read_axis(grid, "target_volatility", defaults.target_volatility);
+    return result;
+}
+
+std::vector<SweepParameters> ParameterGrid::expand() const {
+    std::vector<SweepParameters> sets;
+    sets.reserve(max_position_weight.size() * max_leverage.size() * max_drawdown.size()
+                 * commission_per_trade.size() * slippage_percentage.size() * target_volatility.size());
+
+    for (double position_weight : max_position_weight)
+    for (double leverage : max_leverage)
+    for (double drawdown : max_drawdown)
+    for (double commission : commission_per_trade)
+    for (double slippage : slippage_percentage)
+    for (double volatility : target_volatility) {
+        sets.push_back({position_weight, leverage, drawdown, commission, slippage, volatility});
+    }
+    return sets;
+}
+
+ParameterSweep::ParameterSweep(SharedBarStore bars,
+                               std::shared_ptr<SymbolRegistry> registry,
+                               double initial_cash,
+                               SignalSourceFactory make_signal_source,
+                               std::size_t thread_count)
+    : m_bars(std::move(bars)),
+      m_registry(std::move(registry)),
+      m_initial_cash(initial_cash),
+      m_make_signal_source(std::move(make_signal_source)),
+      m_thread_count(thread_count)
+{
+    if (!m_bars || !m_registry || !m_make_signal_source) {
+        throw std::invalid_argument("ParameterSweep needs bars, a registry and a signal source factory");
+    }
+    // Runs must never intern concurrently: every bar has to arrive pre-tagged
+    for (const DataBar& bar : *m_bars) {
+        if (bar.symbol_id == kInvalidSymbolId || bar.symbol_id >= m_registry->size()) {
+            throw std::invalid_argument("ParameterSweep bar for " + bar.symbol + " has no valid symbol id");
+        }
+    }
+}
+
+std::vector<SweepResult> ParameterSweep::run(const std::vector<SweepParameters>& parameter_sets,
+                                             const std::function<void(const SweepResult&)>& on_result) {
+    std::vector<SweepResult> results(parameter_sets.size());
+    std::mutex result_mutex;
+
+    WorkStealingPool pool(m_thread_count);
+    for (std::size_t i = 0; i < parameter_sets.size(); ++i) {
+        pool.submit([&, i] {
+            SweepResult result = run_one(i, parameter_sets[i]);
+            results[i] = result; // Distinct slots: no lock needed
+            if (on_result) {
+                std::lock_guard<std::mutex> lock(result_mutex);
+                on_result(result);
+            }
+        });
+    }
+    pool.wait_idle();
+
+    return results;
+}
+
+SweepResult ParameterSweep::run_one(std::size_t run_index, const SweepParameters& parameters) const {
+    SweepEventLoop event_loop(
+        std::make_unique<InMemoryBarProvider>(m_bars),
+        m_make_signal_source(),
+        std::make_unique<PortfolioRiskManager>(
+            parameters.max_position_weight, parameters.max_leverage, parameters.max_drawdown,
+            VolatilityLimits{parameters.target_volatility}),
+        std::make_unique<BacktestExecutionHandler>(
+            parameters.commission_per_trade, parameters.slippage_percentage),
+        std::make_unique<Portfolio>(m_initial_cash, m_registry)
+    );
+
+    if (m_results_store) {
+        std::ostringstream label;
+        label << "sweep run " << run_index << ": max_position_weight=" << parameters.max_position_weight
+              << " max_leverage=" << parameters.max_leverage << " max_drawdown=" << parameters.max_drawdown
+              << " commission_per_trade=" << parameters.commission_per_trade
+              << " slippage_percentage=" << parameters.slippage_percentage
+              << " target_volatility=" << parameters.target_volatility;
+        event_loop.set_results_recorder(m_results_store->begin_run(label.str()));
+    }
+
+    event_loop.run_backtest();
+
+    const Portfolio& portfolio = event_loop.get_portfolio();
+    return SweepResult{
+        run_index,
+        parameters,
+        portfolio.get_total_value(),
+        event_loop.get_peak_portfolio_value(),
+        portfolio.get_cash(),
+        event_loop.get_performance()
+    };
+}
+
+void ParameterSweep::write_csv_header(std::ostream& out) {
+    out << "run,max_position_weight,max_leverage,max_drawdown,commission_per_trade,"
+           "slippage_percentage,target_volatility,final_value,peak_value,final_cash,"
+           "total_return,return_volatility,sharpe_ratio,sortino_ratio,max_drawdown,max_drawdown_periods,"
+           "average_gross_exposure,time_in_market,fills,turnover\n";
+}
+
+void ParameterSweep::write_csv_row(std::ostream& out, const SweepResult& result) {
+    const SweepParameters& p = result.parameters;
+    const PerformanceSummary& a = result.performance;
+    out << result.run_index << ','
+        << p.max_position_weight << ',' << p.max_leverage << ',' << p.max_drawdown << ','
+        << p.commission_per_trade << ',' << p.slippage_percentage << ',' << p.target_volatility << ','
+        << result.final_value << ',' << result.peak_value << ',' << result.final_cash << ','
+        << a.total_return << ',' << a.return_volatility << ',' << a.sharpe_ratio << ',' << a.sortino_ratio << ','
+        << a.max_drawdown << ',' << a.max_drawdown_periods << ',' << a.average_gross_exposure << ','
+        << a.time_in_market << ',' << a.fills << ',' << a.turnover << '\n';
+}
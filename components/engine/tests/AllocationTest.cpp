@@ -0,0 +1,173 @@
+// tests/AllocationTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "results/ResultsStore.h"
+#include "risk/PortfolioRiskManager.h"
+#include "signals/SignalAggregation.h"
+#include "signals/SignalMatrix.h"
+#include "signals/WireProtocol.h"
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+
+// --- Allocation counting ---
+// Replaces the global allocation functions of engine_tests, as engine_bench
+// does. Counts are per thread, so the logger's and the results store's
+// threads do not show up in the engine thread's count.
+namespace {
+    thread_local std::uint64_t t_allocations = 0;
+
+    void* counted_allocation(std::size_t size) {
+        ++t_allocations;
+        if (void* p = std::malloc(size == 0 ? 1 : size)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* counted_aligned_allocation(std::size_t size, std::align_val_t alignment) {
+        ++t_allocations;
+        const auto align = static_cast<std::size_t>(alignment);
+        if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return counted_allocation(size); }
+void* operator new[](std::size_t size) { return counted_allocation(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return counted_aligned_allocation(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return counted_aligned_allocation(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Serves the bars and notes the engine thread's allocation count once the
+    // loop is warm (`warmup` bars in) and again when the stream ends.
+    class AllocationProbe : public IDataProvider {
+    public:
+        AllocationProbe(SharedBarStore bars, std::size_t warmup) : m_inner(std::move(bars)), m_warmup(warmup) {}
+
+        std::optional<DataBar> get_next_bar() override {
+            if (m_served == m_warmup) {
+                m_at_warm = t_allocations;
+            }
+            auto bar = m_inner.get_next_bar();
+            if (bar) {
+                ++m_served;
+            } else {
+                m_at_end = t_allocations;
+            }
+            return bar;
+        }
+
+        // Allocations while the bars after the warm-up went through the loop.
+        std::uint64_t steady_state_allocations() const { return m_at_end - m_at_warm; }
+
+    private:
+        InMemoryBarProvider m_inner;
+        std::size_t m_warmup;
+        std::size_t m_served = 0;
+        std::uint64_t m_at_warm = 0;
+        std::uint64_t m_at_end = 0;
+    };
+
+    void expect_steady_state_allocation_free(const SharedBarStore& bars, const SyntheticData& data,
+                                             ResultsStore* results, const std::string& label) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        auto probe = std::make_unique<AllocationProbe>(bars, bars->size() / 10);
+        const AllocationProbe& counts = *probe;
+        EventLoop event_loop(
+            std::move(probe),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+        if (results) {
+            event_loop.set_results_recorder(results->begin_run(label));
+        }
+        event_loop.run_backtest();
+
+        expect(counts.steady_state_allocations() == 0,
+               "run_backtest (" + label + ") allocated " + std::to_string(counts.steady_state_allocations()) +
+                   " times after warm-up");
+    }
+}
+
+// Once warm, a bar through run_backtest() must not touch the heap, with or
+// without a results store recording the run.
+void test_backtest_bar_path_does_not_allocate() {
+    SyntheticSpec spec;
+    spec.symbols = 50;
+    spec.bars_per_symbol = 200;
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    expect_steady_state_allocation_free(bars, data, nullptr, "no results store");
+
+    const fs::path database = fs::temp_directory_path() / "engine_tests_alloc.db";
+    fs::remove(database);
+    {
+        ResultsStore results(database.string());
+        expect_steady_state_allocation_free(bars, data, &results, "results store");
+        results.flush();
+    }
+    fs::remove(database);
+}
+
+// Storing binary replies, decoding them into the signal matrix and aggregating
+// it reuses its buffers from the second bar on.
+void test_reply_decoding_does_not_allocate() {
+    SyntheticSpec spec;
+    spec.symbols = 50;
+    spec.bars_per_symbol = 1;
+    SyntheticData data(spec);
+    const SymbolRegistry& registry = *data.registry();
+
+    constexpr std::size_t kModels = 4;
+    std::vector<std::string> replies(kModels);
+    for (std::size_t model = 0; model < kModels; ++model) {
+        std::vector<SignalPacket> packets;
+        for (std::size_t i = model; i < data.symbols().size(); i += 2) {
+            packets.emplace_back(data.symbols()[i], SignalType::Long, 0.05 + 0.01 * model, 0.5);
+        }
+        wire::encode_signals(packets, replies[model], wire::kFlagCausal);
+    }
+
+    ModelReplies stored(kModels);
+    SignalMatrix matrix;
+    WeightVector weights;
+    WeightedMeanAggregator mean;
+    MedianAggregator median;
+    std::uint64_t at_warm = 0;
+    for (std::size_t bar = 0; bar < 100; ++bar) {
+        if (bar == 1) {
+            at_warm = t_allocations;
+        }
+        for (std::size_t model = 0; model < kModels; ++model) {
+            wire::store_reply(replies[model].data(), replies[model].size(), stored[model]);
+        }
+        matrix.load(stored, registry);
+        mean.aggregate(matrix, weights);
+        median.aggregate(matrix, weights);
+    }
+    const std::uint64_t allocations = t_allocations - at_warm;
+    expect(allocations == 0, "Reply decoding allocated " + std::to_string(allocations) + " times after the first bar");
+}
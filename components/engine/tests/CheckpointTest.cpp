@@ -0,0 +1,129 @@
+// tests/CheckpointTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "data/MergedBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "risk/PortfolioRiskManager.h"
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Ends the stream after `limit` bars, like a run killed part way through, and counts what it served.
+    class InterruptedBarProvider : public IDataProvider {
+    public:
+        InterruptedBarProvider(std::unique_ptr<IDataProvider> inner, std::size_t limit)
+            : m_inner(std::move(inner)), m_limit(limit) {}
+
+        std::optional<DataBar> get_next_bar() override {
+            if (m_served == m_limit) {
+                return std::nullopt;
+            }
+            auto bar = m_inner->get_next_bar();
+            m_served += bar ? 1 : 0;
+            return bar;
+        }
+
+        void resume_after(std::uint64_t timestamp_ns, std::uint64_t bars_at_timestamp) override {
+            m_inner->resume_after(timestamp_ns, bars_at_timestamp);
+        }
+
+        std::size_t served() const { return m_served; }
+
+    private:
+        std::unique_ptr<IDataProvider> m_inner;
+        std::size_t m_limit;
+        std::size_t m_served = 0;
+    };
+
+    using ProviderFactory = std::function<std::unique_ptr<IDataProvider>()>;
+
+    // Every stateful component: rotating targets, volatility rules on the covariance.
+    EventLoop make_event_loop(std::unique_ptr<IDataProvider> provider, const SyntheticData& data) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        return EventLoop(
+            std::move(provider),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+
+    struct RunOutcome {
+        double value;
+        double cash;
+        double peak;
+        std::map<std::string, long long> holdings;
+        std::string performance;
+
+        bool operator==(const RunOutcome&) const = default;
+    };
+
+    RunOutcome outcome(const EventLoop& event_loop) {
+        return {event_loop.get_portfolio().get_total_value(), event_loop.get_portfolio().get_cash(),
+                event_loop.get_peak_portfolio_value(), event_loop.get_portfolio().get_holdings(),
+                event_loop.get_performance().to_json().dump()};
+    }
+
+    // Runs uninterrupted, then killed after 60% of the bars and resumed from its last checkpoint.
+    void expect_exact_resume(const std::string& label, const ProviderFactory& make_provider, std::size_t bars,
+                             std::uint64_t checkpoint_every, const fs::path& checkpoint_path,
+                             const SyntheticData& data) {
+        EventLoop full = make_event_loop(make_provider(), data);
+        full.run_backtest();
+
+        fs::remove(checkpoint_path);
+        EventLoop interrupted = make_event_loop(std::make_unique<InterruptedBarProvider>(make_provider(), bars * 3 / 5),
+                                                data);
+        interrupted.enable_checkpoints(checkpoint_path.string(), checkpoint_every);
+        interrupted.run_backtest();
+
+        auto counted = std::make_unique<InterruptedBarProvider>(make_provider(), bars);
+        const InterruptedBarProvider& remaining = *counted;
+        EventLoop resumed = make_event_loop(std::move(counted), data);
+        resumed.restore_checkpoint(checkpoint_path.string());
+        resumed.run_backtest();
+
+        // Only the bars after the last checkpoint are replayed, and the run ends where the full one did
+        const std::size_t checkpointed = bars * 3 / 5 / checkpoint_every * checkpoint_every;
+        expect(remaining.served() == bars - checkpointed,
+               "The resumed run (" + label + ") replayed " + std::to_string(remaining.served()) +
+                   " bars, expected " + std::to_string(bars - checkpointed));
+        expect(outcome(resumed) == outcome(full), "The resumed run (" + label + ") differs from the uninterrupted run");
+    }
+}
+
+// A backtest killed part way and resumed from its last checkpoint must end
+// bit-identical to one that ran through, reading from memory or from files.
+void test_resumed_backtest_is_bit_identical() {
+    const fs::path directory = fs::temp_directory_path() / "engine_tests_checkpoint";
+    const fs::path checkpoint_path = fs::temp_directory_path() / "engine_tests.ckpt";
+
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 300;
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+    data.write_symbol_files(directory, *bars);
+
+    const ProviderFactory in_memory = [&] { return std::make_unique<InMemoryBarProvider>(bars); };
+    const ProviderFactory merged = [&] {
+        return std::make_unique<MergedBarProvider>(directory.string(), 4096, data.registry());
+    };
+
+    // A checkpoint interval prime to the universe, so the last one falls mid-timestamp
+    expect_exact_resume("in memory", in_memory, bars->size(), 997, checkpoint_path, data);
+    expect_exact_resume("merged files", merged, bars->size(), 997, checkpoint_path, data);
+
+    fs::remove(checkpoint_path);
+    fs::remove_all(directory);
+}
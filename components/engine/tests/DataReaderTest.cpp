@@ -0,0 +1,81 @@
+// tests/DataReaderTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "data/BinFileReader.h"
+#include "data/DataBarRecord.h"
+#include "data/MmapBarReader.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // The records of a `.bin` file written by SyntheticData, header skipped.
+    std::vector<DataBarRecord> read_records(const fs::path& path) {
+        MmapBarReader reader(path.string());
+        return {reader.records().begin(), reader.records().end()};
+    }
+
+    void expect_same_records(const std::vector<DataBarRecord>& expected, IDataProvider& reader, std::size_t first,
+                             const std::string& what) {
+        std::size_t i = first;
+        while (auto bar = reader.get_next_bar()) {
+            expect(i < expected.size(), what + " returned more bars than the file holds");
+            expect(bar->close == expected[i].close && record_timestamp(expected[i]) == bar->timestamp,
+                   what + " differs at record " + std::to_string(i));
+            ++i;
+        }
+        expect(i == expected.size(), what + " stopped after " + std::to_string(i) + " of " +
+                                         std::to_string(expected.size()) + " records");
+    }
+}
+
+// Record files written before BarFileHeader existed are plain 64-byte records;
+// both readers must still read them, including a seek into the middle.
+void test_headerless_bin_file_reads() {
+    const fs::path directory = fs::temp_directory_path() / "engine_tests_headerless";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    const fs::path with_header = directory / "NEW.bin";
+    SyntheticData::write_bar_file(with_header, "LEGACY", 500);
+    const std::vector<DataBarRecord> records = read_records(with_header);
+    expect(records.size() == 500, "The header was read as a record");
+
+    const fs::path headerless = directory / "LEGACY.bin";
+    {
+        std::ofstream out(headerless, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(DataBarRecord)));
+    }
+
+    MmapBarReader mapped(headerless.string());
+    expect_same_records(records, mapped, 0, "MmapBarReader");
+    BinFileReader streamed(headerless.string());
+    expect_same_records(records, streamed, 0, "BinFileReader");
+    TimeRange late;
+    late.start_ns = records[300].timestamp_epoch_ns;
+    BinFileReader seeking(headerless.string(), late);
+    expect_same_records(records, seeking, 300, "BinFileReader from a start time");
+
+    // The magic commits a file to the header: one this build cannot read is an error, not records
+    BarFileHeader future = make_bar_file_header();
+    future.version = kBarFileVersion + 1;
+    const fs::path unsupported = directory / "FUTURE.bin";
+    {
+        std::ofstream out(unsupported, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&future), sizeof(future));
+        out.write(reinterpret_cast<const char*>(records.data()), sizeof(DataBarRecord));
+    }
+    bool rejected = false;
+    try {
+        MmapBarReader reader(unsupported.string());
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    expect(rejected, "A file with an unsupported header version was read");
+
+    fs::remove_all(directory);
+}
@@ -0,0 +1,134 @@
+// tests/FakeModel.cpp
+
+#include "FakeModel.h"
+#include "signals/WireProtocol.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include <zmq.hpp>
+
+FakeModel::FakeModel(const std::string& endpoint, Answer answer)
+    : m_answer(std::move(answer)),
+      m_thread([this, endpoint] { serve(endpoint); })
+{
+    // Connecting DEALERs would reconnect anyway, but a test should not race the bind
+    while (!m_bound.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    if (!m_bind_error.empty()) {
+        m_thread.join();
+        throw std::runtime_error("FakeModel cannot bind " + endpoint + ": " + m_bind_error);
+    }
+}
+
+FakeModel::~FakeModel() {
+    m_stop.store(true, std::memory_order_relaxed);
+    m_thread.join();
+}
+
+void FakeModel::serve(const std::string& endpoint) {
+    struct Scheduled {
+        std::chrono::steady_clock::time_point due;
+        std::string identity;
+        std::string request_id;
+        std::string payload;
+    };
+
+    zmq::context_t context(1);
+    zmq::socket_t socket(context, zmq::socket_type::router);
+    socket.set(zmq::sockopt::linger, 0);
+    try {
+        socket.bind(endpoint);
+    } catch (const zmq::error_t& e) {
+        m_bind_error = e.what();
+        m_bound.store(true, std::memory_order_release);
+        return;
+    }
+    m_bound.store(true, std::memory_order_release);
+
+    std::vector<Scheduled> scheduled; // Kept sorted by due time; ties keep their order
+    std::vector<zmq::pollitem_t> items = {{socket, 0, ZMQ_POLLIN, 0}};
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        auto wait = std::chrono::milliseconds(5);
+        if (!scheduled.empty()) {
+            const auto until_due = std::chrono::ceil<std::chrono::milliseconds>(
+                scheduled.front().due - std::chrono::steady_clock::now());
+            wait = std::clamp(until_due, std::chrono::milliseconds(0), wait);
+        }
+        zmq::poll(items, wait);
+
+        // Requests: [identity, request_id, <empty>, payload]
+        zmq::message_t identity;
+        while (socket.recv(identity, zmq::recv_flags::dontwait)) {
+            zmq::message_t request_id;
+            zmq::message_t delimiter;
+            zmq::message_t payload;
+            (void)socket.recv(request_id, zmq::recv_flags::none);
+            (void)socket.recv(delimiter, zmq::recv_flags::none);
+            (void)socket.recv(payload, zmq::recv_flags::none);
+
+            const auto now = std::chrono::steady_clock::now();
+            const std::uint64_t sequence = m_requests.load(std::memory_order_relaxed);
+            for (Reply& reply : m_answer(sequence, payload.to_string())) {
+                Scheduled entry{now + reply.delay, identity.to_string(), request_id.to_string(), std::move(reply.payload)};
+                const auto position = std::upper_bound(scheduled.begin(), scheduled.end(), entry.due,
+                    [](auto due, const Scheduled& s) { return due < s.due; });
+                scheduled.insert(position, std::move(entry));
+            }
+            m_requests.store(sequence + 1, std::memory_order_release);
+        }
+
+        // Replies that are due: [identity, request_id, <empty>, payload]
+        const auto now = std::chrono::steady_clock::now();
+        std::size_t sent = 0;
+        for (; sent < scheduled.size() && scheduled[sent].due <= now; ++sent) {
+            const Scheduled& entry = scheduled[sent];
+            socket.send(zmq::buffer(entry.identity), zmq::send_flags::sndmore);
+            socket.send(zmq::buffer(entry.request_id), zmq::send_flags::sndmore);
+            socket.send(zmq::message_t(), zmq::send_flags::sndmore);
+            socket.send(zmq::buffer(entry.payload), zmq::send_flags::none);
+        }
+        scheduled.erase(scheduled.begin(), scheduled.begin() + static_cast<std::ptrdiff_t>(sent));
+    }
+}
+
+std::vector<DataBar> FakeModel::bars_of(const std::string& request) {
+    std::vector<DataBar> bars;
+    if (!wire::is_binary_message(request.data(), request.size())) {
+        const auto json = nlohmann::json::parse(request);
+        bars.emplace_back(json["symbol"].get<std::string>(), std::chrono::system_clock::time_point{},
+                          0.0, 0.0, 0.0, json["close"].get<double>(), 0);
+        return bars;
+    }
+
+    wire::MessageHeader header;
+    std::memcpy(&header, request.data(), sizeof(header));
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        wire::MarketDataRecord record;
+        std::memcpy(&record, request.data() + sizeof(header) + i * sizeof(record), sizeof(record));
+        bars.push_back(to_data_bar(record));
+    }
+    return bars;
+}
+
+std::string FakeModel::signals_for(const std::vector<DataBar>& bars, std::uint32_t flags) {
+    std::vector<SignalPacket> packets;
+    for (const DataBar& bar : bars) {
+        packets.emplace_back(bar.symbol, SignalType::Long, weight_for(bar), 1.0);
+    }
+    std::string reply;
+    wire::encode_signals(packets, reply, flags);
+
+    // encode_signals() answers one bar; number the records after their bars
+    for (std::uint32_t i = 0; i < bars.size(); ++i) {
+        char* record = reply.data() + sizeof(wire::MessageHeader) + i * sizeof(wire::SignalRecord);
+        std::memcpy(record + offsetof(wire::SignalRecord, bar_index), &i, sizeof(i));
+    }
+    return reply;
+}
+
+double FakeModel::weight_for(const DataBar& bar) {
+    return 0.01 * static_cast<double>(1 + static_cast<std::uint64_t>(bar.close * 100.0) % 7);
+}
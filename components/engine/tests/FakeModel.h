@@ -0,0 +1,69 @@
+// tests/FakeModel.h
+
+#pragma once
+
+#include "core/DataBar.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FakeModel
+ * @brief An in-process model for the IPC source tests: a ROUTER socket served
+ * on its own thread, speaking the same `[request_id, <empty>, payload]`
+ * envelope as the engine's DEALER sockets.
+ *
+ * Each request is handed to `answer` with its sequence number (0 for the
+ * first request received), and every reply it returns is sent after its
+ * delay. Replies can thus be reordered, held past the engine's deadline, or
+ * sent twice.
+ */
+class FakeModel {
+public:
+    struct Reply {
+        std::chrono::milliseconds delay{0};
+        std::string payload;
+    };
+    using Answer = std::function<std::vector<Reply>(std::uint64_t sequence, const std::string& request)>;
+
+    // Binds to `endpoint` and starts serving. Throws std::runtime_error if the bind fails.
+    FakeModel(const std::string& endpoint, Answer answer);
+    ~FakeModel();
+
+    // Requests received so far.
+    std::size_t requests() const { return m_requests.load(std::memory_order_acquire); }
+
+    /**
+     * @brief The bars of a request: the binary MarketData records, or the one
+     * bar of a JSON request (symbol and close only).
+     */
+    static std::vector<DataBar> bars_of(const std::string& request);
+
+    /**
+     * @brief A binary Signals reply: one Long signal per bar, on the bar's own
+     * symbol, whose weight is a function of its close (see weight_for()).
+     * Records carry their bar's index, so a reply to a batch answers every bar.
+     */
+    static std::string signals_for(const std::vector<DataBar>& bars, std::uint32_t flags);
+
+    static double weight_for(const DataBar& bar);
+
+    // --- Safety: Disallow copy/move (the thread refers to this object) ---
+    FakeModel(const FakeModel&) = delete;
+    FakeModel& operator=(const FakeModel&) = delete;
+
+private:
+    void serve(const std::string& endpoint);
+
+    Answer m_answer;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_bound{false};
+    std::string m_bind_error; // Written before m_bound is set
+    std::atomic<std::size_t> m_requests{0};
+    std::thread m_thread;
+};
@@ -0,0 +1,65 @@
+// tests/LiveTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/BarReplayPublisher.h"
+#include "data/InMemoryBarProvider.h"
+#include "data/ZmqBarSubscriber.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "risk/PortfolioRiskManager.h"
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+    constexpr const char* kFeedEndpoint = "tcp://127.0.0.1:5598";
+
+    EventLoop make_event_loop(std::unique_ptr<IDataProvider> provider, const SyntheticData& data) {
+        return EventLoop(
+            std::move(provider),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+}
+
+// Bars replayed over loopback TCP into run_live() must all arrive, and trade
+// exactly like run_backtest() over the same bars.
+void test_live_feed_matches_backtest() {
+    SyntheticSpec spec;
+    spec.symbols = 20;
+    spec.bars_per_symbol = 100;
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    EventLoop backtest = make_event_loop(std::make_unique<InMemoryBarProvider>(bars), data);
+    backtest.run_backtest();
+
+    LiveFeedOptions options;
+    options.idle_timeout = std::chrono::seconds(5); // Never hang on a lost end-of-feed message
+    auto subscriber = std::make_unique<ZmqBarSubscriber>(std::string(kFeedEndpoint), data.registry(), options);
+    const ZmqBarSubscriber& feed = *subscriber;
+    EventLoop live = make_event_loop(std::move(subscriber), data);
+
+    ReplayOptions replay;
+    replay.bars_per_second = 20000.0;
+    replay.warmup = std::chrono::milliseconds(300);
+    BarReplayPublisher publisher(std::string(kFeedEndpoint), replay);
+    std::uint64_t sent = 0;
+    std::thread publisher_thread([&] {
+        InMemoryBarProvider source(bars);
+        sent = publisher.publish(source);
+    });
+    live.run_live();
+    publisher_thread.join();
+
+    expect(sent == bars->size(), "The publisher sent " + std::to_string(sent) + " of " +
+                                     std::to_string(bars->size()) + " bars");
+    expect(feed.bars_received() == sent, "The live feed delivered " + std::to_string(feed.bars_received()) +
+                                             " of " + std::to_string(sent) + " bars");
+    expect_near(live.get_portfolio().get_total_value(), backtest.get_portfolio().get_total_value(), 1e-12,
+                "Live total value");
+    expect_near(live.get_portfolio().get_cash(), backtest.get_portfolio().get_cash(), 1e-12, "Live cash");
+}
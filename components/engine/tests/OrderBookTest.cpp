@@ -0,0 +1,83 @@
+// tests/OrderBookTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "checkpoint/Checkpoint.h"
+#include "core/Portfolio.h"
+#include "execution/OrderBookExecutionHandler.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const auto kStart = std::chrono::system_clock::time_point(std::chrono::seconds(1'700'000'000));
+
+    BookEventRecord add_order(std::chrono::milliseconds at, std::uint64_t order_id, std::uint8_t side,
+                              std::int64_t price_ticks, std::int64_t quantity) {
+        BookEventRecord event{};
+        event.timestamp_epoch_ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>((kStart + at).time_since_epoch()).count());
+        event.order_id = order_id;
+        event.price_ticks = price_ticks;
+        event.quantity = quantity;
+        event.type = BookEventType::Add;
+        event.side = side;
+        return event;
+    }
+
+    // Moves the handler's clock to `at` and buys 100 shares at a latest price
+    // of 100.00 from a fresh portfolio, so only the handler carries state.
+    // @return The average fill price.
+    double buy_100(OrderBookExecutionHandler& handler, const std::shared_ptr<SymbolRegistry>& registry,
+                   std::chrono::milliseconds at) {
+        const SymbolId id = registry->find("BOOK");
+        handler.on_market_bar(id, DataBar("BOOK", kStart + at, 100.0, 100.0, 100.0, 100.0, 0, id));
+        Portfolio portfolio(1'000'000.0, registry);
+        const WeightVector weights(1, 0.01);
+        const PriceVector prices(1, 100.0);
+        handler.execute_target_weights(portfolio, *registry, weights, prices);
+        expect(portfolio.get_position(id) == 100, "The buy was not filled in full");
+        return (1'000'000.0 - portfolio.get_cash()) / 100.0;
+    }
+}
+
+// Two back-to-back buys of the whole best ask must not both fill there: what
+// the first took stays gone, across a checkpoint, until the feed updates the level.
+void test_fills_deplete_book_levels() {
+    const fs::path directory = fs::temp_directory_path() / "engine_tests_books";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+    SyntheticData::write_book_file(directory / "BOOK.book", {
+        add_order(std::chrono::milliseconds(0), 1, 1, 10000, 100),
+        add_order(std::chrono::milliseconds(0), 2, 1, 10001, 200),
+        add_order(std::chrono::milliseconds(0), 3, 0, 9999, 100),
+        add_order(std::chrono::milliseconds(10), 4, 1, 10000, 50),
+    });
+
+    auto registry = std::make_shared<SymbolRegistry>();
+    registry->intern("BOOK");
+    const auto first_bar = std::chrono::milliseconds(1);
+
+    std::vector<std::uint8_t> snapshot;
+    {
+        OrderBookExecutionHandler handler(directory.string(), 0.01, 0.0, 0.05, 0.0);
+        expect_near(buy_100(handler, registry, first_bar), 100.00, 1e-12, "The first buy");
+        expect_near(buy_100(handler, registry, first_bar), 100.01, 1e-12, "The second buy, after the best ask was taken");
+        StateWriter out(snapshot);
+        handler.save_state(out);
+    }
+
+    OrderBookExecutionHandler resumed(directory.string(), 0.01, 0.0, 0.05, 0.0);
+    StateReader in(snapshot);
+    resumed.restore_state(in);
+    expect_near(buy_100(resumed, registry, first_bar), 100.01, 1e-12, "A buy after resuming from a checkpoint");
+    // A new order at the best ask updates the level: all of it is offered again
+    expect_near(buy_100(resumed, registry, std::chrono::milliseconds(10)), 100.00, 1e-12,
+                "A buy after the feed updated the best ask");
+    expect(resumed.unfilled_shares() == 0, "Shares were left unfilled");
+
+    fs::remove_all(directory);
+}
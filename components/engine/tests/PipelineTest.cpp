@@ -0,0 +1,60 @@
+// tests/PipelineTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "EventLoop.h"
+#include "data/InMemoryBarProvider.h"
+#include "execution/BacktestExecutionHandler.h"
+#include "risk/PortfolioRiskManager.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace {
+    EventLoop make_event_loop(const SharedBarStore& bars, const SyntheticData& data) {
+        VolatilityLimits limits;
+        limits.target_volatility = 0.15;
+        limits.max_value_at_risk = 0.03;
+        return EventLoop(
+            std::make_unique<InMemoryBarProvider>(bars),
+            std::make_unique<RotatingSignalSource>(),
+            std::make_unique<PortfolioRiskManager>(0.25, 1.0, 0.20, limits),
+            std::make_unique<BacktestExecutionHandler>(1.0, 0.0005),
+            std::make_unique<Portfolio>(100000.0, data.registry()));
+    }
+
+    struct RunOutcome {
+        double value;
+        double cash;
+        double peak;
+        std::map<std::string, long long> holdings;
+        std::string performance;
+
+        bool operator==(const RunOutcome&) const = default;
+    };
+
+    RunOutcome outcome(const EventLoop& event_loop) {
+        return {event_loop.get_portfolio().get_total_value(), event_loop.get_portfolio().get_cash(),
+                event_loop.get_peak_portfolio_value(), event_loop.get_portfolio().get_holdings(),
+                event_loop.get_performance().to_json().dump()};
+    }
+}
+
+// The three-stage pipeline must end bit-identical to the sequential loop, with
+// queues small enough for backpressure and large enough never to fill.
+void test_pipelined_backtest_matches_sequential() {
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 200;
+    SyntheticData data(spec);
+    const SharedBarStore bars = std::make_shared<const std::vector<DataBar>>(data.bars());
+
+    EventLoop sequential = make_event_loop(bars, data);
+    sequential.run_backtest();
+    for (const std::size_t capacity : {std::size_t{2}, std::size_t{1024}}) {
+        EventLoop pipelined = make_event_loop(bars, data);
+        pipelined.run_pipelined_backtest(capacity);
+        expect(outcome(pipelined) == outcome(sequential),
+               "The pipelined backtest (queue capacity " + std::to_string(capacity) + ") differs from the sequential one");
+    }
+}
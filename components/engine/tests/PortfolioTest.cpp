@@ -0,0 +1,87 @@
+// tests/PortfolioTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "core/Portfolio.h"
+#include <cmath>
+#include <random>
+
+// Random ticks and fills through a portfolio that never revalues on its own:
+// the incrementally kept value must match a full re-sum at the same prices.
+void test_incremental_valuation() {
+    SyntheticSpec spec;
+    spec.symbols = 500;
+    spec.bars_per_symbol = 1;
+    SyntheticData data(spec);
+
+    Portfolio portfolio(1e6, data.registry());
+    portfolio.set_revalue_interval(0);
+
+    PriceVector prices = data.prices();
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> price_step(0.0, 0.01);
+    std::uniform_int_distribution<long long> fill_size(-500, 500);
+
+    for (std::size_t i = 0; i < 200'000; ++i) {
+        const auto id = static_cast<SymbolId>(rng() % spec.symbols);
+        if (i % 4 == 0) {
+            const long long shares = fill_size(rng);
+            portfolio.update_holding(id, shares);
+            portfolio.update_cash(-static_cast<double>(shares) * prices[id]);
+        } else {
+            prices[id] *= 1.0 + price_step(rng);
+            portfolio.mark_price(id, prices[id]);
+        }
+    }
+
+    double gross_exposure = 0.0;
+    for (SymbolId id = 0; id < spec.symbols; ++id) {
+        gross_exposure += std::abs(static_cast<double>(portfolio.get_position(id))) * prices[id];
+    }
+
+    const double incremental_value = portfolio.get_total_value();
+    const double incremental_exposure = portfolio.get_gross_exposure();
+    portfolio.recalculate_total_value(prices);
+
+    expect_near(incremental_value, portfolio.get_total_value(), 1e-9, "Incremental vs full total value");
+    expect_near(incremental_exposure, gross_exposure, 1e-9, "Incremental vs full gross exposure");
+    expect_near(portfolio.get_gross_exposure(), gross_exposure, 1e-9, "Gross exposure after the full revalue");
+}
+
+// A hand-checked sequence: fills are valued at the last mark, marks move held positions only.
+void test_valuation_follows_marks_and_fills() {
+    auto registry = std::make_shared<SymbolRegistry>();
+    const SymbolId aaa = registry->intern("AAA");
+    const SymbolId bbb = registry->intern("BBB");
+    Portfolio portfolio(1000.0, registry);
+
+    portfolio.mark_price(aaa, 10.0);
+    portfolio.mark_price(bbb, 20.0);
+    expect_near(portfolio.get_total_value(), 1000.0, 0.0, "Marks without positions");
+
+    portfolio.update_holding(aaa, 10);      // Bought 10 AAA at 10
+    portfolio.update_cash(-100.0);
+    expect_near(portfolio.get_total_value(), 1000.0, 0.0, "After a fill at the mark");
+
+    portfolio.mark_price(aaa, 12.0);        // +20
+    portfolio.mark_price(bbb, 25.0);        // Not held
+    expect_near(portfolio.get_total_value(), 1020.0, 1e-15, "After marking AAA up");
+
+    portfolio.update_holding(bbb, -4);      // Sold 4 BBB short at 25
+    portfolio.update_cash(100.0);
+    portfolio.mark_price(bbb, 20.0);        // Short gains 20
+    expect_near(portfolio.get_total_value(), 1040.0, 1e-15, "After the short gains");
+    expect_near(portfolio.get_gross_exposure(), 10 * 12.0 + 4 * 20.0, 1e-15, "Gross exposure");
+
+    portfolio.update_holding(aaa, -10);     // Flat AAA at 12
+    portfolio.update_cash(120.0);
+    expect_near(portfolio.get_market_value(), -80.0, 1e-15, "Market value with only the short left");
+    expect(portfolio.held_ids().size() == 1 && portfolio.held_ids()[0] == bbb, "Only BBB is still held");
+
+    PriceVector prices(2);
+    prices[aaa] = 12.0;
+    prices[bbb] = 20.0;
+    const double incremental = portfolio.get_total_value();
+    portfolio.recalculate_total_value(prices);
+    expect_near(portfolio.get_total_value(), incremental, 1e-15, "Full revalue at the same marks");
+}
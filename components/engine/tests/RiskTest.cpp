@@ -0,0 +1,44 @@
+// tests/RiskTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "core/Portfolio.h"
+#include "risk/PortfolioRiskManager.h"
+#include <numeric>
+
+// With the volatility rules on, the map-based validate_target() must scale the
+// target exactly like validate_target_weights() does.
+void test_volatility_limits_on_both_paths() {
+    SyntheticSpec spec;
+    spec.symbols = 20;
+    spec.bars_per_symbol = 200;
+    SyntheticData data(spec);
+
+    VolatilityLimits limits;
+    limits.target_volatility = 0.05;
+    limits.max_value_at_risk = 0.01;
+    PortfolioRiskManager map_risk(1.0, 10.0, 0.5, limits);
+    PortfolioRiskManager dense_risk(1.0, 10.0, 0.5, limits);
+    for (const DataBar& bar : data.bars()) {
+        map_risk.on_market_bar(bar.symbol_id, bar);
+        dense_risk.on_market_bar(bar.symbol_id, bar);
+    }
+
+    Portfolio portfolio(1e6, data.registry());
+    const std::map<std::string, double> target_portfolio = data.target_portfolio();
+    WeightVector target_weights(spec.symbols, 0.0);
+    for (const auto& [symbol, weight] : target_portfolio) {
+        target_weights[data.registry()->find(symbol)] = weight;
+    }
+    const double proposed_total = std::accumulate(target_weights.begin(), target_weights.end(), 0.0);
+
+    const auto approved = map_risk.validate_target(portfolio, 1e6, target_portfolio);
+    dense_risk.validate_target_weights(portfolio, 1e6, *data.registry(), target_weights);
+
+    expect(approved.size() == target_portfolio.size(), "The map path dropped symbols");
+    for (const auto& [symbol, weight] : approved) {
+        expect_near(weight, target_weights[data.registry()->find(symbol)], 1e-15, "Weight of " + symbol);
+    }
+    const double approved_total = std::accumulate(target_weights.begin(), target_weights.end(), 0.0);
+    expect(approved_total < proposed_total, "The volatility rules did not scale the target down");
+}
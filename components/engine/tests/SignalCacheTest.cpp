@@ -0,0 +1,189 @@
+// tests/SignalCacheTest.cpp
+
+#include "TestHarness.h"
+#include "SyntheticData.h"
+#include "signals/CachedSignalSource.h"
+#include "signals/SignalReplyCache.h"
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Answers every bar with a weight on its own symbol, and reports every
+    // `incomplete_every`th result as missing a model.
+    class FlakySignalSource final : public ISignalSource {
+    public:
+        explicit FlakySignalSource(std::size_t incomplete_every) : m_incomplete_every(incomplete_every) {}
+
+        void update_market_data([[maybe_unused]] const nlohmann::json& market_data) override {}
+        void update_market_bar(const DataBar& bar) override { m_symbol = bar.symbol_id; }
+        std::map<std::string, double> get_target_portfolio() override { return {}; }
+
+        void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override {
+            ++m_requests;
+            target_weights.assign(registry.size(), 0.0);
+            target_weights[m_symbol] = 0.1;
+            m_complete = m_requests % m_incomplete_every != 0;
+        }
+        bool last_result_complete() const override { return m_complete; }
+        bool models_stateless() const override { return true; }
+
+        std::size_t requests() const { return m_requests; }
+
+    private:
+        std::size_t m_incomplete_every;
+        SymbolId m_symbol = 0;
+        std::size_t m_requests = 0;
+        bool m_complete = true;
+    };
+
+    // A model with history: each bar's symbol is weighted by how many bars of
+    // it came before, so skipping a bar changes every later answer.
+    class StatefulSignalSource final : public ISignalSource {
+    public:
+        void update_market_data([[maybe_unused]] const nlohmann::json& market_data) override {}
+        void update_market_bar(const DataBar& bar) override {
+            if (bar.symbol_id >= m_seen.size()) {
+                m_seen.resize(bar.symbol_id + 1, 0);
+            }
+            m_symbol = bar.symbol_id;
+            ++m_seen[m_symbol];
+        }
+        std::map<std::string, double> get_target_portfolio() override { return {}; }
+
+        void get_target_weights(const SymbolRegistry& registry, WeightVector& target_weights) override {
+            ++m_requests;
+            target_weights.assign(registry.size(), 0.0);
+            target_weights[m_symbol] = 0.01 * static_cast<double>(1 + m_seen[m_symbol] % 5);
+        }
+
+        std::size_t requests() const { return m_requests; }
+
+    private:
+        std::vector<std::size_t> m_seen; // Bars seen, per symbol
+        SymbolId m_symbol = 0;
+        std::size_t m_requests = 0;
+    };
+
+    // Sends `bars` through `source`, collecting each result.
+    std::vector<WeightVector> run_weights(ISignalSource& source, const std::vector<DataBar>& bars,
+                                          const SymbolRegistry& registry) {
+        std::vector<WeightVector> results;
+        for (const DataBar& bar : bars) {
+            source.update_market_bar(bar);
+            results.emplace_back();
+            source.get_target_weights(registry, results.back());
+        }
+        return results;
+    }
+
+    // Sends `bars` through a CachedSignalSource over `cache`.
+    // @return How many of them reached the wrapped source.
+    std::size_t run_bars(const std::vector<DataBar>& bars, const SymbolRegistry& registry,
+                         std::shared_ptr<SignalReplyCache> cache, std::size_t incomplete_every) {
+        auto inner = std::make_unique<FlakySignalSource>(incomplete_every);
+        const FlakySignalSource& counts = *inner;
+        CachedSignalSource source(std::move(inner), std::move(cache));
+        WeightVector weights;
+        for (const DataBar& bar : bars) {
+            source.update_market_bar(bar);
+            source.get_target_weights(registry, weights);
+        }
+        return counts.requests();
+    }
+}
+
+// A result with a model masked out is passed on but never recorded, so the
+// next run asks the models for exactly those bars again.
+void test_cache_skips_incomplete_results() {
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 30;
+    SyntheticData data(spec);
+    const std::vector<DataBar> bars = data.bars();
+
+    const fs::path path = fs::temp_directory_path() / "engine_tests_incomplete.cache";
+    fs::remove(path);
+    expect(run_bars(bars, *data.registry(), std::make_shared<SignalReplyCache>(path.string(), "models"), 3) ==
+               bars.size(), "The first run did not ask for every bar");
+
+    auto cache = std::make_shared<SignalReplyCache>(path.string(), "models");
+    const std::size_t incomplete = bars.size() / 3;
+    expect(cache->recorded_entries() == bars.size() - incomplete,
+           "Recorded " + std::to_string(cache->recorded_entries()) + " results, expected " +
+               std::to_string(bars.size() - incomplete));
+    const std::size_t asked = run_bars(bars, *data.registry(), cache, 1'000'000);
+    expect(asked == incomplete, "The second run asked for " + std::to_string(asked) + " bars, expected " +
+                                    std::to_string(incomplete));
+    cache.reset();
+    fs::remove(path);
+}
+
+// Opening a log under another model key must leave it untouched.
+void test_cache_keeps_other_models_log() {
+    const fs::path path = fs::temp_directory_path() / "engine_tests_other_models.cache";
+    fs::remove(path);
+    {
+        SignalReplyCache cache(path.string(), "models v1");
+        cache.insert(cache.key_of("request"), "reply");
+    }
+    const auto recorded_size = fs::file_size(path);
+    {
+        SignalReplyCache cache(path.string(), "models v2");
+        std::string value;
+        expect(!cache.find(cache.key_of("request"), value), "A reply recorded for other models was served");
+        cache.insert(cache.key_of("request"), "other reply");
+    }
+    expect(fs::file_size(path) == recorded_size, "Opening under another model key changed the log");
+    {
+        SignalReplyCache cache(path.string(), "models v1");
+        std::string value;
+        expect(cache.find(cache.key_of("request"), value) && value == "reply", "The original log was lost");
+    }
+    fs::remove(path);
+}
+
+// A model that has not declared itself stateless sees every bar, hits
+// included, so a half-warm cache ends exactly where an uncached run does.
+void test_cache_feeds_stateful_models() {
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 30;
+    SyntheticData data(spec);
+    const std::vector<DataBar> bars = data.bars();
+    const std::vector<DataBar> first_half(bars.begin(), bars.begin() + static_cast<std::ptrdiff_t>(bars.size() / 2));
+
+    StatefulSignalSource uncached;
+    const std::vector<WeightVector> expected = run_weights(uncached, bars, *data.registry());
+
+    const fs::path path = fs::temp_directory_path() / "engine_tests_stateful.cache";
+    fs::remove(path);
+    {
+        CachedSignalSource warm_up(std::make_unique<StatefulSignalSource>(),
+                                   std::make_shared<SignalReplyCache>(path.string(), "models"));
+        run_weights(warm_up, first_half, *data.registry());
+    }
+    auto cache = std::make_shared<SignalReplyCache>(path.string(), "models");
+    expect(cache->recorded_entries() == first_half.size(), "The first half was not recorded");
+
+    {
+        auto inner = std::make_unique<StatefulSignalSource>();
+        const StatefulSignalSource& model = *inner;
+        CachedSignalSource source(std::move(inner), cache);
+        const std::vector<WeightVector> actual = run_weights(source, bars, *data.registry());
+        expect(model.requests() == bars.size(), "The model was sent " + std::to_string(model.requests()) +
+                                                    " bars, expected every one of " + std::to_string(bars.size()));
+        for (std::size_t bar = 0; bar < bars.size(); ++bar) {
+            expect(actual[bar] == expected[bar], "Bar " + std::to_string(bar) + " differs from an uncached run");
+        }
+        expect(cache->hits() == first_half.size(), "The first half was not served from the cache");
+    }
+    cache.reset();
+    expect(SignalReplyCache(path.string(), "models").recorded_entries() == bars.size(),
+           "The second half was not recorded");
+    fs::remove(path);
+}
@@ -0,0 +1,178 @@
+// tests/SignalSourceTest.cpp
+
+#include "TestHarness.h"
+#include "FakeModel.h"
+#include "SyntheticData.h"
+#include "signals/AggregatedIPCSource.h"
+#include "signals/PipelinedIPCSource.h"
+#include "signals/WireProtocol.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kBatchSize = 8;
+
+    // A deterministic model: every bar of a request is answered at once.
+    FakeModel::Answer answer_every_bar(std::uint32_t flags) {
+        return [flags](std::uint64_t, const std::string& request) {
+            return std::vector<FakeModel::Reply>{{std::chrono::milliseconds(0),
+                                                  FakeModel::signals_for(FakeModel::bars_of(request), flags)}};
+        };
+    }
+
+    // Drives `source` the way the event loop does: the first bar on its own
+    // (the models still speak JSON), then blocks of pipeline_depth() bars, each
+    // submitted before its results are collected.
+    std::vector<WeightVector> run_source(ISignalSource& source, const std::vector<DataBar>& bars,
+                                         const SymbolRegistry& registry) {
+        std::vector<WeightVector> results;
+        std::size_t next = 0;
+        while (next < bars.size()) {
+            const std::size_t block = next == 0 ? 1 : std::min(source.pipeline_depth(), bars.size() - next);
+            for (std::size_t i = 0; i < block; ++i) {
+                source.update_market_bar(bars[next + i]);
+            }
+            for (std::size_t i = 0; i < block; ++i) {
+                results.emplace_back();
+                source.get_target_weights(registry, results.back());
+                expect(source.last_result_complete(), "Bar " + std::to_string(next + i) + " is missing a reply");
+            }
+            next += block;
+        }
+        return results;
+    }
+
+    void expect_same_results(const std::vector<WeightVector>& actual, const std::vector<WeightVector>& expected,
+                             const std::string& what) {
+        expect(actual.size() == expected.size(), what + ": wrong number of results");
+        for (std::size_t bar = 0; bar < expected.size(); ++bar) {
+            expect(actual[bar] == expected[bar], what + ": bar " + std::to_string(bar) + " differs");
+        }
+    }
+}
+
+// Causal models get one request per block of bars, and answer every bar
+// exactly as they would one request at a time.
+void test_batched_requests_match_per_bar() {
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 20;
+    SyntheticData data(spec);
+    std::vector<DataBar> bars = data.bars();
+    bars.erase(bars.begin() + 1 + kBatchSize * 20, bars.end());
+
+    FakeModel per_bar_model("tcp://127.0.0.1:5611", answer_every_bar(wire::kFlagCausal));
+    AggregatedIPCSource per_bar({"tcp://127.0.0.1:5611"}, std::chrono::milliseconds(1000), 1);
+    const auto expected = run_source(per_bar, bars, *data.registry());
+    expect(per_bar_model.requests() == bars.size(), "The per-bar source did not send one request per bar");
+    for (std::size_t bar = 0; bar < bars.size(); ++bar) {
+        expect(expected[bar][bars[bar].symbol_id] == FakeModel::weight_for(bars[bar]),
+               "Bar " + std::to_string(bar) + " does not carry the model's weight");
+    }
+
+    FakeModel batched_model("tcp://127.0.0.1:5612", answer_every_bar(wire::kFlagCausal));
+    AggregatedIPCSource batched({"tcp://127.0.0.1:5612"}, std::chrono::milliseconds(1000), kBatchSize);
+    expect_same_results(run_source(batched, bars, *data.registry()), expected, "Batched");
+
+    // The first request negotiates the binary format; every later one carries a whole block
+    const std::size_t expected_requests = 1 + (bars.size() - 1) / kBatchSize;
+    expect(batched_model.requests() == expected_requests,
+           "The batched source sent " + std::to_string(batched_model.requests()) + " requests, expected " +
+               std::to_string(expected_requests));
+}
+
+// One model that has not declared itself causal keeps every model on one
+// request per bar, with the same results.
+void test_batching_falls_back_for_non_causal_models() {
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 10;
+    SyntheticData data(spec);
+    std::vector<DataBar> bars = data.bars();
+    bars.erase(bars.begin() + 1 + kBatchSize * 5, bars.end());
+
+    FakeModel causal("tcp://127.0.0.1:5613", answer_every_bar(wire::kFlagCausal));
+    FakeModel non_causal("tcp://127.0.0.1:5614", answer_every_bar(0));
+    const std::vector<std::string> endpoints = {"tcp://127.0.0.1:5613", "tcp://127.0.0.1:5614"};
+
+    AggregatedIPCSource per_bar(endpoints, std::chrono::milliseconds(1000), 1);
+    const auto expected = run_source(per_bar, bars, *data.registry());
+    AggregatedIPCSource batched(endpoints, std::chrono::milliseconds(1000), kBatchSize);
+    expect_same_results(run_source(batched, bars, *data.registry()), expected, "Fallback");
+
+    expect(causal.requests() == 2 * bars.size() && non_causal.requests() == 2 * bars.size(),
+           "A model was sent a batch although one model is not causal");
+}
+
+// Replies that come back out of order are still returned in bar order; one
+// past the deadline masks its bar and is dropped when it arrives, and a
+// duplicate is dropped without answering anything.
+void test_pipelined_replies_out_of_order_late_and_twice() {
+    SyntheticSpec spec;
+    spec.symbols = 10;
+    spec.bars_per_symbol = 5;
+    SyntheticData data(spec);
+    std::vector<DataBar> bars = data.bars();
+    bars.erase(bars.begin() + 41, bars.end());
+    const SymbolRegistry& registry = *data.registry();
+
+    constexpr std::size_t kLateBar = 5;
+    constexpr std::size_t kDuplicatedBar = 9;
+    const std::size_t last_bar = bars.size() - 1;
+    const auto timeout = std::chrono::milliseconds(300);
+
+    // One request per bar, so a request's sequence number is its bar
+    FakeModel model("tcp://127.0.0.1:5615", [&](std::uint64_t sequence, const std::string& request) {
+        const std::string reply = FakeModel::signals_for(FakeModel::bars_of(request), 0);
+        // Within each block of four in flight, later bars are answered first
+        auto delay = std::chrono::milliseconds(5 * (3 - static_cast<long>(sequence % 4)));
+        if (sequence == kLateBar) {
+            delay = timeout + std::chrono::milliseconds(100);
+        } else if (sequence == last_bar) {
+            // Keeps the source polling until the late reply has arrived
+            delay = timeout - std::chrono::milliseconds(50);
+        }
+        std::vector<FakeModel::Reply> replies = {{delay, reply}};
+        if (sequence == kDuplicatedBar) {
+            replies.push_back({delay + std::chrono::milliseconds(5), reply});
+        }
+        return replies;
+    });
+
+    PipelinedIPCSource source({"tcp://127.0.0.1:5615"}, timeout, 4);
+    std::vector<WeightVector> results;
+    std::vector<bool> complete;
+    std::size_t next = 0;
+    while (next < bars.size()) {
+        const std::size_t block = next == 0 ? 1 : std::min(source.pipeline_depth(), bars.size() - next);
+        for (std::size_t i = 0; i < block; ++i) {
+            source.update_market_bar(bars[next + i]);
+        }
+        for (std::size_t i = 0; i < block; ++i) {
+            results.emplace_back();
+            source.get_target_weights(registry, results.back());
+            complete.push_back(source.last_result_complete());
+        }
+        next += block;
+    }
+
+    for (std::size_t bar = 0; bar < bars.size(); ++bar) {
+        const std::string name = "Bar " + std::to_string(bar);
+        if (bar == kLateBar) {
+            expect(!complete[bar], name + " timed out but was reported complete");
+            expect(std::all_of(results[bar].begin(), results[bar].end(), [](double w) { return w == 0.0; }),
+                   name + " timed out but carries weights");
+            continue;
+        }
+        expect(complete[bar], name + " is missing its reply");
+        WeightVector expected(registry.size(), 0.0);
+        expected[bars[bar].symbol_id] = FakeModel::weight_for(bars[bar]);
+        expect(results[bar] == expected, name + " does not carry its own reply");
+    }
+    expect(source.timed_out_replies() == 1,
+           "Timed out " + std::to_string(source.timed_out_replies()) + " replies, expected 1");
+    expect(source.late_replies() == 2,
+           "Dropped " + std::to_string(source.late_replies()) + " late or duplicate replies, expected 2");
+}
@@ -0,0 +1,29 @@
+// tests/TestHarness.h
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Fails the running test with `message` unless `condition` holds.
+ * Tests are plain functions; the first failed expectation ends the test.
+ */
+inline void expect(bool condition, const std::string& message) {
+    if (!condition) {
+        throw std::runtime_error(message);
+    }
+}
+
+/**
+ * @brief Fails the running test unless `actual` is within `relative_tolerance`
+ * of `expected` (relative to the larger of 1 and |expected|).
+ */
+inline void expect_near(double actual, double expected, double relative_tolerance, const std::string& what) {
+    const double error = std::abs(actual - expected) / std::max(1.0, std::abs(expected));
+    expect(error <= relative_tolerance,
+           what + ": expected " + std::to_string(expected) + ", got " + std::to_string(actual) +
+               " (relative error " + std::to_string(error) + ")");
+}
@@ -0,0 +1,77 @@
+// tests/TestMain.cpp
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+// Tests are defined in their own translation units.
+void test_incremental_valuation();
+void test_valuation_follows_marks_and_fills();
+void test_volatility_limits_on_both_paths();
+void test_live_feed_matches_backtest();
+void test_backtest_bar_path_does_not_allocate();
+void test_reply_decoding_does_not_allocate();
+void test_cache_skips_incomplete_results();
+void test_cache_keeps_other_models_log();
+void test_cache_feeds_stateful_models();
+void test_headerless_bin_file_reads();
+void test_batched_requests_match_per_bar();
+void test_batching_falls_back_for_non_causal_models();
+void test_pipelined_replies_out_of_order_late_and_twice();
+void test_fills_deplete_book_levels();
+void test_pipelined_backtest_matches_sequential();
+void test_resumed_backtest_is_bit_identical();
+
+namespace {
+    struct TestCase {
+        const char* name;
+        void (*run)();
+    };
+
+    // CTest runs each entry on its own (see CMakeLists.txt), so keep the two lists in step.
+    const TestCase kTests[] = {
+        {"portfolio_incremental_valuation", test_incremental_valuation},
+        {"portfolio_marks_and_fills", test_valuation_follows_marks_and_fills},
+        {"risk_volatility_limits_both_paths", test_volatility_limits_on_both_paths},
+        {"live_feed_matches_backtest", test_live_feed_matches_backtest},
+        {"allocation_backtest_bar_path", test_backtest_bar_path_does_not_allocate},
+        {"allocation_reply_decoding", test_reply_decoding_does_not_allocate},
+        {"signal_cache_skips_incomplete_results", test_cache_skips_incomplete_results},
+        {"signal_cache_keeps_other_models_log", test_cache_keeps_other_models_log},
+        {"signal_cache_feeds_stateful_models", test_cache_feeds_stateful_models},
+        {"data_headerless_bin_file", test_headerless_bin_file_reads},
+        {"ipc_batched_matches_per_bar", test_batched_requests_match_per_bar},
+        {"ipc_batching_non_causal_fallback", test_batching_falls_back_for_non_causal_models},
+        {"ipc_pipelined_reply_order", test_pipelined_replies_out_of_order_late_and_twice},
+        {"order_book_fills_deplete_levels", test_fills_deplete_book_levels},
+        {"pipelined_backtest_matches_sequential", test_pipelined_backtest_matches_sequential},
+        {"checkpoint_resume_bit_identical", test_resumed_backtest_is_bit_identical},
+    };
+}
+
+// Usage: engine_tests [test]. Runs every test, or only the named one.
+int main(int argc, char** argv) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+
+    int failures = 0;
+    bool matched = false;
+    for (const auto& test : kTests) {
+        if (!filter.empty() && filter != test.name) {
+            continue;
+        }
+        matched = true;
+        try {
+            test.run();
+            std::cout << "[PASS] " << test.name << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "[FAIL] " << test.name << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+
+    if (!matched) {
+        std::cerr << "No test named " << filter << std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
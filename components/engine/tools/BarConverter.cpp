@@ -0,0 +1,112 @@
+// tools/BarConverter.cpp
+
+#include "data/BincodeBarReader.h"
+#include "data/ColumnarBarWriter.h"
+#include "data/MmapBarReader.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct ConvertOptions {
+        std::string from = "bincode";   // "bincode" (rust_data_fetcher) or "bin" (64-byte records)
+        std::string symbol;             // Defaults to the input file's stem
+        std::size_t bars_per_block = ColumnarBarWriter::kDefaultBarsPerBlock;
+    };
+
+    void stream_bars(const fs::path& input, const std::string& symbol, const std::string& from,
+                     ColumnarBarWriter& writer) {
+        if (from == "bincode") {
+            BincodeBarReader reader(input.string(), symbol);
+            while (const DataBarRecord* record = reader.next_record()) {
+                writer.append(*record);
+            }
+        } else if (from == "bin") {
+            MmapBarReader reader(input.string());
+            for (auto batch = reader.next_batch(4096); !batch.empty(); batch = reader.next_batch(4096)) {
+                for (const DataBarRecord& record : batch) {
+                    writer.append(record);
+                }
+            }
+        } else {
+            throw std::invalid_argument("Unknown input format '" + from + "' (expected bincode or bin)");
+        }
+        writer.finish();
+    }
+
+    // Streams one file into a .cbar file; returns the number of bars.
+    std::uint64_t convert_file(const fs::path& input, const fs::path& output, const ConvertOptions& options) {
+        const std::string symbol = options.symbol.empty() ? input.stem().string() : options.symbol;
+        ColumnarBarWriter writer(output.string(), symbol, options.bars_per_block);
+        try {
+            stream_bars(input, symbol, options.from, writer);
+        } catch (...) {
+            fs::remove(output); // Never leave a partial file behind
+            throw;
+        }
+
+        const auto in_size = fs::file_size(input);
+        const auto out_size = fs::file_size(output);
+        std::cout << input.string() << " -> " << output.string() << ": " << writer.bar_count() << " bars, "
+                  << in_size << " -> " << out_size << " bytes";
+        if (out_size > 0) {
+            std::cout << " (" << static_cast<double>(in_size) / static_cast<double>(out_size) << "x)";
+        }
+        std::cout << std::endl;
+        return writer.bar_count();
+    }
+}
+
+// Usage: bar_converter [--from bincode|bin] [--symbol SYM] [--block N] <input> <output>
+//   <input> a file  -> <output> is the .cbar file to write
+//   <input> a dir   -> every *.bin in it is written to <output>/<stem>.cbar
+int main(int argc, char* argv[]) {
+    ConvertOptions options;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            options.from = argv[++i];
+        } else if (std::strcmp(argv[i], "--symbol") == 0 && i + 1 < argc) {
+            options.symbol = argv[++i];
+        } else if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            options.bars_per_block = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            paths.emplace_back(argv[i]);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cerr << "Usage: bar_converter [--from bincode|bin] [--symbol SYM] [--block N] <input> <output>" << std::endl;
+        return 2;
+    }
+
+    try {
+        const fs::path input = paths[0];
+        const fs::path output = paths[1];
+        if (!fs::is_directory(input)) {
+            convert_file(input, output, options);
+            return 0;
+        }
+
+        if (!options.symbol.empty()) {
+            throw std::invalid_argument("--symbol only applies to a single file");
+        }
+        fs::create_directories(output);
+        std::uint64_t total_bars = 0;
+        for (const auto& entry : fs::directory_iterator(input)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+                total_bars += convert_file(entry.path(), output / (entry.path().stem().string() + ".cbar"), options);
+            }
+        }
+        std::cout << "Converted " << total_bars << " bars." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "bar_converter: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
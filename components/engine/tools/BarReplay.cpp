@@ -0,0 +1,44 @@
+// tools/BarReplay.cpp
+
+#include "data/BarReplayPublisher.h"
+#include "data/MergedBarProvider.h"
+#include "logging/Logger.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Usage: bar_replay [--rate BARS_PER_SECOND] [--warmup MS] <endpoint> <data_directory>
+//   Serves every .bin/.cbar file in <data_directory>, merged in time order, as the
+//   live feed `engine --live` subscribes to (eg bar_replay tcp://*:5560 ../../data).
+//   --rate 0 (the default) sends as fast as possible.
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            options.bars_per_second = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            options.warmup = std::chrono::milliseconds(std::strtoll(argv[++i], nullptr, 10));
+        } else {
+            paths.emplace_back(argv[i]);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cerr << "Usage: bar_replay [--rate BARS_PER_SECOND] [--warmup MS] <endpoint> <data_directory>" << std::endl;
+        return 2;
+    }
+
+    try {
+        MergedBarProvider bars(paths[1]);
+        BarReplayPublisher publisher(paths[0], options);
+        publisher.publish(bars);
+    } catch (const std::exception& e) {
+        std::cerr << "bar_replay: " << e.what() << std::endl;
+        return 1;
+    }
+    logging::Logger::instance().flush();
+    return 0;
+}
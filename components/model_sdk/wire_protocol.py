@@ -0,0 +1,157 @@
+"""Python-side reader/writer for the engine's binary model protocol.
+
+Mirrors components/engine/include/signals/WireProtocol.h; keep the two in sync.
+
+A model that wants the binary protocol only has to answer the engine's first
+(JSON) request in binary. From then on the engine sends it binary requests.
+Models that never reply in binary keep receiving JSON, exactly as before.
+
+A model whose output for a bar depends only on that bar and earlier ones, and
+that keeps no state between bars, can reply with causal=True. An engine running
+in batched mode will then send it several bars per request, and expects one
+list of signals per bar back; an engine with a signal cache stops sending it
+bars whose replies it has recorded. A model with history must not set it.
+
+    import zmq
+    from wire_protocol import Signal, decode_request, encode_reply
+
+    socket = zmq.Context().socket(zmq.REP)
+    socket.bind("tcp://*:5555")
+    while True:
+        request = decode_request(socket.recv())
+        per_bar = [[Signal(bar["symbol"], "LONG", 0.2, 0.9)] for bar in request.bars]
+        socket.send(encode_reply(request, per_bar, causal=True))
+"""
+
+import json
+import struct
+from dataclasses import dataclass, field
+from typing import List, NamedTuple
+
+MAGIC = 0x50574554  # "TEWP" on the wire
+VERSION = 1
+
+MSG_MARKET_DATA = 1
+MSG_SIGNALS = 2
+
+FLAG_CAUSAL = 1 << 0  # Reply only: the model accepts batched requests and replays
+
+# Little-endian, no padding: must match the static_asserts in WireProtocol.h
+HEADER = struct.Struct("<IHHII")              # magic, version, type, count, flags
+MARKET_DATA_RECORD = struct.Struct("<16sQddddQ")  # symbol, ts_ns, o, h, l, c, volume
+SIGNAL_RECORD = struct.Struct("<16sddB3xI")   # symbol, target_weight, confidence, signal_type, bar_index
+
+SIGNAL_TYPES = ("LONG", "SHORT", "FLAT")
+
+assert HEADER.size == 16
+assert MARKET_DATA_RECORD.size == 64
+assert SIGNAL_RECORD.size == 40
+
+
+class Signal(NamedTuple):
+    symbol: str
+    signal_type: str  # "LONG", "SHORT" or "FLAT"
+    target_weight: float
+    confidence: float
+    bar_index: int = 0  # Which bar of a batched request this answers
+
+
+@dataclass
+class Request:
+    binary: bool                     # Whether the request arrived in binary
+    binary_supported: bool           # Whether the engine accepts a binary reply
+    bars: List[dict] = field(default_factory=list)
+
+
+def is_binary(payload: bytes) -> bool:
+    return len(payload) >= HEADER.size and HEADER.unpack_from(payload)[0] == MAGIC
+
+
+def _decode_symbol(raw: bytes) -> str:
+    return raw.split(b"\0", 1)[0].decode("ascii")
+
+
+def _encode_symbol(symbol: str) -> bytes:
+    encoded = symbol.encode("ascii")
+    if len(encoded) > 16:
+        raise ValueError(f"symbol too long for the wire format: {symbol!r}")
+    return encoded
+
+
+def decode_request(payload: bytes) -> Request:
+    """Decodes an engine request, binary or JSON, into a list of bar dicts."""
+    if not is_binary(payload):
+        message = json.loads(payload)
+        return Request(binary=False,
+                       binary_supported=message.get("wire_version", 0) >= VERSION,
+                       bars=[message])
+
+    magic, version, msg_type, count, _flags = HEADER.unpack_from(payload)
+    if version != VERSION or msg_type != MSG_MARKET_DATA:
+        raise ValueError(f"unsupported message: version={version} type={msg_type}")
+
+    bars = []
+    for i in range(count):
+        symbol, ts_ns, o, h, l, c, volume = MARKET_DATA_RECORD.unpack_from(
+            payload, HEADER.size + i * MARKET_DATA_RECORD.size)
+        bars.append({"symbol": _decode_symbol(symbol), "timestamp_ns": ts_ns,
+                     "open": o, "high": h, "low": l, "close": c, "volume": volume})
+    return Request(binary=True, binary_supported=True, bars=bars)
+
+
+def encode_signals(signals: List[Signal], causal: bool = False) -> bytes:
+    """Encodes a binary Signals reply carrying any number of signals."""
+    flags = FLAG_CAUSAL if causal else 0
+    parts = [HEADER.pack(MAGIC, VERSION, MSG_SIGNALS, len(signals), flags)]
+    for signal in signals:
+        parts.append(SIGNAL_RECORD.pack(_encode_symbol(signal.symbol),
+                                        float(signal.target_weight),
+                                        float(signal.confidence),
+                                        SIGNAL_TYPES.index(signal.signal_type),
+                                        signal.bar_index))
+    return b"".join(parts)
+
+
+def encode_reply(request: Request, per_bar_signals: List[List[Signal]], causal: bool = False) -> bytes:
+    """Answers a request with one list of signals per bar in request.bars.
+
+    Replies in binary when the engine supports it, else with the legacy JSON packet.
+    """
+    if len(per_bar_signals) != len(request.bars):
+        raise ValueError("expected one list of signals per requested bar")
+    if request.binary_supported:
+        return encode_signals([signal._replace(bar_index=index)
+                               for index, signals in enumerate(per_bar_signals)
+                               for signal in signals], causal)
+    if len(per_bar_signals[0]) != 1:
+        raise ValueError("the JSON protocol carries exactly one signal per reply")
+    packet = per_bar_signals[0][0]._asdict()
+    del packet["bar_index"]
+    return json.dumps(packet).encode()
+
+
+def is_causal(payload: bytes) -> bool:
+    return is_binary(payload) and bool(HEADER.unpack_from(payload)[4] & FLAG_CAUSAL)
+
+
+def decode_signals(payload: bytes) -> List[Signal]:
+    """Decodes a binary Signals reply (the inverse of encode_signals)."""
+    magic, version, msg_type, count, _flags = HEADER.unpack_from(payload)
+    if magic != MAGIC or version != VERSION or msg_type != MSG_SIGNALS:
+        raise ValueError("not a version 1 Signals message")
+    signals = []
+    for i in range(count):
+        symbol, weight, confidence, signal_type, bar_index = SIGNAL_RECORD.unpack_from(
+            payload, HEADER.size + i * SIGNAL_RECORD.size)
+        signals.append(Signal(_decode_symbol(symbol), SIGNAL_TYPES[signal_type], weight, confidence, bar_index))
+    return signals
+
+
+def encode_market_data(bars: List[dict]) -> bytes:
+    """Encodes a MarketData request (the engine side; useful for model tests)."""
+    parts = [HEADER.pack(MAGIC, VERSION, MSG_MARKET_DATA, len(bars), 0)]
+    for bar in bars:
+        parts.append(MARKET_DATA_RECORD.pack(_encode_symbol(bar["symbol"]), bar.get("timestamp_ns", 0),
+                                             bar.get("open", 0.0), bar.get("high", 0.0),
+                                             bar.get("low", 0.0), bar["close"], bar.get("volume", 0)))
+    return b"".join(parts)